@@ -9,7 +9,11 @@
  * 
  */
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
 
 /// 临时性的异常类，用于表示树为空的异常
 class UnderflowException { };
@@ -27,7 +31,107 @@ class IteratorUninitializedException { };
 template <typename Comparable>
 class BinarySearchTree
 {
+    struct BinaryNode;
+
 public:
+    /**
+     * @brief 中序的双向只读迭代器
+     * 
+     * 每个节点多存一个父指针，迭代器只记一个节点指针，不需要栈：
+     * 后继是右子树的最小节点；没有右子树时，沿父指针向上，
+     * 直到从某个节点的左子树上来，那个节点就是后继。前驱对称。
+     * end() 的节点指针为空；对树的任何修改都会使迭代器失效。
+     */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = Comparable;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const Comparable *;
+        using reference         = const Comparable &;
+
+        const_iterator() : tree{ nullptr }, current{ nullptr } {}
+
+        const Comparable &operator*() const {
+            return current->element;
+        }
+
+        const Comparable *operator->() const {
+            return &current->element;
+        }
+
+        /**
+         * @brief 前进到中序后继；已在 end() 时抛出 IteratorOutOfBoundsException
+         */
+        const_iterator &operator++() {
+            if (current == nullptr) {
+                throw IteratorOutOfBoundsException{ };
+            }
+            if (current->right != nullptr) {
+                current = tree->findMin(current->right);
+            } else {
+                BinaryNode *child;
+                do {
+                    child = current;
+                    current = current->parent;
+                } while (current != nullptr && child == current->right);
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        /**
+         * @brief 后退到中序前驱；end() 退到最大元素，已在 begin() 时抛出异常
+         */
+        const_iterator &operator--() {
+            BinaryNode *p = current;
+            if (p == nullptr) {
+                p = tree->findMax(tree->root);
+            } else if (p->left != nullptr) {
+                p = tree->findMax(p->left);
+            } else {
+                BinaryNode *child;
+                do {
+                    child = p;
+                    p = p->parent;
+                } while (p != nullptr && child == p->left);
+            }
+            if (p == nullptr) {
+                throw IteratorOutOfBoundsException{ };
+            }
+            current = p;
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator &rhs) const {
+            return current == rhs.current;
+        }
+
+        bool operator!=(const const_iterator &rhs) const {
+            return !(*this == rhs);
+        }
+
+    private:
+        const BinarySearchTree *tree;  ///< 所属的树，end() 后退时要用
+        BinaryNode *current;           ///< 当前节点，end() 时为空
+
+        const_iterator(const BinarySearchTree *t, BinaryNode *p) : tree{ t }, current{ p } {}
+
+        friend class BinarySearchTree;
+    };
+
     /**
      * @brief 默认构造函数
      * 
@@ -69,7 +173,7 @@ public:
     /**
      * @brief 查找并返回树中的最小元素
      * 
-     * 这是一个公有接口，它调用了私有的递归函数。
+     * 这是一个公有接口，它调用了私有的同名函数。
      * 
      * @return 最小元素的引用
      */
@@ -160,6 +264,68 @@ public:
         remove(x, root);
     }
 
+    /**
+     * @brief 指向最小元素的迭代器
+     */
+    const_iterator begin() const {
+        return const_iterator{ this, findMin(root) };
+    }
+
+    /**
+     * @brief 最大元素之后的迭代器
+     */
+    const_iterator end() const {
+        return const_iterator{ this, nullptr };
+    }
+
+    /**
+     * @brief 第一个不小于 x 的元素
+     * 
+     * 从根向下走一趟，O(h)：元素不小于 x 时记下它并转向左子树，否则转向右子树
+     */
+    const_iterator lower_bound(const Comparable &x) const {
+        BinaryNode *bound = nullptr;
+        for (BinaryNode *t = root; t != nullptr; ) {
+            if (t->element < x) {
+                t = t->right;
+            } else {
+                bound = t;
+                t = t->left;
+            }
+        }
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * @brief 第一个大于 x 的元素
+     */
+    const_iterator upper_bound(const Comparable &x) const {
+        BinaryNode *bound = nullptr;
+        for (BinaryNode *t = root; t != nullptr; ) {
+            if (x < t->element) {
+                bound = t;
+                t = t->left;
+            } else {
+                t = t->right;
+            }
+        }
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * @brief 等于 x 的元素的范围，即 [lower_bound(x), upper_bound(x))，与 STL 一致
+     */
+    std::pair<const_iterator, const_iterator> equal_range(const Comparable &x) const {
+        return { lower_bound(x), upper_bound(x) };
+    }
+
+    /**
+     * @brief 闭区间 [lo, hi] 中的元素的范围
+     */
+    std::pair<const_iterator, const_iterator> range(const Comparable &lo, const Comparable &hi) const {
+        return { lower_bound(lo), upper_bound(hi) };
+    }
+
     /**
      * @brief 拷贝赋值运算符
      * 
@@ -199,6 +365,7 @@ private:
         Comparable element;  ///< 节点存储的元素
         BinaryNode *left;    ///< 左子节点指针
         BinaryNode *right;   ///< 右子节点指针
+        BinaryNode *parent;  ///< 父节点指针，根的为空；供迭代器向上走
 
         /**
          * @brief 构造函数，接受常量引用
@@ -206,9 +373,10 @@ private:
          * @param theElement 要存储的元素
          * @param lt 左子节点指针
          * @param rt 右子节点指针
+         * @param pt 父节点指针
          */
-        BinaryNode(const Comparable &theElement, BinaryNode *lt, BinaryNode *rt)
-            : element{ theElement }, left{ lt }, right{ rt } {}
+        BinaryNode(const Comparable &theElement, BinaryNode *lt, BinaryNode *rt, BinaryNode *pt = nullptr)
+            : element{ theElement }, left{ lt }, right{ rt }, parent{ pt } {}
 
         /**
          * @brief 构造函数，接受右值引用
@@ -216,41 +384,39 @@ private:
          * @param theElement 要存储的元素
          * @param lt 左子节点指针
          * @param rt 右子节点指针
+         * @param pt 父节点指针
          */
-        BinaryNode(Comparable &&theElement, BinaryNode *lt, BinaryNode *rt)
-            : element{ std::move(theElement) }, left{ lt }, right{ rt } {}
+        BinaryNode(Comparable &&theElement, BinaryNode *lt, BinaryNode *rt, BinaryNode *pt = nullptr)
+            : element{ std::move(theElement) }, left{ lt }, right{ rt }, parent{ pt } {}
     };
 
     BinaryNode *root;  ///< 树的根节点指针
 
     /**
-     * @brief 递归查找最小元素
+     * @brief 查找最小元素
      * 
      * @param t 当前节点指针
      * @return 最小元素所在的节点指针
      */
     BinaryNode *findMin(BinaryNode *t) const {
-        /// 从一个空节点开始查找，返回空指针                
-        if (t == nullptr) {
-            return nullptr;
-        }
-        /// 向左无路了，当前节点就是最小元素
-        if (t->left == nullptr) {
-            return t;
+        /// 原来的递归版本是尾递归，直接改成循环：一路向左，向左无路时就是最小元素
+        /// 从一个空节点开始查找，返回空指针
+        if (t != nullptr) {
+            while (t->left != nullptr) {
+                t = t->left;
+            }
         }
-        /// 否则继续向左查找
-        return findMin(t->left);
+        return t;
     }
 
     /**
-     * @brief 递归查找最大元素
+     * @brief 查找最大元素
      * 
      * @param t 当前节点指针
      * @return 最大元素所在的节点指针
      */
     BinaryNode *findMax(BinaryNode *t) const {
         /// 这里没有使用递归，而是使用循环，更高效
-        /// findMin 也可以改成循环实现
         if (t != nullptr) {
             while (t->right != nullptr) {
                 t = t->right;
@@ -260,147 +426,203 @@ private:
     }
 
     /**
-     * @brief 递归检查树中是否包含指定的元素
+     * @brief 检查树中是否包含指定的元素
      * 
      * @param x 要查找的元素
      * @param t 当前节点指针
      * @return 如果树中包含该元素，则返回 true；否则返回 false
      */
     bool contains(const Comparable &x, BinaryNode *t) const {
-        /// 这是递归版本，也可以有循环版本
-        if (t == nullptr) {
-            return false;
-        }
-        if (x < t->element) {
-            return contains(x, t->left);
-        } 
-        else if (x > t->element) {
-            return contains(x, t->right);
-        } 
-        else {
-            return true;  // 找到元素
+        /// 循环版本。递归版本每层都有一次函数调用的开销，
+        /// 而且在退化成链的树上，递归深度等于节点数，会耗尽栈空间
+        while (t != nullptr) {
+            if (x < t->element) {
+                t = t->left;
+            } 
+            else if (x > t->element) {
+                t = t->right;
+            } 
+            else {
+                return true;  // 找到元素
+            }
         }
+        return false;
     }
 
     /**
-     * @brief 递归打印树的结构
+     * @brief 按中序打印树中的元素（Morris 遍历）
      * 
      * @param t 当前节点指针
      * @param out 输出流
      */
     void printTree(BinaryNode *t, std::ostream &out) const {
-        /// 中序遍历
-        if (t != nullptr) {
-            printTree(t->left, out);  // 先打印左子树
-            out << t->element << std::endl;  // 打印当前节点
-            printTree(t->right, out);  // 再打印右子树
+        /// Morris 中序遍历：不用递归，也不用栈，额外空间 O(1)
+        /// 对有左子树的节点 t，先找到它的中序前驱（左子树的最右节点），
+        /// 让前驱的右指针临时指回 t，这样打印完左子树后可以沿着它回到 t
+        /// 第二次回到 t 时，说明左子树已打印完：恢复前驱的右指针，打印 t，转向右子树
+        /// 遍历结束时所有指针都已复原；但遍历期间树被临时修改，不能同时有其他读者
+        while (t != nullptr) {
+            if (t->left == nullptr) {
+                out << t->element << std::endl;
+                t = t->right;
+            } else {
+                BinaryNode *pred = t->left;
+                while (pred->right != nullptr && pred->right != t) {
+                    pred = pred->right;
+                }
+                if (pred->right == nullptr) {  /// 第一次到达 t
+                    pred->right = t;
+                    t = t->left;
+                } else {                       /// 第二次到达 t
+                    pred->right = nullptr;
+                    out << t->element << std::endl;
+                    t = t->right;
+                }
+            }
         }
     }
 
     /**
-     * @brief 递归清空树中的所有元素
+     * @brief 清空树中的所有元素
      * 
      * @param t 当前节点指针
      */
     void makeEmpty(BinaryNode * &t) {
-        /// 这必须是一个后序遍历，为什么？
-        if (t != nullptr) {
-            makeEmpty(t->left);
-            makeEmpty(t->right);
-            delete t;
-            /// delete 并不会自动将指针置空，这里需要手动置空
-            t = nullptr;
+        /// 递归版本必须是后序遍历：删除节点前要先处理它的子树
+        /// 循环版本换一个思路：如果 t 有左孩子，就做一次右旋，把左孩子提上来，
+        /// 直到 t 没有左孩子；这时删掉 t，它的右孩子成为新的 t
+        /// 每个节点至多被旋转一次，所以总时间仍是 O(n)，而且不需要栈
+        /// 旋转不维护父指针：这些节点马上都要删掉了
+        while (t != nullptr) {
+            if (t->left != nullptr) {
+                BinaryNode *leftChild = t->left;
+                t->left = leftChild->right;
+                leftChild->right = t;
+                t = leftChild;
+            } else {
+                BinaryNode *rightChild = t->right;
+                delete t;
+                t = rightChild;
+            }
         }
+        /// 循环结束时 t 已经是 nullptr
     }
 
     /**
-     * @brief 递归插入一个常量引用元素到树中
+     * @brief 插入一个常量引用元素到树中
      * 
      * @param x 要插入的元素
      * @param t 当前节点指针
      */
     void insert(const Comparable &x, BinaryNode * &t) {
-        /// 这句话乍一看不可思异，怎么能对一个空指针赋值呢？
-        /// 但是这里是引用，所以实际上是对指针 t 的引用，t 现在存了 nullptr, 
-        /// 所以可以修改指针 t 的值
-        if (t == nullptr) {
-            /// 创建一个新节点，包含 x 的值，左右子节点为空
-            /// 挂在 t 指向的节点上
-            /// 而在递归过程中，t 总是会指向父节点的左子节点或右子节点
-            /// 所以这里实际上是将新节点挂在父节点的左子节点或右子节点上
-            t = new BinaryNode{x, nullptr, nullptr};
-        } else if (x < t->element) {
-            insert(x, t->left);
-        } else if (x > t->element) {
-            insert(x, t->right);
-        } else {
-            /// 如果元素已存在，则不进行插入
-            /// 这种情况不可遗漏，严格的规则中也可以抛出异常
+        /// 递归版本里 t 是指针的引用，新节点直接赋给 t，就挂到了父节点的左或右指针上
+        /// 循环版本用"指向指针的指针" p 做同样的事：p 一开始指向 t，
+        /// 每向下走一步就改为指向当前节点的 left 或 right，直到 *p 为空
+        /// parent 记下 *p 所在的节点，新节点的父指针就是它
+        BinaryNode **p = &t;
+        BinaryNode *parent = nullptr;
+        while (*p != nullptr) {
+            parent = *p;
+            if (x < (*p)->element) {
+                p = &(*p)->left;
+            } else if (x > (*p)->element) {
+                p = &(*p)->right;
+            } else {
+                /// 如果元素已存在，则不进行插入
+                /// 这种情况不可遗漏，严格的规则中也可以抛出异常
+                return;
+            }
         }
+        *p = new BinaryNode{x, nullptr, nullptr, parent};
     }
 
     /**
-     * @brief 递归插入一个右值引用元素到树中
+     * @brief 插入一个右值引用元素到树中
      * 
      * @param x 要插入的元素
      * @param t 当前节点指针
      */
     void insert(Comparable &&x, BinaryNode * &t) {
         /// 一样的逻辑
-        if (t == nullptr) {
-            t = new BinaryNode{std::move(x), nullptr, nullptr};
-        } else if (x < t->element) {
-            insert(std::move(x), t->left);
-        } else if (x > t->element) {
-            insert(std::move(x), t->right);
-        } else {
-            // 如果元素已存在，则不进行插入
+        BinaryNode **p = &t;
+        BinaryNode *parent = nullptr;
+        while (*p != nullptr) {
+            parent = *p;
+            if (x < (*p)->element) {
+                p = &(*p)->left;
+            } else if (x > (*p)->element) {
+                p = &(*p)->right;
+            } else {
+                return;  // 如果元素已存在，则不进行插入
+            }
         }
+        *p = new BinaryNode{std::move(x), nullptr, nullptr, parent};
     }
 
     /**
-     * @brief 递归从树中移除指定的元素
+     * @brief 从树中移除指定的元素
      * 
      * @param x 要移除的元素
      * @param t 当前节点指针
      */
     void remove(const Comparable &x, BinaryNode * &t) {
         /// 这个逻辑其实是 find and remove, 从 t 开始
-        if (t == nullptr) {
+        /// 和 insert 一样，p 指向"指向当前节点的那个指针"
+        BinaryNode **p = &t;
+        while (*p != nullptr && (x < (*p)->element || x > (*p)->element)) {
+            p = (x < (*p)->element) ? &(*p)->left : &(*p)->right;
+        }
+        if (*p == nullptr) {
             return;  /// 元素不存在
         }
-        if (x < t->element) {
-            remove(x, t->left);
-        } else if (x > t->element) {
-            remove(x, t->right);
-        } 
-        /// 进入以下这两个分支，都是说明找到了要删除的元素
-        else if (t->left != nullptr && t->right != nullptr) {  /// 有两个子节点
+        BinaryNode *oldNode = *p;
+        if (oldNode->left != nullptr && oldNode->right != nullptr) {  /// 有两个子节点
             /// 将右子树中的最小元素替换当前节点，这里实际上只是替换值，不是替换节点
-            t->element = findMin(t->right)->element;
-            /// 然后递归删除右子树中的最小元素
-            remove(t->element, t->right);
-            /// 这是一种效率较低的做法，更好的做法是做节点的替换和移动
-            /// 但会更加复杂，我们在后面再讨论
-        } else {
-            /// 有一个或没有子节点的情形是简单的
-            BinaryNode *oldNode = t;
-            t = (t->left != nullptr) ? t->left : t->right;
-            delete oldNode;
+            /// 然后删除右子树中的最小节点，它没有左孩子，属于下面的简单情形
+            /// 递归版本要从 t->right 重新查找一遍，这里直接把 p 移到那个节点上
+            p = &oldNode->right;
+            while ((*p)->left != nullptr) {
+                p = &(*p)->left;
+            }
+            oldNode->element = (*p)->element;
+            oldNode = *p;
         }
+        /// 有一个或没有子节点的情形是简单的：孩子接替 oldNode，也接过它的父节点
+        BinaryNode *child = (oldNode->left != nullptr) ? oldNode->left : oldNode->right;
+        if (child != nullptr) {
+            child->parent = oldNode->parent;
+        }
+        *p = child;
+        delete oldNode;
     }
 
     /**
-     * @brief 递归克隆树的结构
+     * @brief 克隆树的结构
      * 
      * @param t 当前节点指针
      * @return 新的节点指针
      */
     BinaryNode *clone(BinaryNode *t) const {
-        if (t == nullptr) {
-            return nullptr;
+        /// 用一个显式的栈代替递归调用栈，栈放在堆上，不会溢出
+        /// 栈中每一项是一个待复制的原节点、副本中应该指向它的复制品的那个指针，
+        /// 以及复制品的父节点
+        struct Pending {
+            BinaryNode *from;
+            BinaryNode **to;
+            BinaryNode *parent;
+        };
+        BinaryNode *copy = nullptr;
+        std::vector<Pending> pending{ {t, &copy, nullptr} };
+        while (!pending.empty()) {
+            Pending next = pending.back();
+            pending.pop_back();
+            if (next.from != nullptr) {
+                *next.to = new BinaryNode{next.from->element, nullptr, nullptr, next.parent};
+                pending.push_back({next.from->right, &(*next.to)->right, *next.to});
+                pending.push_back({next.from->left, &(*next.to)->left, *next.to});
+            }
         }
-        return new BinaryNode{t->element, clone(t->left), clone(t->right)};
+        return copy;
     }
 };
 
@@ -1,14 +1,16 @@
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <vector>
-#include "BinarySearchTree.h"
+#include "../code/TreeSort.h"
 using namespace std;
 
     // Test program
+    // Tree sort through a balanced tree: duplicates are kept, sorted
+    // input stays O( N log N ), and the result goes to any output iterator.
 int main( )
 {
-    BinarySearchTree<int> t;
-
-    vector<int> input {3, 1, 7, 2, 5, 9, 4};
+    vector<int> input {3, 1, 7, 2, 5, 9, 4, 7, 1, 3};
 
     cout << "Before:\t";
     for (vector<int>::iterator it = input.begin();
@@ -16,10 +18,25 @@ int main( )
 	 it++)
     {
 	cout << *it << '\t';
-	t.insert(*it);
     }
     cout << endl;
+
     cout << "After:\t";
-    t.printTree();
+    treeSort(input.begin(), input.end(), ostream_iterator<int>(cout, "\t"));
+    cout << endl;
+
+    vector<int> sorted;
+    treeSort(input.begin(), input.end(), back_inserter(sorted), TreeSortMode::COUNTED);
+    cout << "Counted:\t";
+    for (int x : sorted)
+	cout << x << '\t';
+    cout << endl;
+
+    vector<int> big(1000000);
+    for (size_t i = 0; i < big.size(); i++)
+	big[i] = i / 2;
+    treeSort(big, TreeSortMode::RED_BLACK);
+    cout << "Sorted input of size " << big.size() << ": "
+	 << (is_sorted(big.begin(), big.end()) ? "ok" : "error") << endl;
     return 0;
 }
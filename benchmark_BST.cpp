@@ -0,0 +1,112 @@
+// BST.h 中各操作的计时：随机输入和有序（退化成链）输入
+//
+// BST.h 现在是循环实现；BST_comments.h 是改动前的同一份代码，仍是递归实现。
+// 分别编译两次来比较改动前后：
+//     g++ -O2 benchmark_BST.cpp -o after
+//     g++ -O2 -DRECURSIVE benchmark_BST.cpp -o before
+//     ./after [N [M]]      N 个随机元素（默认 1000000），M 个有序元素（默认 20000）
+// 有序输入下树的深度是 M，递归版本的 clone / makeEmpty / printTree
+// 在 M 较大时会耗尽栈空间；有序插入本身是 O(M^2) 的。
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef RECURSIVE
+#include "BST_comments.h"
+#else
+#include "BST.h"
+#endif
+
+/// 计时并打印每个元素的平均纳秒数
+template <typename F>
+void report(const std::string &name, long long n, F work) {
+    auto start = std::chrono::steady_clock::now();
+    long long sum = work();
+    auto end = std::chrono::steady_clock::now();
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(10)
+              << std::chrono::duration<double, std::nano>(end - start).count() / n
+              << " ns/item   " << sum << std::endl;
+}
+
+/// 依次插入 keys，然后计时各个操作
+void run(const std::vector<int> &keys, const std::vector<int> &probes) {
+    long long n = keys.size();
+    BinarySearchTree<int> t;
+    report("insert", n, [&] {
+        for (int k : keys) {
+            t.insert(k);
+        }
+        return 0LL;
+    });
+    report("contains", probes.size(), [&] {
+        long long hits = 0;
+        for (int p : probes) {
+            hits += t.contains(p);
+        }
+        return hits;
+    });
+    report("findMin", 1, [&] { return (long long) t.findMin(); });
+    std::ostream nowhere(nullptr);  // 丢弃输出，只计遍历的代价
+    report("printTree", n, [&] {
+        t.printTree(nowhere);
+        return 0LL;
+    });
+    BinarySearchTree<int> copy;
+    report("clone", n, [&] {
+        copy = t;
+        return (long long) copy.findMax();
+    });
+    report("remove", n / 2, [&] {
+        for (long long i = 0; i < n / 2; ++i) {
+            t.remove(keys[i]);
+        }
+        return 0LL;
+    });
+    report("makeEmpty", n, [&] {
+        copy.makeEmpty();
+        t.makeEmpty();
+        return 0LL;
+    });
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int m = argc > 2 ? std::atoi(argv[2]) : 20000;
+#ifdef RECURSIVE
+    std::cout << "Recursive BST (BST_comments.h)" << std::endl;
+#else
+    std::cout << "Iterative BST (BST.h)" << std::endl;
+#endif
+
+    // 偶数是树中的元素，奇数用来查找失败
+    std::mt19937 gen(2024);
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; ++i) {
+        keys[i] = 2 * i;
+    }
+    std::shuffle(keys.begin(), keys.end(), gen);
+    std::vector<int> probes(n);
+    for (auto &p : probes) {
+        p = gen() % (2 * n);
+    }
+    std::cout << n << " random keys" << std::endl;
+    run(keys, probes);
+
+    std::vector<int> sorted(m);
+    for (int i = 0; i < m; ++i) {
+        sorted[i] = 2 * i;
+    }
+    std::vector<int> sortedProbes(m);
+    for (auto &p : sortedProbes) {
+        p = gen() % (2 * m);
+    }
+    std::cout << m << " sorted keys" << std::endl;
+    run(sorted, sortedProbes);
+    return 0;
+}
@@ -0,0 +1,407 @@
+#ifndef ARRAY_BINOMIAL_QUEUE_H
+#define ARRAY_BINOMIAL_QUEUE_H
+
+#include <memory>
+#include <vector>
+#include "dsexceptions.h"
+using namespace std;
+
+// ArrayBinomialQueue class
+//
+// CONSTRUCTION: with (a) no parameters, which gives the queue its own
+//     arena, or (b) a shared_ptr to an Arena shared with other queues
+//
+// A binomial queue whose nodes live in an index-linked arena.
+// Tree i is present exactly when bit i of the size is set, so the
+// size doubles as the occupancy bitmap, and merge walks only the
+// occupied ranks of rhs using count-trailing-zeros. The index of the
+// minimum tree is cached, so findMin is O(1).
+// Merging queues that share an arena is O(log N); merging queues
+// with different arenas first copies rhs's nodes, O(size of rhs).
+//
+// ******************PUBLIC OPERATIONS*********************
+// void insert( x )       --> Insert x
+// deleteMin( )           --> Return and remove smallest item
+// Comparable findMin( )  --> Return smallest item
+// bool isEmpty( )        --> Return true if empty; else false
+// void makeEmpty( )      --> Remove all items
+// void merge( rhs )      --> Absorb rhs into this heap
+// ******************ERRORS********************************
+// Throws UnderflowException as warranted
+
+template <typename Comparable>
+class ArrayBinomialQueue
+{
+  private:
+    static const int NIL = -1;
+
+    struct BinomialNode
+    {
+        Comparable element;
+        int        leftChild;
+        int        nextSibling;
+    };
+
+  public:
+    /**
+     * Node storage, possibly shared by several queues.
+     * Free nodes are chained through nextSibling.
+     */
+    class Arena
+    {
+      public:
+        Arena( ) : freeList{ NIL } { }
+
+      private:
+        vector<BinomialNode> nodes;
+        int freeList;
+
+        int allocate( Comparable && x )
+        {
+            if( freeList == NIL )
+            {
+                nodes.push_back( BinomialNode{ std::move( x ), NIL, NIL } );
+                return nodes.size( ) - 1;
+            }
+            int t = freeList;
+            freeList = nodes[ t ].nextSibling;
+            nodes[ t ] = BinomialNode{ std::move( x ), NIL, NIL };
+            return t;
+        }
+
+        void release( int t )
+        {
+            nodes[ t ].nextSibling = freeList;
+            freeList = t;
+        }
+
+        void clear( )
+        {
+            nodes.clear( );
+            freeList = NIL;
+        }
+
+        friend class ArrayBinomialQueue;
+    };
+
+    ArrayBinomialQueue( ) : ArrayBinomialQueue{ make_shared<Arena>( ) }
+      { }
+
+    explicit ArrayBinomialQueue( shared_ptr<Arena> a )
+      : arena{ std::move( a ) }, currentSize{ 0 }, minIndex{ 0 }
+    {
+        for( auto & root : theTrees )
+            root = NIL;
+    }
+
+    ArrayBinomialQueue( const ArrayBinomialQueue & rhs )
+      : arena{ make_shared<Arena>( ) }, currentSize{ rhs.currentSize },
+        minIndex{ rhs.minIndex }
+    {
+        for( int i = 0; i < MAX_TREES; ++i )
+            theTrees[ i ] = clone( *rhs.arena, rhs.theTrees[ i ] );
+    }
+
+    ArrayBinomialQueue( ArrayBinomialQueue && rhs )
+      : arena{ rhs.arena }, currentSize{ rhs.currentSize }, minIndex{ rhs.minIndex }
+    {
+        for( int i = 0; i < MAX_TREES; ++i )
+        {
+            theTrees[ i ] = rhs.theTrees[ i ];
+            rhs.theTrees[ i ] = NIL;
+        }
+        rhs.currentSize = 0;
+    }
+
+    ~ArrayBinomialQueue( )
+      { makeEmpty( ); }
+
+    /**
+     * Deep copy.
+     */
+    ArrayBinomialQueue & operator=( const ArrayBinomialQueue & rhs )
+    {
+        ArrayBinomialQueue copy = rhs;
+        std::swap( *this, copy );
+        return *this;
+    }
+
+    /**
+     * Move.
+     */
+    ArrayBinomialQueue & operator=( ArrayBinomialQueue && rhs )
+    {
+        std::swap( arena, rhs.arena );
+        std::swap( theTrees, rhs.theTrees );
+        std::swap( currentSize, rhs.currentSize );
+        std::swap( minIndex, rhs.minIndex );
+
+        return *this;
+    }
+
+    /**
+     * Return true if empty; false otherwise.
+     */
+    bool isEmpty( ) const
+      { return currentSize == 0; }
+
+    /**
+     * Returns minimum item.
+     * Throws UnderflowException if empty.
+     */
+    const Comparable & findMin( ) const
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+
+        return node( theTrees[ minIndex ] ).element;
+    }
+
+    /**
+     * Insert item x into the priority queue; allows duplicates.
+     */
+    void insert( const Comparable & x )
+    {
+        Comparable copy = x;
+        insert( std::move( copy ) );
+    }
+
+    /**
+     * Insert item x into the priority queue; allows duplicates.
+     * This is a binary increment: the new tree is carried up
+     * through the run of occupied ranks starting at 0.
+     */
+    void insert( Comparable && x )
+    {
+        int carry = arena->allocate( std::move( x ) );
+        int rank = 0;
+        for( ; currentSize & ( 1ULL << rank ); ++rank )
+        {
+            carry = combineTrees( theTrees[ rank ], carry );
+            theTrees[ rank ] = NIL;
+        }
+        theTrees[ rank ] = carry;
+
+            // Trees below rank were absorbed into the new tree
+        if( currentSize == 0 || minIndex < rank ||
+            node( carry ).element < node( theTrees[ minIndex ] ).element )
+            minIndex = rank;
+        ++currentSize;
+    }
+
+    /**
+     * Remove the smallest item from the priority queue.
+     * Throws UnderflowException if empty.
+     */
+    void deleteMin( )
+    {
+        Comparable x;
+        deleteMin( x );
+    }
+
+    /**
+     * Remove the minimum item and place it in minItem.
+     * Throws UnderflowException if empty.
+     */
+    void deleteMin( Comparable & minItem )
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+
+        int oldRoot = theTrees[ minIndex ];
+        minItem = std::move( node( oldRoot ).element );
+
+            // The children of a rank k root have ranks k-1, ..., 0
+        int children[ MAX_TREES ];
+        int deletedTree = node( oldRoot ).leftChild;
+        for( int j = minIndex - 1; j >= 0; --j )
+        {
+            children[ j ] = deletedTree;
+            deletedTree = node( deletedTree ).nextSibling;
+            node( children[ j ] ).nextSibling = NIL;
+        }
+        arena->release( oldRoot );
+
+        theTrees[ minIndex ] = NIL;
+        currentSize -= 1ULL << minIndex;
+        mergeTrees( children, ( 1ULL << minIndex ) - 1 );
+    }
+
+    /**
+     * Make the priority queue logically empty.
+     * If the arena is not shared, it is reset in one step;
+     * otherwise the nodes are returned to its free list.
+     */
+    void makeEmpty( )
+    {
+        if( arena.use_count( ) == 1 )
+            arena->clear( );
+        else
+            for( unsigned long long m = currentSize; m != 0; m &= m - 1 )
+                release( theTrees[ __builtin_ctzll( m ) ] );
+
+        for( auto & root : theTrees )
+            root = NIL;
+        currentSize = 0;
+        minIndex = 0;
+    }
+
+    /**
+     * Merge rhs into the priority queue.
+     * rhs becomes empty. rhs must be different from this.
+     */
+    void merge( ArrayBinomialQueue & rhs )
+    {
+        if( this == &rhs )    // Avoid aliasing problems
+            return;
+
+        if( arena != rhs.arena )
+        {
+            for( unsigned long long m = rhs.currentSize; m != 0; m &= m - 1 )
+            {
+                int & root = rhs.theTrees[ __builtin_ctzll( m ) ];
+                int copy = clone( *rhs.arena, root );
+                rhs.release( root );
+                root = copy;
+            }
+        }
+
+        mergeTrees( rhs.theTrees, rhs.currentSize );
+
+        for( auto & root : rhs.theTrees )
+            root = NIL;
+        rhs.currentSize = 0;
+        rhs.minIndex = 0;
+    }
+
+  private:
+    static const int MAX_TREES = 64;
+
+    shared_ptr<Arena> arena;
+    int theTrees[ MAX_TREES ];        // Tree roots; NIL where the size bit is 0
+    unsigned long long currentSize;   // Number of items; also the tree bitmap
+    int minIndex;                     // Rank of the tree with the smallest root
+
+    BinomialNode & node( int t )
+      { return arena->nodes[ t ]; }
+
+    const BinomialNode & node( int t ) const
+      { return arena->nodes[ t ]; }
+
+    /**
+     * Add the trees of a second queue (in this arena) to this one.
+     * rhsTrees[ i ] is a root of rank i wherever bit i of rhsSize is set.
+     * Only the occupied ranks of rhs and the ranks a carry reaches are visited.
+     */
+    void mergeTrees( const int rhsTrees[ ], unsigned long long rhsSize )
+    {
+        int carry = NIL;
+        unsigned long long pending = rhsSize;
+        int rank = 0;
+
+        while( pending != 0 || carry != NIL )
+        {
+            if( carry == NIL )
+                rank = __builtin_ctzll( pending );
+
+            int t1 = currentSize & ( 1ULL << rank ) ? theTrees[ rank ] : NIL;
+            int t2 = pending & ( 1ULL << rank ) ? rhsTrees[ rank ] : NIL;
+            pending &= ~( 1ULL << rank );
+
+            int whichCase = t1 == NIL ? 0 : 1;
+            whichCase += t2 == NIL ? 0 : 2;
+            whichCase += carry == NIL ? 0 : 4;
+
+            switch( whichCase )
+            {
+              case 2: /* Only rhs */
+                theTrees[ rank ] = t2;
+                break;
+              case 4: /* Only carry */
+                theTrees[ rank ] = carry;
+                carry = NIL;
+                break;
+              case 3: /* this and rhs */
+                carry = combineTrees( t1, t2 );
+                theTrees[ rank ] = NIL;
+                break;
+              case 5: /* this and carry */
+                carry = combineTrees( t1, carry );
+                theTrees[ rank ] = NIL;
+                break;
+              case 6: /* rhs and carry */
+                carry = combineTrees( t2, carry );
+                break;
+              case 7: /* All three */
+                theTrees[ rank ] = carry;
+                carry = combineTrees( t1, t2 );
+                break;
+            }
+            ++rank;
+        }
+
+        currentSize += rhsSize;
+        findMinIndex( );
+    }
+
+    /**
+     * Recompute minIndex by visiting the occupied ranks only.
+     */
+    void findMinIndex( )
+    {
+        if( currentSize == 0 )
+            return;
+
+        minIndex = __builtin_ctzll( currentSize );
+        for( unsigned long long m = currentSize & ( currentSize - 1 ); m != 0; m &= m - 1 )
+        {
+            int i = __builtin_ctzll( m );
+            if( node( theTrees[ i ] ).element < node( theTrees[ minIndex ] ).element )
+                minIndex = i;
+        }
+    }
+
+    /**
+     * Return the result of merging equal-sized t1 and t2.
+     */
+    int combineTrees( int t1, int t2 )
+    {
+        if( node( t2 ).element < node( t1 ).element )
+            std::swap( t1, t2 );
+        node( t2 ).nextSibling = node( t1 ).leftChild;
+        node( t1 ).leftChild = t2;
+        return t1;
+    }
+
+    /**
+     * Return the nodes of a binomial tree to the arena's free list.
+     */
+    void release( int t )
+    {
+        if( t != NIL )
+        {
+            release( node( t ).leftChild );
+            release( node( t ).nextSibling );
+            arena->release( t );
+        }
+    }
+
+    /**
+     * Internal method to clone subtree t of arena from into this arena.
+     */
+    int clone( const Arena & from, int t )
+    {
+        if( t == NIL )
+            return NIL;
+
+        int left = clone( from, from.nodes[ t ].leftChild );
+        int next = clone( from, from.nodes[ t ].nextSibling );
+        Comparable copy = from.nodes[ t ].element;
+        int c = arena->allocate( std::move( copy ) );
+        node( c ).leftChild = left;
+        node( c ).nextSibling = next;
+        return c;
+    }
+};
+
+#endif
@@ -2,41 +2,192 @@
 #define AVL_TREE_H
 
 #include "dsexceptions.h"
+#include "EytzingerSet.h"
+#include "NodeStorage.h"
 #include <algorithm>
+#include <future>
 #include <iostream> 
+#include <iterator>
+#include <utility>
+#include <vector>
 using namespace std;
 
 // AvlTree class
 //
-// CONSTRUCTION: zero parameter
+// CONSTRUCTION: zero parameter, or a sorted random-access range
+//               (built in linear time, optionally by several threads)
+// Storage (HeapNodes or ArenaNodes, see NodeStorage.h) selects how
+// nodes are allocated and linked
 //
 // ******************PUBLIC OPERATIONS*********************
 // void insert( x )       --> Insert x
-// void remove( x )       --> Remove x (unimplemented)
+// void remove( x )       --> Remove x
 // bool contains( x )     --> Return true if x is present
 // Comparable findMin( )  --> Return smallest item
 // Comparable findMax( )  --> Return largest item
 // boolean isEmpty( )     --> Return true if empty; else false
 // void makeEmpty( )      --> Remove all items
 // void printTree( )      --> Print tree in sorted order
+// void unionWith( rhs )  --> Absorb rhs into this tree
+// int size( )            --> Return number of items
+// int rank( x )          --> Return number of items less than x
+// Comparable select( k ) --> Return k-th smallest item (k from 1)
+// int countInRange( lo, hi )
+//                        --> Return number of items in [ lo, hi ]
+// const_iterator begin( ), end( )
+//                        --> Bidirectional in-order iteration
+// const_iterator lower_bound( x )
+//                        --> First item not less than x
+// const_iterator upper_bound( x )
+//                        --> First item greater than x
+// pair equal_range( x )  --> Iterators bounding the items equal to x
+// pair range( lo, hi )   --> Iterators bounding the items in [ lo, hi ]
+// EytzingerSet freeze( ) --> Return a read-only copy for fast lookups
 // ******************ERRORS********************************
 // Throws UnderflowException as warranted
+// Throws ArrayIndexOutOfBoundsException if select's k is out of range
+// Throws IteratorOutOfBoundsException if an iterator moves
+//     beyond begin( ) or end( )
 
 /// @brief AVL Tree 的实现
 /// @tparam Comparable 可比较的类型，存储的元素类型
-template <typename Comparable>
+template <typename Comparable, typename Storage = HeapNodes>
 class AvlTree
 {
+    struct AvlNode;
+    using NodePtr  = typename Storage::template pointer<AvlNode>;
+    using NodePool = typename Storage::template Pool<AvlNode>;
+
   public:
+    /**
+     * In-order iterator. Each step follows child and parent links,
+     * so a full scan takes linear time and no stack.
+     * Changing the tree invalidates all iterators.
+     */
+    class const_iterator
+    {
+      public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type        = Comparable;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const Comparable *;
+        using reference         = const Comparable &;
+
+        const_iterator( ) : tree{ nullptr }, current{ nullptr }
+          { }
+
+        const Comparable & operator* ( ) const
+          { return current->element; }
+
+        const Comparable * operator-> ( ) const
+          { return &current->element; }
+
+        const_iterator & operator++ ( )
+        {
+            if( current == nullptr )
+                throw IteratorOutOfBoundsException{ };
+            if( current->right != nullptr )
+                current = tree->findMin( current->right );
+            else
+            {
+                NodePtr child;
+                do
+                {
+                    child = current;
+                    current = current->parent;
+                } while( current != nullptr && child == current->right );
+            }
+            return *this;
+        }
+
+        const_iterator operator++ ( int )
+        {
+            const_iterator old = *this;
+            ++( *this );
+            return old;
+        }
+
+        const_iterator & operator-- ( )
+        {
+            NodePtr p = current;
+            if( p == nullptr )
+                p = tree->findMax( tree->root );
+            else if( p->left != nullptr )
+                p = tree->findMax( p->left );
+            else
+            {
+                NodePtr child;
+                do
+                {
+                    child = p;
+                    p = p->parent;
+                } while( p != nullptr && child == p->left );
+            }
+            if( p == nullptr )
+                throw IteratorOutOfBoundsException{ };
+            current = p;
+            return *this;
+        }
+
+        const_iterator operator-- ( int )
+        {
+            const_iterator old = *this;
+            --( *this );
+            return old;
+        }
+
+        bool operator== ( const const_iterator & rhs ) const
+          { return current == rhs.current; }
+
+        bool operator!= ( const const_iterator & rhs ) const
+          { return !( *this == rhs ); }
+
+      private:
+        const AvlTree *tree;
+        NodePtr current;    // nullptr for end( )
+
+        const_iterator( const AvlTree *t, NodePtr p )
+          : tree{ t }, current{ p }
+          { }
+
+        friend class AvlTree;
+    };
+
     AvlTree( ) : root{ nullptr }
       { }
+
+    /**
+     * Construct the tree from the sorted range [ first, last )
+     * in linear time, without rotations. Duplicates are skipped.
+     * Subtrees are built by up to numThreads threads.
+     */
+    template <typename RandomIterator>
+    AvlTree( RandomIterator first, RandomIterator last, int numThreads = 1 )
+      : root{ nullptr }
+    {
+        auto notIncreasing = [ ]( const Comparable & a, const Comparable & b )
+                               { return !( a < b ); };
+        if( adjacent_find( first, last, notIncreasing ) == last )
+            root = buildSorted( first, last, numThreads );
+        else
+        {
+            vector<Comparable> items{ first, last };
+            items.erase( unique( items.begin( ), items.end( ),
+                                 [ ]( const Comparable & a, const Comparable & b )
+                                   { return !( a < b ) && !( b < a ); } ),
+                         items.end( ) );
+            root = buildSorted( items.begin( ), items.end( ), numThreads );
+        }
+        setRootParent( );
+    }
     
     AvlTree( const AvlTree & rhs ) : root{ nullptr }
     {
         root = clone( rhs.root );
+        setRootParent( );
     }
 
-    AvlTree( AvlTree && rhs ) : root{ rhs.root }
+    AvlTree( AvlTree && rhs ) : root{ rhs.root }, pool{ std::move( rhs.pool ) }
     {
         rhs.root = nullptr;
     }
@@ -62,9 +213,68 @@ class AvlTree
     AvlTree & operator=( AvlTree && rhs )
     {
         std::swap( root, rhs.root );
+        pool.swap( rhs.pool );
         
         return *this;
     }
+
+    const_iterator begin( ) const
+      { return const_iterator{ this, findMin( root ) }; }
+
+    const_iterator end( ) const
+      { return const_iterator{ this, nullptr }; }
+
+    /**
+     * Return an iterator to the first item not less than x.
+     */
+    const_iterator lower_bound( const Comparable & x ) const
+    {
+        NodePtr bound = nullptr;
+        for( NodePtr t = root; t != nullptr; )
+            if( t->element < x )
+                t = t->right;
+            else
+            {
+                bound = t;
+                t = t->left;
+            }
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * Return an iterator to the first item greater than x.
+     */
+    const_iterator upper_bound( const Comparable & x ) const
+    {
+        NodePtr bound = nullptr;
+        for( NodePtr t = root; t != nullptr; )
+            if( x < t->element )
+            {
+                bound = t;
+                t = t->left;
+            }
+            else
+                t = t->right;
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * Return the iterators bounding the items equal to x,
+     * as lower_bound( x ) and upper_bound( x ).
+     */
+    pair<const_iterator, const_iterator> equal_range( const Comparable & x ) const
+    {
+        return { lower_bound( x ), upper_bound( x ) };
+    }
+
+    /**
+     * Return the iterators bounding the items in the closed range [ lo, hi ].
+     */
+    pair<const_iterator, const_iterator> range( const Comparable & lo,
+                                                const Comparable & hi ) const
+    {
+        return { lower_bound( lo ), upper_bound( hi ) };
+    }
     
     /**
      * Find the smallest item in the tree.
@@ -105,6 +315,69 @@ class AvlTree
         return root == nullptr;
     }
 
+    /**
+     * Return the number of items in the tree.
+     */
+    int size( ) const
+    {
+        return size( root );
+    }
+
+    /**
+     * Return the number of items less than x.
+     * If x is present, select( rank( x ) + 1 ) is x.
+     */
+    int rank( const Comparable & x ) const
+    {
+        int r = 0;
+        for( NodePtr t = root; t != nullptr; )
+            if( x < t->element )
+                t = t->left;
+            else if( t->element < x )
+            {
+                r += size( t->left ) + 1;
+                t = t->right;
+            }
+            else
+                return r + size( t->left );
+        return r;
+    }
+
+    /**
+     * Return the k-th smallest item; select( 1 ) is findMin( ).
+     * Throw ArrayIndexOutOfBoundsException unless 1 <= k <= size( ).
+     */
+    const Comparable & select( int k ) const
+    {
+        if( k < 1 || k > size( ) )
+            throw ArrayIndexOutOfBoundsException{ };
+
+        NodePtr t = root;
+        for( ; ; )
+        {
+            int leftSize = size( t->left );
+            if( k <= leftSize )
+                t = t->left;
+            else if( k == leftSize + 1 )
+                return t->element;
+            else
+            {
+                k -= leftSize + 1;
+                t = t->right;
+            }
+        }
+    }
+
+    /**
+     * Return the number of items x with lo <= x <= hi.
+     */
+    int countInRange( const Comparable & lo, const Comparable & hi ) const
+    {
+        if( hi < lo )
+            return 0;
+        return rank( hi ) + contains( hi ) - rank( lo );
+    }
+
     /**
      * Print the tree contents in sorted order.
      */
@@ -113,7 +386,17 @@ class AvlTree
         if( isEmpty( ) )
             cout << "Empty tree" << endl;
         else
-            printTree( root );
+            for( const Comparable & x : *this )
+                cout << x << endl;
+    }
+
+    /**
+     * Return a read-only copy of the items, laid out for fast
+     * lookups; later changes to the tree do not affect it.
+     */
+    EytzingerSet<Comparable> freeze( ) const
+    {
+        return EytzingerSet<Comparable>{ begin( ), end( ) };
     }
 
     /**
@@ -121,7 +404,13 @@ class AvlTree
      */
     void makeEmpty( )
     {
-        makeEmpty( root );
+        if( NodePool::BULK_RELEASE )    // Arena nodes need no destructor
+        {
+            pool.releaseAll( );
+            root = nullptr;
+        }
+        else
+            makeEmpty( root );
     }
 
     /**
@@ -129,7 +418,8 @@ class AvlTree
      */
     void insert( const Comparable & x )
     {
-        insert( x, root );
+        insertItem( x );
+        setRootParent( );
     }
      
     /**
@@ -137,7 +427,8 @@ class AvlTree
      */
     void insert( Comparable && x )
     {
-        insert( std::move( x ), root );
+        insertItem( std::move( x ) );
+        setRootParent( );
     }
      
     /**
@@ -145,104 +436,145 @@ class AvlTree
      */
     void remove( const Comparable & x )
     {
-        remove( x, root );
+        removeItem( x );
+        setRootParent( );
+    }
+
+    /**
+     * Merge rhs into the tree, with the join-based union.
+     * If rhs has m items and this tree n >= m, this takes
+     * O( m log( n / m + 1 ) ) time.
+     * rhs becomes empty. rhs must be different from this.
+     */
+    void unionWith( AvlTree & rhs )
+    {
+        if( this == &rhs )    // Avoid aliasing problems
+            return;
+
+        root = unionOf( root, rhs.root );
+        rhs.root = nullptr;
+        pool.splice( rhs.pool );
+        setRootParent( );
     }
 
   private:
     struct AvlNode
     {
         Comparable element;
-        AvlNode   *left;
-        AvlNode   *right;
+        NodePtr   left;
+        NodePtr   right;
+        NodePtr   parent;  /*< 父节点，根节点为 nullptr */
         int       height;  /*< AVL Tree 节点的高度 */
+        int       size;    /*< 以该节点为根的子树的节点数 */
 
-        AvlNode( const Comparable & ele, AvlNode *lt, AvlNode *rt, int h = 0 )
-          : element{ ele }, left{ lt }, right{ rt }, height{ h } { }
+        AvlNode( const Comparable & ele, NodePtr lt, NodePtr rt, int h = 0, int sz = 1 )
+          : element{ ele }, left{ lt }, right{ rt }, parent{ nullptr }, height{ h }, size{ sz } { }
         
-        AvlNode( Comparable && ele, AvlNode *lt, AvlNode *rt, int h = 0 )
-          : element{ std::move( ele ) }, left{ lt }, right{ rt }, height{ h } { }
+        AvlNode( Comparable && ele, NodePtr lt, NodePtr rt, int h = 0, int sz = 1 )
+          : element{ std::move( ele ) }, left{ lt }, right{ rt }, parent{ nullptr }, height{ h }, size{ sz } { }
     };
 
-    AvlNode *root;
+    NodePtr root;
+    NodePool pool;         /*< 节点的分配方式，见 NodeStorage.h */
 
 
     /**
-     * Internal method to insert into a subtree.
-     * x is the item to insert.
-     * t is the node that roots the subtree.
-     * Set the new root of the subtree.
+     * Deepest path insertItem and removeItem record. An AVL tree of
+     * height h has at least Fib( h + 3 ) - 1 nodes, so fewer than
+     * 2^31 nodes never need more than 45 levels.
      */
-    void insert( const Comparable & x, AvlNode * & t )
-    {
-        /// 前面和普通的二叉搜索树插入一致
-        if( t == nullptr )
-            t = new AvlNode{ x, nullptr, nullptr };
-        else if( x < t->element )
-            insert( x, t->left );
-        else if( t->element < x )
-            insert( x, t->right );
-        
-        /// 插入后进行平衡操作，主要作用：1.检查是否失衡 2.进行相应的旋转操作 3.更新高度
-        /// 注意每一次退出递归调用时，都会进行一次平衡操作
-        /// 第一次调用是在最底层插入节点后，然后逐层返回，每层都会进行平衡操作
-        /// 因此实际是一次从插入节点到根节点的自底向上的平衡过程
-        /// 造成的额外总代价是 O(log n)，因此插入操作的时间复杂度仍然是 O(log n)
-        balance( t );
-    }
+    static const int MAX_DEPTH = 64;
 
     /**
-     * Internal method to insert into a subtree.
-     * x is the item to insert.
-     * t is the node that roots the subtree.
-     * Set the new root of the subtree.
+     * Internal method to insert x into the tree, without recursion.
+     * Walk down to the empty link where x belongs, recording the links
+     * passed, hang a new node there, then rebalance along the path.
      */
-    void insert( Comparable && x, AvlNode * & t )
-    {
-        if( t == nullptr )
-            t = new AvlNode{ std::move( x ), nullptr, nullptr };
-        else if( x < t->element )
-            insert( std::move( x ), t->left );
-        else if( t->element < x )
-            insert( std::move( x ), t->right );
-        
-        balance( t );
+    template <typename Item>
+    void insertItem( Item && x )
+    {
+        /// 前面和普通的二叉搜索树插入一致，只是用循环代替递归
+        /// link 指向要修改的那个指针：root 或某个节点的 left / right
+        /// path 记下沿途经过的 link，相当于递归版本的调用栈
+        NodePtr *path[ MAX_DEPTH ];
+        int depth = 0;
+        NodePtr parent = nullptr;
+        NodePtr *link = &root;
+        while( *link != nullptr )
+        {
+            path[ depth++ ] = link;
+            parent = *link;
+            if( x < parent->element )
+                link = &parent->left;
+            else if( parent->element < x )
+                link = &parent->right;
+            else
+                return;    // Duplicate; nothing changes
+        }
+        *link = pool.create( std::forward<Item>( x ), nullptr, nullptr );
+        ( *link )->parent = parent;
+
+        /// 递归版本在每一层返回时调用一次 balance
+        /// 这里按 path 自底向上逐层 balance，是同一个过程
+        rebalancePath( path, depth );
     }
-     
+
     /**
-     * Internal method to remove from a subtree.
-     * x is the item to remove.
-     * t is the node that roots the subtree.
-     * Set the new root of the subtree.
+     * Internal method to remove x from the tree, without recursion.
+     * A node with two children takes the item of its successor,
+     * and the successor, which has no left child, is unlinked instead.
      */
-    void remove( const Comparable & x, AvlNode * & t )
+    void removeItem( const Comparable & x )
     {
-        if( t == nullptr )
-            return;   // Item not found; do nothing
-        
-        if( x < t->element )
-            remove( x, t->left );
-        else if( t->element < x )
-            remove( x, t->right );
-        else if( t->left != nullptr && t->right != nullptr ) // Two children
+        NodePtr *path[ MAX_DEPTH ];
+        int depth = 0;
+        NodePtr *link = &root;
+        while( *link != nullptr && ( x < ( *link )->element || ( *link )->element < x ) )
         {
-            t->element = findMin( t->right )->element;
-            remove( t->element, t->right );
+            path[ depth++ ] = link;
+            link = x < ( *link )->element ? &( *link )->left : &( *link )->right;
         }
-        else
+        if( *link == nullptr )
+            return;   // Item not found; do nothing
+
+        NodePtr t = *link;
+        if( t->left != nullptr && t->right != nullptr ) // Two children
         {
-            AvlNode *oldNode = t;
-            t = ( t->left != nullptr ) ? t->left : t->right;
-            delete oldNode;
+            path[ depth++ ] = link;
+            link = &t->right;
+            while( ( *link )->left != nullptr )
+            {
+                path[ depth++ ] = link;
+                link = &( *link )->left;
+            }
+            t->element = ( *link )->element;
         }
-        
-        balance( t );
+
+        NodePtr oldNode = *link;
+        NodePtr child = ( oldNode->left != nullptr ) ? oldNode->left : oldNode->right;
+        *link = child;
+        if( child != nullptr )
+            child->parent = oldNode->parent;
+        pool.destroy( oldNode );
+        rebalancePath( path, depth );
+    }
+
+    /**
+     * Balance the nodes that path[ 0 .. depth - 1 ] link to, bottom up.
+     * A rotation only rewrites the link to the node it balances,
+     * so the links above it stay valid.
+     */
+    void rebalancePath( NodePtr **path, int depth )
+    {
+        while( depth > 0 )
+            balance( *path[ --depth ] );
     }
     
     /// @brief AVL 树的允许不平衡量，这里 static 实际没有什么必要，可以去掉
     static const int ALLOWED_IMBALANCE = 1;
 
     // Assume t is balanced or within one of being balanced
-    void balance( AvlNode * & t )
+    void balance( NodePtr & t )
     {
         /// 如果是空节点，直接返回
         if( t == nullptr )
@@ -268,28 +600,29 @@ class AvlTree
             else
                 /// case III
                 doubleWithRightChild( t );
-        /// 更新节点高度        
+        /// 更新节点高度、子树大小和子节点的父指针
         t->height = max( height( t->left ), height( t->right ) ) + 1;
+        t->size = size( t->left ) + size( t->right ) + 1;
+        setParents( t );
     }
     
     /**
      * Internal method to find the smallest item in a subtree t.
      * Return node containing the smallest item.
      */
-    AvlNode * findMin( AvlNode *t ) const
+    NodePtr findMin( NodePtr t ) const
     {
-        if( t == nullptr )
-            return nullptr;
-        if( t->left == nullptr )
-            return t;
-        return findMin( t->left );
+        if( t != nullptr )
+            while( t->left != nullptr )
+                t = t->left;
+        return t;
     }
 
     /**
      * Internal method to find the largest item in a subtree t.
      * Return node containing the largest item.
      */
-    AvlNode * findMax( AvlNode *t ) const
+    NodePtr findMax( NodePtr t ) const
     {
         if( t != nullptr )
             while( t->right != nullptr )
@@ -303,7 +636,20 @@ class AvlTree
      * x is item to search for.
      * t is the node that roots the tree.
      */
-    bool contains( const Comparable & x, AvlNode *t ) const
+    bool contains( const Comparable & x, NodePtr t ) const
+    {
+        while( t != nullptr )
+            if( x < t->element )
+                t = t->left;
+            else if( t->element < x )
+                t = t->right;
+            else
+                return true;    // Match
+
+        return false;   // No match
+    }
+/****** RECURSIVE VERSION****************************
+    bool contains( const Comparable & x, NodePtr t ) const
     {
         if( t == nullptr )
             return false;
@@ -314,100 +660,260 @@ class AvlTree
         else
             return true;    // Match
     }
-/****** NONRECURSIVE VERSION*************************
-    bool contains( const Comparable & x, AvlNode *t ) const
+*****************************************************/
+
+    /**
+     * Internal method to make subtree empty.
+     */
+    void makeEmpty( NodePtr & t )
     {
+        /// 不用递归：有左孩子就右旋，把左子树转到右边；
+        /// 没有左孩子时删掉当前节点，走向右孩子。每个节点至多旋转一次
         while( t != nullptr )
-            if( x < t->element )
-                t = t->left;
-            else if( t->element < x )
-                t = t->right;
+            if( t->left != nullptr )
+            {
+                NodePtr leftChild = t->left;
+                t->left = leftChild->right;
+                leftChild->right = t;
+                t = leftChild;
+            }
             else
-                return true;    // Match
+            {
+                NodePtr rightChild = t->right;
+                pool.destroy( t );
+                t = rightChild;
+            }
+    }
 
-        return false;   // No match
+    /**
+     * Internal method to clone subtree, without recursion.
+     * Walk t in preorder through the parent links, keeping the copy
+     * in step; a child of the copy that is still missing marks the
+     * subtree not yet copied.
+     */
+    NodePtr clone( NodePtr t )
+    {
+        if( t == nullptr )
+            return nullptr;
+
+        NodePtr copy = pool.create( t->element, nullptr, nullptr, t->height, t->size );
+        NodePtr from = t;
+        NodePtr to = copy;
+        for( ; ; )
+            if( from->left != nullptr && to->left == nullptr )
+            {
+                from = from->left;
+                to->left = pool.create( from->element, nullptr, nullptr, from->height, from->size );
+                to->left->parent = to;
+                to = to->left;
+            }
+            else if( from->right != nullptr && to->right == nullptr )
+            {
+                from = from->right;
+                to->right = pool.create( from->element, nullptr, nullptr, from->height, from->size );
+                to->right->parent = to;
+                to = to->right;
+            }
+            else if( from == t )
+                return copy;
+            else
+            {
+                from = from->parent;
+                to = to->parent;
+            }
+    }
+        // Avl manipulations
+    /**
+     * Return the height of node t or -1 if nullptr.
+     */
+    int height( NodePtr t ) const
+    {
+        return t == nullptr ? -1 : t->height;
     }
-*****************************************************/
 
     /**
-     * Internal method to make subtree empty.
+     * Return the number of nodes in subtree t, or 0 if nullptr.
      */
-    void makeEmpty( AvlNode * & t )
+    int size( NodePtr t ) const
     {
-        if( t != nullptr )
+        return t == nullptr ? 0 : t->size;
+    }
+
+    int max( int lhs, int rhs ) const
+    {
+        return lhs > rhs ? lhs : rhs;
+    }
+
+    /**
+     * Point the parent links of t's children at t.
+     * A node's own parent link is set when its parent is fixed,
+     * or by setRootParent for the root.
+     */
+    static void setParents( NodePtr t )
+    {
+        if( t->left != nullptr )
+            t->left->parent = t;
+        if( t->right != nullptr )
+            t->right->parent = t;
+    }
+
+    void setRootParent( )
+    {
+        if( root != nullptr )
+            root->parent = nullptr;
+    }
+
+        // Bulk construction and join-based set operations
+    /**
+     * Internal method to build a perfectly balanced subtree from the
+     * strictly increasing range [ first, last ). The left half is built
+     * on another thread while more than one thread is available and the
+     * node pool allows it.
+     */
+    template <typename RandomIterator>
+    NodePtr buildSorted( RandomIterator first, RandomIterator last, int numThreads )
+    {
+        if( first == last )
+            return nullptr;
+
+        RandomIterator mid = first + ( last - first ) / 2;
+        NodePtr lt;
+        NodePtr rt;
+        if( numThreads > 1 && NodePool::CONCURRENT_CREATE )
+        {
+            auto left = async( launch::async, [ = ] {
+                return buildSorted( first, mid, numThreads / 2 ); } );
+            rt = buildSorted( mid + 1, last, numThreads - numThreads / 2 );
+            lt = left.get( );
+        }
+        else
         {
-            makeEmpty( t->left );
-            makeEmpty( t->right );
-            delete t;
+            lt = buildSorted( first, mid, 1 );
+            rt = buildSorted( mid + 1, last, 1 );
         }
-        t = nullptr;
+        NodePtr t = pool.create( *mid, lt, rt, max( height( lt ), height( rt ) ) + 1,
+                                 size( lt ) + size( rt ) + 1 );
+        setParents( t );
+        return t;
     }
 
     /**
-     * Internal method to print a subtree rooted at t in sorted order.
+     * Internal method to join AVL trees l and r, where every item of l
+     * is less than k->element and every item of r is greater, using
+     * node k as the glue. Runs in O( |height( l ) - height( r )| ) time.
+     * Return the root of the joined tree.
      */
-    void printTree( AvlNode *t ) const
+    NodePtr join( NodePtr l, NodePtr k, NodePtr r )
     {
-        if( t != nullptr )
+        if( height( l ) > height( r ) + ALLOWED_IMBALANCE )
         {
-            printTree( t->left );
-            cout << t->element << endl;
-            printTree( t->right );
+            l->right = join( l->right, k, r );
+            balance( l );
+            return l;
         }
+        if( height( r ) > height( l ) + ALLOWED_IMBALANCE )
+        {
+            r->left = join( l, k, r->left );
+            balance( r );
+            return r;
+        }
+        k->left = l;
+        k->right = r;
+        k->height = max( height( l ), height( r ) ) + 1;
+        k->size = size( l ) + size( r ) + 1;
+        setParents( k );
+        return k;
     }
 
     /**
-     * Internal method to clone subtree.
+     * Internal method to split subtree t around x into l, holding the
+     * items less than x, and r, holding the items greater than x.
+     * Return the node containing x, detached, or nullptr if x is absent.
      */
-    AvlNode * clone( AvlNode *t ) const
+    NodePtr split( NodePtr t, const Comparable & x, NodePtr & l, NodePtr & r )
     {
         if( t == nullptr )
+        {
+            l = r = nullptr;
             return nullptr;
+        }
+
+        NodePtr match;
+        if( x < t->element )
+        {
+            match = split( t->left, x, l, r );
+            r = join( r, t, t->right );
+        }
+        else if( t->element < x )
+        {
+            match = split( t->right, x, l, r );
+            l = join( t->left, t, l );
+        }
         else
-            return new AvlNode{ t->element, clone( t->left ), clone( t->right ), t->height };
+        {
+            l = t->left;
+            r = t->right;
+            match = t;
+        }
+        return match;
     }
-        // Avl manipulations
+
     /**
-     * Return the height of node t or -1 if nullptr.
+     * Internal method to form the union of subtrees t1 and t2,
+     * splitting t2 around the root of t1 and joining the unions of the halves.
+     * Nodes of t2 holding duplicates are deleted.
+     * Return the root of the union.
      */
-    int height( AvlNode *t ) const
+    NodePtr unionOf( NodePtr t1, NodePtr t2 )
     {
-        return t == nullptr ? -1 : t->height;
-    }
+        if( t1 == nullptr )
+            return t2;
+        if( t2 == nullptr )
+            return t1;
 
-    int max( int lhs, int rhs ) const
-    {
-        return lhs > rhs ? lhs : rhs;
+        NodePtr l2, r2;
+        pool.destroy( split( t2, t1->element, l2, r2 ) );
+        NodePtr lt = unionOf( t1->left, l2 );
+        NodePtr rt = unionOf( t1->right, r2 );
+        return join( lt, t1, rt );
     }
 
     /**
      * Rotate binary tree node with left child.
      * For AVL trees, this is a single rotation for case 1.
-     * Update heights, then set new root.
+     * Update heights and sizes, then set new root.
      */
-    void rotateWithLeftChild( AvlNode * & k2 )
+    void rotateWithLeftChild( NodePtr & k2 )
     {
-        AvlNode *k1 = k2->left;
+        NodePtr k1 = k2->left;
         k2->left = k1->right;
         k1->right = k2;
         // 需要额外更新高度
         k2->height = max( height( k2->left ), height( k2->right ) ) + 1;
         k1->height = max( height( k1->left ), k2->height ) + 1;
+        k2->size = size( k2->left ) + size( k2->right ) + 1;
+        k1->size = size( k1->left ) + k2->size + 1;
+        setParents( k2 );
+        setParents( k1 );
         k2 = k1;
     }
 
     /**
      * Rotate binary tree node with right child.
      * For AVL trees, this is a single rotation for case 4.
-     * Update heights, then set new root.
+     * Update heights and sizes, then set new root.
      */
-    void rotateWithRightChild( AvlNode * & k1 )
+    void rotateWithRightChild( NodePtr & k1 )
     {
-        AvlNode *k2 = k1->right;
+        NodePtr k2 = k1->right;
         k1->right = k2->left;
         k2->left = k1;
         k1->height = max( height( k1->left ), height( k1->right ) ) + 1;
         k2->height = max( height( k2->right ), k1->height ) + 1;
+        k1->size = size( k1->left ) + size( k1->right ) + 1;
+        k2->size = size( k2->right ) + k1->size + 1;
+        setParents( k1 );
+        setParents( k2 );
         k1 = k2;
     }
 
@@ -415,9 +921,9 @@ class AvlTree
      * Double rotate binary tree node: first left child.
      * with its right child; then node k3 with new left child.
      * For AVL trees, this is a double rotation for case 2.
-     * Update heights, then set new root.
+     * Update heights and sizes, then set new root.
      */
-    void doubleWithLeftChild( AvlNode * & k3 )
+    void doubleWithLeftChild( NodePtr & k3 )
     {
         rotateWithRightChild( k3->left );
         rotateWithLeftChild( k3 );
@@ -427,9 +933,9 @@ class AvlTree
      * Double rotate binary tree node: first right child.
      * with its left child; then node k1 with new right child.
      * For AVL trees, this is a double rotation for case 3.
-     * Update heights, then set new root.
+     * Update heights and sizes, then set new root.
      */
-    void doubleWithRightChild( AvlNode * & k1 )
+    void doubleWithRightChild( NodePtr & k1 )
     {
         rotateWithLeftChild( k1->right );
         rotateWithRightChild( k1 );
@@ -0,0 +1,718 @@
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include "dsexceptions.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <utility>
+using namespace std;
+
+// BPlusTree class
+//
+// CONSTRUCTION: zero parameter
+//
+// An ordered set stored in a B+-tree. Every node spans NODE_LINES
+// cache lines, so a node holds many keys and a search touches one
+// node per level instead of one key per level. All items live in the
+// leaves, which are doubly linked for in-order range scans.
+//
+// ******************PUBLIC OPERATIONS*********************
+// void insert( x )       --> Insert x
+// void remove( x )       --> Remove x
+// bool contains( x )     --> Return true if x is present
+// Comparable findMin( )  --> Return smallest item
+// Comparable findMax( )  --> Return largest item
+// boolean isEmpty( )     --> Return true if empty; else false
+// int size( )            --> Return number of items
+// void makeEmpty( )      --> Remove all items
+// void printTree( )      --> Print tree in sorted order
+// const_iterator begin( ), end( )
+//                        --> Bidirectional in-order iteration
+// const_iterator lower_bound( x )
+//                        --> First item not less than x
+// const_iterator upper_bound( x )
+//                        --> First item greater than x
+// pair equal_range( x )  --> Iterators bounding the items equal to x
+// pair range( lo, hi )   --> Iterators bounding the items in [ lo, hi ]
+// ******************ERRORS********************************
+// Throws UnderflowException as warranted
+// Throws IteratorOutOfBoundsException if an iterator moves
+//     beyond begin( ) or end( )
+
+template <typename Comparable, int NODE_LINES = 4>
+class BPlusTree
+{
+  private:
+    static const int CACHE_LINE = 64;
+    static const int NODE_BYTES = NODE_LINES * CACHE_LINE - 3 * sizeof( void * );
+
+  public:
+        // Items per leaf, and children per internal node
+    static const int LEAF_SIZE = max( 4, int( NODE_BYTES / sizeof( Comparable ) ) );
+    static const int ORDER = max( 4, int( NODE_BYTES / ( sizeof( Comparable ) + sizeof( void * ) ) ) );
+
+  private:
+    struct alignas( CACHE_LINE ) Node
+    {
+        bool isLeaf;
+        int  count;      // Number of keys
+
+        explicit Node( bool leaf ) : isLeaf{ leaf }, count{ 0 } { }
+    };
+
+    struct LeafNode : public Node
+    {
+        LeafNode  *prev;
+        LeafNode  *next;
+        Comparable keys[ LEAF_SIZE ];
+
+        LeafNode( ) : Node{ true }, prev{ nullptr }, next{ nullptr } { }
+    };
+
+        // keys[ i ] separates children[ i ] (all items less than keys[ i ])
+        // from children[ i + 1 ] (all items not less than keys[ i ])
+    struct InternalNode : public Node
+    {
+        Node      *children[ ORDER ];
+        Comparable keys[ ORDER - 1 ];
+
+        InternalNode( ) : Node{ false } { }
+    };
+
+  public:
+    class const_iterator
+    {
+      public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type        = Comparable;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const Comparable *;
+        using reference         = const Comparable &;
+
+        const_iterator( ) : tree{ nullptr }, leaf{ nullptr }, index{ 0 }
+          { }
+
+        const Comparable & operator* ( ) const
+          { return leaf->keys[ index ]; }
+
+        const Comparable * operator-> ( ) const
+          { return &leaf->keys[ index ]; }
+
+        const_iterator & operator++ ( )
+        {
+            if( leaf == nullptr )
+                throw IteratorOutOfBoundsException{ };
+            if( ++index == leaf->count )
+            {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++ ( int )
+        {
+            const_iterator old = *this;
+            ++( *this );
+            return old;
+        }
+
+        const_iterator & operator-- ( )
+        {
+            if( leaf == nullptr )
+            {
+                leaf = tree->lastLeaf( );
+                if( leaf == nullptr )
+                    throw IteratorOutOfBoundsException{ };
+                index = leaf->count;
+            }
+            else if( index == 0 )
+            {
+                if( leaf->prev == nullptr )
+                    throw IteratorOutOfBoundsException{ };
+                leaf = leaf->prev;
+                index = leaf->count;
+            }
+            --index;
+            return *this;
+        }
+
+        const_iterator operator-- ( int )
+        {
+            const_iterator old = *this;
+            --( *this );
+            return old;
+        }
+
+        bool operator== ( const const_iterator & rhs ) const
+          { return leaf == rhs.leaf && index == rhs.index; }
+
+        bool operator!= ( const const_iterator & rhs ) const
+          { return !( *this == rhs ); }
+
+      private:
+        const BPlusTree *tree;
+        const LeafNode  *leaf;    // nullptr for end( )
+        int              index;
+
+        const_iterator( const BPlusTree *t, const LeafNode *p, int i )
+          : tree{ t }, leaf{ p }, index{ i }
+        {
+            if( leaf != nullptr && index == leaf->count )
+            {
+                leaf = leaf->next;
+                index = 0;
+            }
+        }
+
+        friend class BPlusTree;
+    };
+
+    BPlusTree( ) : root{ nullptr }, theSize{ 0 }
+      { }
+
+    BPlusTree( const BPlusTree & rhs ) : root{ nullptr }, theSize{ rhs.theSize }
+    {
+        LeafNode *lastLeaf = nullptr;
+        root = clone( rhs.root, lastLeaf );
+    }
+
+    BPlusTree( BPlusTree && rhs ) : root{ rhs.root }, theSize{ rhs.theSize }
+    {
+        rhs.root = nullptr;
+        rhs.theSize = 0;
+    }
+
+    ~BPlusTree( )
+      { makeEmpty( ); }
+
+    /**
+     * Deep copy.
+     */
+    BPlusTree & operator=( const BPlusTree & rhs )
+    {
+        BPlusTree copy = rhs;
+        std::swap( *this, copy );
+        return *this;
+    }
+
+    /**
+     * Move.
+     */
+    BPlusTree & operator=( BPlusTree && rhs )
+    {
+        std::swap( root, rhs.root );
+        std::swap( theSize, rhs.theSize );
+
+        return *this;
+    }
+
+    const_iterator begin( ) const
+      { return const_iterator{ this, firstLeaf( ), 0 }; }
+
+    const_iterator end( ) const
+      { return const_iterator{ this, nullptr, 0 }; }
+
+    /**
+     * Return an iterator to the first item not less than x.
+     */
+    const_iterator lower_bound( const Comparable & x ) const
+    {
+        const LeafNode *p = findLeaf( x );
+        if( p == nullptr )
+            return end( );
+        return const_iterator{ this, p, int( std::lower_bound( p->keys, p->keys + p->count, x ) - p->keys ) };
+    }
+
+    /**
+     * Return an iterator to the first item greater than x.
+     */
+    const_iterator upper_bound( const Comparable & x ) const
+    {
+        const LeafNode *p = findLeaf( x );
+        if( p == nullptr )
+            return end( );
+        return const_iterator{ this, p, int( std::upper_bound( p->keys, p->keys + p->count, x ) - p->keys ) };
+    }
+
+    /**
+     * Return the iterators bounding the items equal to x,
+     * as lower_bound( x ) and upper_bound( x ).
+     */
+    pair<const_iterator, const_iterator> equal_range( const Comparable & x ) const
+    {
+        return { lower_bound( x ), upper_bound( x ) };
+    }
+
+    /**
+     * Return the iterators bounding the items in the closed range [ lo, hi ].
+     */
+    pair<const_iterator, const_iterator> range( const Comparable & lo,
+                                                const Comparable & hi ) const
+    {
+        return { lower_bound( lo ), upper_bound( hi ) };
+    }
+
+    /**
+     * Find the smallest item in the tree.
+     * Throw UnderflowException if empty.
+     */
+    const Comparable & findMin( ) const
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+        return firstLeaf( )->keys[ 0 ];
+    }
+
+    /**
+     * Find the largest item in the tree.
+     * Throw UnderflowException if empty.
+     */
+    const Comparable & findMax( ) const
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+        const LeafNode *p = lastLeaf( );
+        return p->keys[ p->count - 1 ];
+    }
+
+    /**
+     * Returns true if x is found in the tree.
+     */
+    bool contains( const Comparable & x ) const
+    {
+        const LeafNode *p = findLeaf( x );
+        if( p == nullptr )
+            return false;
+        const Comparable *itr = std::lower_bound( p->keys, p->keys + p->count, x );
+        return itr != p->keys + p->count && !( x < *itr );
+    }
+
+    /**
+     * Test if the tree is logically empty.
+     * Return true if empty, false otherwise.
+     */
+    bool isEmpty( ) const
+      { return root == nullptr; }
+
+    /**
+     * Return the number of items in the tree.
+     */
+    int size( ) const
+      { return theSize; }
+
+    /**
+     * Print the tree contents in sorted order.
+     */
+    void printTree( ostream & out = cout ) const
+    {
+        if( isEmpty( ) )
+            out << "Empty tree" << endl;
+        else
+            for( auto & x : *this )
+                out << x << endl;
+    }
+
+    /**
+     * Make the tree logically empty.
+     */
+    void makeEmpty( )
+    {
+        makeEmpty( root );
+        root = nullptr;
+        theSize = 0;
+    }
+
+    /**
+     * Insert x into the tree; duplicates are ignored.
+     */
+    void insert( const Comparable & x )
+    {
+        if( root == nullptr )
+            root = new LeafNode;
+
+        Node *newRight = nullptr;
+        Comparable separator;
+        if( !insert( x, root, newRight, separator ) )
+            return;
+        ++theSize;
+
+        if( newRight != nullptr )    // Root split; grow a level
+        {
+            InternalNode *newRoot = new InternalNode;
+            newRoot->count = 1;
+            newRoot->keys[ 0 ] = std::move( separator );
+            newRoot->children[ 0 ] = root;
+            newRoot->children[ 1 ] = newRight;
+            root = newRoot;
+        }
+    }
+
+    /**
+     * Remove x from the tree. Nothing is done if x is not found.
+     */
+    void remove( const Comparable & x )
+    {
+        if( root == nullptr || !remove( x, root ) )
+            return;
+        --theSize;
+
+        if( root->count == 0 )       // Shrink a level
+        {
+            if( root->isLeaf )
+            {
+                delete asLeaf( root );
+                root = nullptr;
+            }
+            else
+            {
+                InternalNode *oldRoot = asInternal( root );
+                root = oldRoot->children[ 0 ];
+                delete oldRoot;
+            }
+        }
+    }
+
+  private:
+    Node *root;
+    int   theSize;
+
+    static LeafNode * asLeaf( Node *t )
+      { return static_cast<LeafNode *>( t ); }
+
+    static InternalNode * asInternal( Node *t )
+      { return static_cast<InternalNode *>( t ); }
+
+    /**
+     * Return the index of the child of internal node t whose subtree may contain x.
+     */
+    static int childIndex( const InternalNode *t, const Comparable & x )
+    {
+        return std::upper_bound( t->keys, t->keys + t->count, x ) - t->keys;
+    }
+
+    /**
+     * Return the leaf whose key range contains x, or nullptr if empty.
+     */
+    const LeafNode * findLeaf( const Comparable & x ) const
+    {
+        const Node *t = root;
+        if( t == nullptr )
+            return nullptr;
+        while( !t->isLeaf )
+        {
+            const InternalNode *p = static_cast<const InternalNode *>( t );
+            t = p->children[ childIndex( p, x ) ];
+        }
+        return static_cast<const LeafNode *>( t );
+    }
+
+    const LeafNode * firstLeaf( ) const
+    {
+        const Node *t = root;
+        if( t == nullptr )
+            return nullptr;
+        while( !t->isLeaf )
+            t = static_cast<const InternalNode *>( t )->children[ 0 ];
+        return static_cast<const LeafNode *>( t );
+    }
+
+    const LeafNode * lastLeaf( ) const
+    {
+        const Node *t = root;
+        if( t == nullptr )
+            return nullptr;
+        while( !t->isLeaf )
+            t = static_cast<const InternalNode *>( t )->children[ t->count ];
+        return static_cast<const LeafNode *>( t );
+    }
+
+    /**
+     * Internal method to insert into a subtree.
+     * x is the item to insert.
+     * t is the node that roots the subtree.
+     * If t splits, newRight is set to the new right sibling
+     * and separator to the smallest item in it.
+     * Return false if x was already present.
+     */
+    bool insert( const Comparable & x, Node *t, Node * & newRight, Comparable & separator )
+    {
+        if( t->isLeaf )
+        {
+            LeafNode *p = asLeaf( t );
+            int pos = std::lower_bound( p->keys, p->keys + p->count, x ) - p->keys;
+            if( pos < p->count && !( x < p->keys[ pos ] ) )
+                return false;   // Duplicate; do nothing
+
+            if( p->count < LEAF_SIZE )
+            {
+                insertAt( p->keys, p->count, pos, x );
+                ++p->count;
+                return true;
+            }
+
+                // Split: the upper half moves to a new leaf
+            LeafNode *q = new LeafNode;
+            int half = ( LEAF_SIZE + 1 ) / 2;
+            move( p->keys + half, p->keys + LEAF_SIZE, q->keys );
+            q->count = LEAF_SIZE - half;
+            p->count = half;
+            if( pos <= half )
+            {
+                insertAt( p->keys, p->count, pos, x );
+                ++p->count;
+            }
+            else
+            {
+                insertAt( q->keys, q->count, pos - half, x );
+                ++q->count;
+            }
+
+            q->next = p->next;
+            q->prev = p;
+            if( p->next != nullptr )
+                p->next->prev = q;
+            p->next = q;
+
+            newRight = q;
+            separator = q->keys[ 0 ];
+            return true;
+        }
+
+        InternalNode *p = asInternal( t );
+        int i = childIndex( p, x );
+        Node *childRight = nullptr;
+        Comparable childSeparator;
+        if( !insert( x, p->children[ i ], childRight, childSeparator ) )
+            return false;
+        if( childRight == nullptr )
+            return true;
+
+        if( p->count < ORDER - 1 )
+        {
+            insertAt( p->keys, p->count, i, childSeparator );
+            insertAt( p->children, p->count + 1, i + 1, childRight );
+            ++p->count;
+            return true;
+        }
+
+            // Split: gather ORDER keys and ORDER + 1 children, keep the
+            // lower half, push the middle key up, move the rest right
+        Comparable keys[ ORDER ];
+        Node *children[ ORDER + 1 ];
+        move( p->keys, p->keys + p->count, keys );
+        copy( p->children, p->children + p->count + 1, children );
+        insertAt( keys, ORDER - 1, i, childSeparator );
+        insertAt( children, ORDER, i + 1, childRight );
+
+        int mid = ORDER / 2;
+        InternalNode *q = new InternalNode;
+        p->count = mid;
+        move( keys, keys + mid, p->keys );
+        copy( children, children + mid + 1, p->children );
+        q->count = ORDER - mid - 1;
+        move( keys + mid + 1, keys + ORDER, q->keys );
+        copy( children + mid + 1, children + ORDER + 1, q->children );
+
+        newRight = q;
+        separator = std::move( keys[ mid ] );
+        return true;
+    }
+
+    /**
+     * Internal method to remove from a subtree.
+     * x is the item to remove.
+     * t is the node that roots the subtree; it may be left underfull,
+     * which the caller repairs.
+     * Return false if x was not found.
+     */
+    bool remove( const Comparable & x, Node *t )
+    {
+        if( t->isLeaf )
+        {
+            LeafNode *p = asLeaf( t );
+            int pos = std::lower_bound( p->keys, p->keys + p->count, x ) - p->keys;
+            if( pos == p->count || x < p->keys[ pos ] )
+                return false;   // Item not found; do nothing
+            eraseAt( p->keys, p->count, pos );
+            --p->count;
+            return true;
+        }
+
+        InternalNode *p = asInternal( t );
+        int i = childIndex( p, x );
+        if( !remove( x, p->children[ i ] ) )
+            return false;
+
+        Node *child = p->children[ i ];
+        if( child->count < ( child->isLeaf ? LEAF_SIZE / 2 : ( ORDER - 1 ) / 2 ) )
+            repair( p, i );
+        return true;
+    }
+
+    /**
+     * Internal method to fix an underfull child i of internal node p,
+     * by borrowing from a sibling that can spare an item, or
+     * otherwise by merging with a sibling.
+     */
+    void repair( InternalNode *p, int i )
+    {
+        Node *child = p->children[ i ];
+        Node *left = i > 0 ? p->children[ i - 1 ] : nullptr;
+        Node *right = i < p->count ? p->children[ i + 1 ] : nullptr;
+        int minKeys = child->isLeaf ? LEAF_SIZE / 2 : ( ORDER - 1 ) / 2;
+
+        if( left != nullptr && left->count > minKeys )
+            borrowFromLeft( p, i );
+        else if( right != nullptr && right->count > minKeys )
+            borrowFromRight( p, i );
+        else if( left != nullptr )
+            mergeChildren( p, i - 1 );
+        else
+            mergeChildren( p, i );
+    }
+
+    void borrowFromLeft( InternalNode *p, int i )
+    {
+        if( p->children[ i ]->isLeaf )
+        {
+            LeafNode *c = asLeaf( p->children[ i ] );
+            LeafNode *l = asLeaf( p->children[ i - 1 ] );
+            insertAt( c->keys, c->count++, 0, l->keys[ --l->count ] );
+            p->keys[ i - 1 ] = c->keys[ 0 ];
+        }
+        else
+        {
+            InternalNode *c = asInternal( p->children[ i ] );
+            InternalNode *l = asInternal( p->children[ i - 1 ] );
+            insertAt( c->keys, c->count, 0, p->keys[ i - 1 ] );
+            insertAt( c->children, c->count + 1, 0, l->children[ l->count ] );
+            ++c->count;
+            p->keys[ i - 1 ] = std::move( l->keys[ --l->count ] );
+        }
+    }
+
+    void borrowFromRight( InternalNode *p, int i )
+    {
+        if( p->children[ i ]->isLeaf )
+        {
+            LeafNode *c = asLeaf( p->children[ i ] );
+            LeafNode *r = asLeaf( p->children[ i + 1 ] );
+            c->keys[ c->count++ ] = std::move( r->keys[ 0 ] );
+            eraseAt( r->keys, r->count--, 0 );
+            p->keys[ i ] = r->keys[ 0 ];
+        }
+        else
+        {
+            InternalNode *c = asInternal( p->children[ i ] );
+            InternalNode *r = asInternal( p->children[ i + 1 ] );
+            c->keys[ c->count ] = std::move( p->keys[ i ] );
+            c->children[ ++c->count ] = r->children[ 0 ];
+            p->keys[ i ] = std::move( r->keys[ 0 ] );
+            eraseAt( r->keys, r->count, 0 );
+            eraseAt( r->children, r->count + 1, 0 );
+            --r->count;
+        }
+    }
+
+    /**
+     * Merge child i + 1 of p into child i, and remove it from p.
+     */
+    void mergeChildren( InternalNode *p, int i )
+    {
+        if( p->children[ i ]->isLeaf )
+        {
+            LeafNode *c = asLeaf( p->children[ i ] );
+            LeafNode *r = asLeaf( p->children[ i + 1 ] );
+            move( r->keys, r->keys + r->count, c->keys + c->count );
+            c->count += r->count;
+            c->next = r->next;
+            if( r->next != nullptr )
+                r->next->prev = c;
+            delete r;
+        }
+        else
+        {
+            InternalNode *c = asInternal( p->children[ i ] );
+            InternalNode *r = asInternal( p->children[ i + 1 ] );
+            c->keys[ c->count ] = std::move( p->keys[ i ] );
+            move( r->keys, r->keys + r->count, c->keys + c->count + 1 );
+            copy( r->children, r->children + r->count + 1, c->children + c->count + 1 );
+            c->count += r->count + 1;
+            delete r;
+        }
+        eraseAt( p->keys, p->count, i );
+        eraseAt( p->children, p->count + 1, i + 1 );
+        --p->count;
+    }
+
+    /**
+     * Insert x at position pos of array a, which holds n items.
+     */
+    template <typename Object>
+    static void insertAt( Object a[ ], int n, int pos, Object x )
+    {
+        move_backward( a + pos, a + n, a + n + 1 );
+        a[ pos ] = std::move( x );
+    }
+
+    /**
+     * Remove the item at position pos of array a, which holds n items.
+     */
+    template <typename Object>
+    static void eraseAt( Object a[ ], int n, int pos )
+    {
+        move( a + pos + 1, a + n, a + pos );
+    }
+
+    /**
+     * Internal method to make subtree empty.
+     */
+    void makeEmpty( Node *t )
+    {
+        if( t == nullptr )
+            return;
+        if( t->isLeaf )
+            delete asLeaf( t );
+        else
+        {
+            InternalNode *p = asInternal( t );
+            for( int i = 0; i <= p->count; ++i )
+                makeEmpty( p->children[ i ] );
+            delete p;
+        }
+    }
+
+    /**
+     * Internal method to clone subtree.
+     * lastLeaf is the previously cloned leaf, used to link the leaves.
+     */
+    Node * clone( const Node *t, LeafNode * & lastLeaf ) const
+    {
+        if( t == nullptr )
+            return nullptr;
+        if( t->isLeaf )
+        {
+            const LeafNode *p = static_cast<const LeafNode *>( t );
+            LeafNode *q = new LeafNode;
+            q->count = p->count;
+            copy( p->keys, p->keys + p->count, q->keys );
+            q->prev = lastLeaf;
+            if( lastLeaf != nullptr )
+                lastLeaf->next = q;
+            lastLeaf = q;
+            return q;
+        }
+
+        const InternalNode *p = static_cast<const InternalNode *>( t );
+        InternalNode *q = new InternalNode;
+        q->count = p->count;
+        copy( p->keys, p->keys + p->count, q->keys );
+        for( int i = 0; i <= p->count; ++i )
+            q->children[ i ] = clone( p->children[ i ], lastLeaf );
+        return q;
+    }
+};
+
+#endif
@@ -0,0 +1,276 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include "AvlTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare AvlTree, whose contains, insert, remove, clone and makeEmpty
+// are loops, with RecursiveAvlTree below, which keeps the recursive
+// versions AvlTree had before (same node layout, heights, sizes and
+// parent links). N keys are inserted in random order and in sorted
+// order; the other operations run on the resulting trees.
+// Each run times one of the two trees, so that neither inherits
+// the heap the other left fragmented; run it once for each.
+//
+// Usage: BenchmarkAvlRecursion [ N [ recursive ] ]
+
+template <typename Comparable>
+class RecursiveAvlTree
+{
+  public:
+    RecursiveAvlTree( ) : root{ nullptr }
+      { }
+    RecursiveAvlTree( const RecursiveAvlTree & rhs ) : root{ clone( rhs.root ) }
+      { }
+    ~RecursiveAvlTree( )
+      { makeEmpty( root ); }
+
+    bool contains( const Comparable & x ) const
+      { return contains( x, root ); }
+    void insert( const Comparable & x )
+      { insert( x, root ); root->parent = nullptr; }
+    void remove( const Comparable & x )
+      { remove( x, root ); if( root != nullptr ) root->parent = nullptr; }
+    void makeEmpty( )
+      { makeEmpty( root ); }
+
+  private:
+    struct AvlNode
+    {
+        Comparable element;
+        AvlNode *left;
+        AvlNode *right;
+        AvlNode *parent;
+        int height;
+        int size;
+    };
+
+    AvlNode *root;
+
+    void insert( const Comparable & x, AvlNode * & t )
+    {
+        if( t == nullptr )
+            t = new AvlNode{ x, nullptr, nullptr, nullptr, 0, 1 };
+        else if( x < t->element )
+            insert( x, t->left );
+        else if( t->element < x )
+            insert( x, t->right );
+        balance( t );
+    }
+
+    void remove( const Comparable & x, AvlNode * & t )
+    {
+        if( t == nullptr )
+            return;
+        if( x < t->element )
+            remove( x, t->left );
+        else if( t->element < x )
+            remove( x, t->right );
+        else if( t->left != nullptr && t->right != nullptr )
+        {
+            t->element = findMin( t->right )->element;
+            remove( t->element, t->right );
+        }
+        else
+        {
+            AvlNode *oldNode = t;
+            t = ( t->left != nullptr ) ? t->left : t->right;
+            delete oldNode;
+        }
+        balance( t );
+    }
+
+    void balance( AvlNode * & t )
+    {
+        if( t == nullptr )
+            return;
+        if( height( t->left ) - height( t->right ) > 1 )
+        {
+            if( height( t->left->left ) >= height( t->left->right ) )
+                rotateWithLeftChild( t );
+            else
+            {
+                rotateWithRightChild( t->left );
+                rotateWithLeftChild( t );
+            }
+        }
+        else if( height( t->right ) - height( t->left ) > 1 )
+        {
+            if( height( t->right->right ) >= height( t->right->left ) )
+                rotateWithRightChild( t );
+            else
+            {
+                rotateWithLeftChild( t->right );
+                rotateWithRightChild( t );
+            }
+        }
+        update( t );
+    }
+
+    AvlNode * findMin( AvlNode *t ) const
+    {
+        if( t == nullptr )
+            return nullptr;
+        if( t->left == nullptr )
+            return t;
+        return findMin( t->left );
+    }
+
+    bool contains( const Comparable & x, AvlNode *t ) const
+    {
+        if( t == nullptr )
+            return false;
+        else if( x < t->element )
+            return contains( x, t->left );
+        else if( t->element < x )
+            return contains( x, t->right );
+        else
+            return true;
+    }
+
+    void makeEmpty( AvlNode * & t )
+    {
+        if( t != nullptr )
+        {
+            makeEmpty( t->left );
+            makeEmpty( t->right );
+            delete t;
+        }
+        t = nullptr;
+    }
+
+    AvlNode * clone( AvlNode *t ) const
+    {
+        if( t == nullptr )
+            return nullptr;
+        AvlNode *copy = new AvlNode{ t->element, clone( t->left ), clone( t->right ),
+                                     nullptr, t->height, t->size };
+        setParents( copy );
+        return copy;
+    }
+
+    static int height( AvlNode *t )
+      { return t == nullptr ? -1 : t->height; }
+    static int size( AvlNode *t )
+      { return t == nullptr ? 0 : t->size; }
+
+    static void setParents( AvlNode *t )
+    {
+        if( t->left != nullptr )
+            t->left->parent = t;
+        if( t->right != nullptr )
+            t->right->parent = t;
+    }
+
+    static void update( AvlNode *t )
+    {
+        t->height = max( height( t->left ), height( t->right ) ) + 1;
+        t->size = size( t->left ) + size( t->right ) + 1;
+        setParents( t );
+    }
+
+    static void rotateWithLeftChild( AvlNode * & k2 )
+    {
+        AvlNode *k1 = k2->left;
+        k2->left = k1->right;
+        k1->right = k2;
+        update( k2 );
+        update( k1 );
+        k2 = k1;
+    }
+
+    static void rotateWithRightChild( AvlNode * & k1 )
+    {
+        AvlNode *k2 = k1->right;
+        k1->right = k2->left;
+        k2->left = k1;
+        update( k1 );
+        update( k2 );
+        k1 = k2;
+    }
+};
+
+/**
+ * Time work( ), which returns a checksum, and print ns per item.
+ */
+void report( const string & test, const string & tree, long long n, function<long long( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    long long sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 18 ) << test << setw( 18 ) << tree << right
+         << setw( 10 ) << fixed << setprecision( 1 )
+         << chrono::duration<double, nano>( end - start ).count( ) / n
+         << " ns/item   " << sum << endl;
+}
+
+/**
+ * Run every operation on a Tree built from keys.
+ */
+template <typename Tree>
+void run( const string & input, const string & name, const vector<int> & keys,
+          const vector<int> & probes )
+{
+    long long n = keys.size( );
+    Tree t;
+    report( input + " insert", name, n, [ & ] {
+        for( int k : keys )
+            t.insert( k );
+        return 0LL; } );
+    report( "contains", name, probes.size( ), [ & ] {
+        long long hits = 0;
+        for( int p : probes )
+            hits += t.contains( p );
+        return hits; } );
+    Tree *copy = nullptr;
+    report( "clone", name, n, [ & ] {
+        copy = new Tree{ t };
+        return (long long) copy->contains( keys[ 0 ] ); } );
+    report( "remove", name, n / 2, [ & ] {
+        for( long long i = 0; i < n / 2; ++i )
+            t.remove( keys[ i ] );
+        return 0LL; } );
+    report( "makeEmpty", name, n, [ & ] {
+        copy->makeEmpty( );
+        t.makeEmpty( );
+        return 0LL; } );
+    delete copy;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    bool recursive = argc > 2 && string{ argv[ 2 ] } == "recursive";
+
+        // Even keys are present, odd keys are misses
+    UniformRandom r{ 8128 };
+    vector<int> sorted( n );
+    for( int i = 0; i < n; ++i )
+        sorted[ i ] = 2 * i;
+    vector<int> shuffled = sorted;
+    for( int i = n - 1; i > 0; --i )
+        swap( shuffled[ i ], shuffled[ r.nextInt( i + 1 ) ] );
+    vector<int> probes( n );
+    for( auto & p : probes )
+        p = r.nextInt( 2 * n );
+
+    cout << n << " keys" << endl;
+    if( recursive )
+    {
+        run<RecursiveAvlTree<int>>( "random", "recursive", shuffled, probes );
+        run<RecursiveAvlTree<int>>( "sorted", "recursive", sorted, probes );
+    }
+    else
+    {
+        run<AvlTree<int>>( "random", "AvlTree", shuffled, probes );
+        run<AvlTree<int>>( "sorted", "AvlTree", sorted, probes );
+    }
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <functional>
+#include <memory>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include "BinomialQueue.h"
+#include "ArrayBinomialQueue.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare BinomialQueue against ArrayBinomialQueue on
+//     insert-heavy   N inserts with a deleteMin after every 10th and a
+//                    findMin after each
+//     merge-tree     N/8 queues of 8 items melded pairwise into one, then drained
+//     merge-absorb   one queue absorbs N/8 queues of 8 items, with a
+//                    deleteMin after each merge
+// ArrayBinomialQueue is run with one arena per queue and with a single
+// shared arena, in which merge does not copy nodes.
+//
+// Usage: BenchmarkBinomialQueue [ N ]
+
+/**
+ * Time work( ), which returns a checksum, and print ns per item.
+ */
+void report( const string & trace, const string & queue, int n,
+             function<long long( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    long long sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 14 ) << trace << setw( 32 ) << queue << right
+         << setw( 10 ) << fixed << setprecision( 1 )
+         << chrono::duration<double, nano>( end - start ).count( ) / n
+         << " ns/item   " << sum << endl;
+}
+
+template <typename Queue>
+long long insertHeavy( const vector<int> & keys, function<Queue( )> make )
+{
+    Queue q = make( );
+    long long sum = 0;
+    int x;
+    for( size_t i = 0; i < keys.size( ); ++i )
+    {
+        q.insert( keys[ i ] );
+        if( i % 10 == 9 )
+        {
+            q.deleteMin( x );
+            sum += x;
+        }
+        sum += q.findMin( );
+    }
+    return sum;
+}
+
+template <typename Queue>
+long long mergeTree( const vector<int> & keys, function<Queue( )> make )
+{
+    const int SMALL = 8;
+    int numQueues = ( keys.size( ) + SMALL - 1 ) / SMALL;
+    vector<Queue> queues;
+    for( int i = 0; i < numQueues; ++i )
+        queues.push_back( make( ) );
+    for( size_t i = 0; i < keys.size( ); ++i )
+        queues[ i / SMALL ].insert( keys[ i ] );
+
+    for( int step = 1; step < numQueues; step *= 2 )
+        for( int i = 0; i + step < numQueues; i += 2 * step )
+            queues[ i ].merge( queues[ i + step ] );
+
+    long long sum = 0, i = 0;
+    int x;
+    while( !queues[ 0 ].isEmpty( ) )
+    {
+        queues[ 0 ].deleteMin( x );
+        sum += x * ( ++i % 7 );
+    }
+    return sum;
+}
+
+template <typename Queue>
+long long mergeAbsorb( const vector<int> & keys, function<Queue( )> make )
+{
+    const int SMALL = 8;
+    Queue main = make( );
+    long long sum = 0;
+    int x;
+    for( size_t start = 0; start < keys.size( ); start += SMALL )
+    {
+        Queue small = make( );
+        for( size_t j = start; j < start + SMALL && j < keys.size( ); ++j )
+            small.insert( keys[ j ] );
+        main.merge( small );
+        main.deleteMin( x );
+        sum += x;
+    }
+    return sum;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+
+    UniformRandom r{ 31415 };
+    vector<int> keys( n );
+    for( auto & k : keys )
+        k = r.nextInt( 0, 1 << 30 );
+
+    using Pointer = BinomialQueue<int>;
+    using Array = ArrayBinomialQueue<int>;
+    auto shared = make_shared<Array::Arena>( );
+
+    function<Pointer( )> makePointer = [ ] { return Pointer{ }; };
+    function<Array( )> makeArray = [ ] { return Array{ }; };
+    function<Array( )> makeShared = [ & ] { return Array{ shared }; };
+
+    report( "insert-heavy", "BinomialQueue", n,
+            [ & ] { return insertHeavy( keys, makePointer ); } );
+    report( "insert-heavy", "ArrayBinomialQueue", n,
+            [ & ] { return insertHeavy( keys, makeArray ); } );
+
+    report( "merge-tree", "BinomialQueue", n,
+            [ & ] { return mergeTree( keys, makePointer ); } );
+    report( "merge-tree", "ArrayBinomialQueue", n,
+            [ & ] { return mergeTree( keys, makeArray ); } );
+    report( "merge-tree", "ArrayBinomialQueue (shared)", n,
+            [ & ] { return mergeTree( keys, makeShared ); } );
+
+    report( "merge-absorb", "BinomialQueue", n,
+            [ & ] { return mergeAbsorb( keys, makePointer ); } );
+    report( "merge-absorb", "ArrayBinomialQueue", n,
+            [ & ] { return mergeAbsorb( keys, makeArray ); } );
+    report( "merge-absorb", "ArrayBinomialQueue (shared)", n,
+            [ & ] { return mergeAbsorb( keys, makeShared ); } );
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <climits>
+#include <cstdlib>
+#include <thread>
+#include "AvlTree.h"
+#include "RedBlackTree.h"
+using namespace std;
+
+// Compare, for AvlTree and RedBlackTree,
+//     building from N sorted keys by repeated insert, by the linear-time
+//     bulk constructor, and by the bulk constructor on all hardware threads;
+//     merging a tree of M keys into a tree of N keys by repeated insert
+//     and by unionWith, for several M.
+//
+// Usage: BenchmarkBulkBuild [ N ]
+
+/**
+ * Time work( ) and print the elapsed milliseconds.
+ */
+void report( const string & test, const string & tree, function<void( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 30 ) << test << setw( 14 ) << tree << right
+         << setw( 10 ) << fixed << setprecision( 1 )
+         << chrono::duration<double, milli>( end - start ).count( ) << " ms" << endl;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 4000000;
+    int numThreads = max( 1u, thread::hardware_concurrency( ) );
+
+    vector<int> keys( n );
+    for( int i = 0; i < n; ++i )
+        keys[ i ] = 2 * i;
+
+    cout << n << " sorted keys, " << numThreads << " hardware threads" << endl;
+
+    report( "build: repeated insert", "AvlTree", [ & ] {
+        AvlTree<int> t;
+        for( int k : keys )
+            t.insert( k ); } );
+    report( "build: bulk", "AvlTree", [ & ] {
+        AvlTree<int> t{ keys.begin( ), keys.end( ) }; } );
+    report( "build: bulk, all threads", "AvlTree", [ & ] {
+        AvlTree<int> t{ keys.begin( ), keys.end( ), numThreads }; } );
+
+    report( "build: repeated insert", "RedBlackTree", [ & ] {
+        RedBlackTree<int> t{ INT_MIN };
+        for( int k : keys )
+            t.insert( k ); } );
+    report( "build: bulk", "RedBlackTree", [ & ] {
+        RedBlackTree<int> t{ INT_MIN, keys.begin( ), keys.end( ) }; } );
+    report( "build: bulk, all threads", "RedBlackTree", [ & ] {
+        RedBlackTree<int> t{ INT_MIN, keys.begin( ), keys.end( ), numThreads }; } );
+
+        // Merge M odd keys, spread over the range, into the N even keys
+    for( int m = n; m >= n / 10000 && m > 0; m /= 100 )
+    {
+        vector<int> others;
+        for( long long i = 0; i < m; ++i )
+            others.push_back( 2 * ( i * n / m ) + 1 );
+        string label = "merge M = " + to_string( m );
+
+        AvlTree<int> a1{ keys.begin( ), keys.end( ) };
+        AvlTree<int> a2{ others.begin( ), others.end( ) };
+        report( label + ": insert", "AvlTree", [ & ] {
+            for( int k : others )
+                a1.insert( k ); } );
+        AvlTree<int> a3{ keys.begin( ), keys.end( ) };
+        report( label + ": unionWith", "AvlTree", [ & ] {
+            a3.unionWith( a2 ); } );
+
+        RedBlackTree<int> r1{ INT_MIN, keys.begin( ), keys.end( ) };
+        RedBlackTree<int> r2{ INT_MIN, others.begin( ), others.end( ) };
+        report( label + ": insert", "RedBlackTree", [ & ] {
+            for( int k : others )
+                r1.insert( k ); } );
+        RedBlackTree<int> r3{ INT_MIN, keys.begin( ), keys.end( ) };
+        report( label + ": unionWith", "RedBlackTree", [ & ] {
+            r3.unionWith( r2 ); } );
+    }
+
+    return 0;
+}
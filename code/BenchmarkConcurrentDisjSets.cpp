@@ -0,0 +1,101 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <cmath>
+#include <cstdlib>
+#include "ConcurrentDisjSets.h"
+#include "DisjSets.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Connected components of M edges on N vertices, with the sequential
+// DisjSets and with ConcurrentDisjSets on 1, 2, 4, ... threads up to
+// the hardware concurrency (or T). The graphs are
+//     random      endpoints uniformly random
+//     power-law   endpoints drawn with density proportional to
+//                 rank^(-2/3), so a few vertices have huge degree
+//                 (vertex numbers are shuffled)
+// Printed are the ms for the unions and for labeling the components.
+//
+//     g++ -std=c++17 -O2 -flto -pthread BenchmarkConcurrentDisjSets.cpp ConcurrentDisjSets.cpp DisjSets.cpp
+//
+// Usage: BenchmarkConcurrentDisjSets [ N [ M [ T ] ] ]
+
+using Edge = pair<int, int>;
+
+/**
+ * Time work( ), which returns a checksum, and print ms and the checksum.
+ */
+double report( const string & name, function<long long( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    long long sum = work( );
+    double ms = chrono::duration<double, milli>( chrono::steady_clock::now( ) - start ).count( );
+
+    cout << left << setw( 32 ) << name << right << setw( 10 ) << fixed << setprecision( 1 )
+         << ms << " ms   " << sum << endl;
+    return ms;
+}
+
+void runAll( const string & graph, int n, const vector<Edge> & edges, int maxThreads )
+{
+    cout << graph << endl;
+    long long expected = 0;
+    {
+        DisjSets ds{ n };
+        report( "  DisjSets unite", [ & ] {
+            for( const Edge & e : edges )
+                expected += ds.unite( e.first, e.second );
+            return expected; } );
+        report( "  DisjSets components", [ & ] {
+            vector<int> labels( n );
+            for( int x = 0; x < n; ++x )
+                labels[ x ] = ds.find( x );
+            return (long long) ds.numSets( ); } );
+    }
+
+    for( int threads = 1; threads <= maxThreads; threads *= 2 )
+    {
+        ConcurrentDisjSets cds{ n };
+        vector<int> labels;
+        report( "  parallelUnite, " + to_string( threads ) + " thr", [ & ] {
+            long long merges = cds.parallelUnite( edges.data( ), edges.size( ), threads );
+            if( merges != expected )
+                cout << "Merge count disagrees!" << endl;
+            return merges; } );
+        report( "  components, " + to_string( threads ) + " thr", [ & ] {
+            return (long long) cds.components( labels, threads ); } );
+    }
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1 << 22;
+    long long m = argc > 2 ? atoll( argv[ 2 ] ) : 4LL * n;
+    int maxThreads = argc > 3 ? atoi( argv[ 3 ] ) : max( 1u, thread::hardware_concurrency( ) );
+
+    UniformRandom r{ 16180 };
+    vector<Edge> edges( m );
+    cout << n << " vertices, " << m << " edges, up to " << maxThreads << " threads" << endl;
+
+    for( Edge & e : edges )
+        e = { r.nextInt( n ), r.nextInt( n ) };
+    runAll( "random", n, edges, maxThreads );
+
+    vector<int> shuffled( n );
+    for( int i = 0; i < n; ++i )
+        shuffled[ i ] = i;
+    for( int i = n - 1; i > 0; --i )
+        swap( shuffled[ i ], shuffled[ r.nextInt( i + 1 ) ] );
+    auto powerLaw = [ & ] { return shuffled[ min( n - 1, int( n * pow( r.nextDouble( ), 3 ) ) ) ]; };
+    for( Edge & e : edges )
+        e = { powerLaw( ), powerLaw( ) };
+    runAll( "power-law", n, edges, maxThreads );
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <cstdlib>
+#include "ConcurrentSkipList.h"
+#include "AvlTree.h"
+#include "SplayTree.h"
+#include "Treap.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare the throughput of a mixed workload on a set of int keys
+// drawn from [ 0, N ), started half full, as the number of threads
+// grows from 1 to T. Each operation is an insert or a remove
+// (U% of the operations, half each) or else a contains, of a random key.
+//     ConcurrentSkipList     used by all threads directly
+//     AvlTree, SplayTree,    behind one mutex
+//     Treap
+// RedBlackTree is left out, since it has no remove.
+// Each run lasts D ms. Printed are millions of operations per second.
+//
+// Usage: BenchmarkConcurrentSets [ N [ T [ D [ U ] ] ] ]     (compile with -pthread)
+
+/**
+ * A sequential set behind a mutex.
+ */
+template <typename Tree>
+class Locked
+{
+  public:
+    bool contains( int x )
+    {
+        lock_guard<mutex> guard{ lock };
+        return t.contains( x );
+    }
+
+    void insert( int x )
+    {
+        lock_guard<mutex> guard{ lock };
+        t.insert( x );
+    }
+
+    void remove( int x )
+    {
+        lock_guard<mutex> guard{ lock };
+        t.remove( x );
+    }
+
+  private:
+    Tree t;
+    mutex lock;
+};
+
+static atomic<long long> totalHits{ 0 };     // Keeps the lookups from being optimized away
+
+/**
+ * Fill s with n / 2 random keys, then run the workload on each
+ * thread count and print the throughputs on one line.
+ */
+template <typename Set>
+void run( const string & name, Set & s, int n, const vector<int> & threadCounts,
+          int ms, int updatePercent )
+{
+    UniformRandom r{ 99 };
+    for( int i = 0; i < n / 2; ++i )
+        s.insert( r.nextInt( n ) );
+
+    cout << left << setw( 22 ) << name << right << fixed << setprecision( 2 );
+    for( int numThreads : threadCounts )
+    {
+        atomic<bool> stop{ false };
+        vector<long long> ops( numThreads );
+        vector<thread> threads;
+        for( int id = 0; id < numThreads; ++id )
+            threads.emplace_back( [ &, id ] {
+                UniformRandom g{ 1000 + id };
+                long long count = 0, hits = 0;
+                for( ; !stop; ++count )
+                {
+                    int op = g.nextInt( 200 );
+                    int x = g.nextInt( n );
+                    if( op < updatePercent )
+                        s.insert( x );
+                    else if( op < 2 * updatePercent )
+                        s.remove( x );
+                    else
+                        hits += s.contains( x );
+                }
+                ops[ id ] = count;
+                totalHits += hits;
+            } );
+
+        auto start = chrono::steady_clock::now( );
+        this_thread::sleep_for( chrono::milliseconds( ms ) );
+        stop = true;
+        for( auto & t : threads )
+            t.join( );
+        double us = chrono::duration<double, micro>( chrono::steady_clock::now( ) - start ).count( );
+
+        long long total = 0;
+        for( long long c : ops )
+            total += c;
+        cout << setw( 10 ) << total / us;
+    }
+    cout << endl;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    int maxThreads = argc > 2 ? atoi( argv[ 2 ] ) : max( 1u, thread::hardware_concurrency( ) );
+    int ms = argc > 3 ? atoi( argv[ 3 ] ) : 500;
+    int updatePercent = argc > 4 ? atoi( argv[ 4 ] ) : 20;
+
+    vector<int> threadCounts;
+    for( int t = 1; t < maxThreads; t *= 2 )
+        threadCounts.push_back( t );
+    threadCounts.push_back( maxThreads );
+
+    cout << "Keys from [ 0, " << n << " ), " << updatePercent << "% updates, "
+         << ms << " ms per run; Mops/s by threads" << endl;
+    cout << left << setw( 22 ) << "set" << right;
+    for( int t : threadCounts )
+        cout << setw( 10 ) << t;
+    cout << endl;
+
+    {
+        ConcurrentSkipList<int> s{ 4321 };
+        run( "ConcurrentSkipList", s, n, threadCounts, ms, updatePercent );
+    }
+    {
+        Locked<AvlTree<int>> s;
+        run( "AvlTree + mutex", s, n, threadCounts, ms, updatePercent );
+    }
+    {
+        Locked<SplayTree<int>> s;
+        run( "SplayTree + mutex", s, n, threadCounts, ms, updatePercent );
+    }
+    {
+        Locked<Treap<int>> s;
+        run( "Treap + mutex", s, n, threadCounts, ms, updatePercent );
+    }
+    cout << totalHits << " hits" << endl;
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <utility>
+#include <chrono>
+#include <cstdlib>
+#include "BinaryHeap.h"
+#include "LeftistHeap.h"
+#include "BinomialQueue.h"
+#include "PairingHeap.h"
+#include "RadixHeap.h"
+#include "BucketQueue.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Benchmark Dijkstra's algorithm on a large random graph with
+// every priority queue in this directory.
+//
+// Usage: BenchmarkDijkstra [ numVertices [ avgDegree [ maxWeight ] ] ]
+
+using Distance = unsigned int;
+using Entry = pair<Distance, int>;    // ( tentative distance, vertex )
+
+const Distance INFINITY_DIST = ~0U;
+
+/**
+ * Directed graph in compressed adjacency (CSR) form.
+ */
+struct Graph
+{
+    vector<int>      first;     // Edges of v are [ first[ v ], first[ v + 1 ] )
+    vector<int>      target;
+    vector<Distance> weight;
+
+    int numVertices( ) const
+      { return first.size( ) - 1; }
+};
+
+/**
+ * Build a random graph with numVertices vertices, numVertices * avgDegree
+ * edges and weights uniform in [ 1, maxWeight ]. A Hamiltonian cycle
+ * is included so that every vertex is reachable from vertex 0.
+ */
+Graph randomGraph( int numVertices, int avgDegree, int maxWeight, UniformRandom & r )
+{
+    vector<vector<pair<int, Distance>>> adj( numVertices );
+    for( int v = 0; v < numVertices; ++v )
+        adj[ v ].push_back( { ( v + 1 ) % numVertices, r.nextInt( 1, maxWeight ) } );
+    for( long long e = numVertices; e < (long long) numVertices * avgDegree; ++e )
+        adj[ r.nextInt( numVertices ) ].push_back(
+            { r.nextInt( numVertices ), r.nextInt( 1, maxWeight ) } );
+
+    Graph g;
+    g.first.push_back( 0 );
+    for( auto & edges : adj )
+    {
+        for( auto & e : edges )
+        {
+            g.target.push_back( e.first );
+            g.weight.push_back( e.second );
+        }
+        g.first.push_back( g.target.size( ) );
+    }
+    return g;
+}
+
+/**
+ * Dijkstra's algorithm with lazy deletion: stale queue entries are
+ * skipped instead of using decreaseKey, so only insert, deleteMin
+ * and isEmpty are needed from PriorityQueue.
+ */
+template <typename PriorityQueue>
+vector<Distance> dijkstra( const Graph & g, int source, PriorityQueue & pq )
+{
+    vector<Distance> dist( g.numVertices( ), INFINITY_DIST );
+    dist[ source ] = 0;
+    pq.insert( Entry{ 0, source } );
+
+    while( !pq.isEmpty( ) )
+    {
+        Entry e;
+        pq.deleteMin( e );
+        int v = e.second;
+        if( e.first != dist[ v ] )
+            continue;
+        for( int i = g.first[ v ]; i < g.first[ v + 1 ]; ++i )
+        {
+            int w = g.target[ i ];
+            Distance d = e.first + g.weight[ i ];
+            if( d < dist[ w ] )
+            {
+                dist[ w ] = d;
+                pq.insert( Entry{ d, w } );
+            }
+        }
+    }
+    return dist;
+}
+
+/**
+ * Dijkstra's algorithm with PairingHeap::decreaseKey;
+ * each vertex is in the heap at most once.
+ */
+vector<Distance> dijkstraDecreaseKey( const Graph & g, int source )
+{
+    PairingHeap<Entry> pq;
+    vector<PairingHeap<Entry>::Position> pos( g.numVertices( ), nullptr );
+    vector<Distance> dist( g.numVertices( ), INFINITY_DIST );
+    vector<bool> done( g.numVertices( ), false );
+    dist[ source ] = 0;
+    pos[ source ] = pq.insert( Entry{ 0, source } );
+
+    while( !pq.isEmpty( ) )
+    {
+        Entry e;
+        pq.deleteMin( e );
+        int v = e.second;
+        done[ v ] = true;
+        for( int i = g.first[ v ]; i < g.first[ v + 1 ]; ++i )
+        {
+            int w = g.target[ i ];
+            Distance d = e.first + g.weight[ i ];
+            if( !done[ w ] && d < dist[ w ] )
+            {
+                if( dist[ w ] == INFINITY_DIST )
+                    pos[ w ] = pq.insert( Entry{ d, w } );
+                else
+                    pq.decreaseKey( pos[ w ], Entry{ d, w } );
+                dist[ w ] = d;
+            }
+        }
+    }
+    return dist;
+}
+
+/**
+ * std::priority_queue with the insert/deleteMin/isEmpty interface.
+ */
+struct StdPriorityQueue
+{
+    priority_queue<Entry, vector<Entry>, greater<Entry>> pq;
+
+    void insert( const Entry & x )
+      { pq.push( x ); }
+    void deleteMin( Entry & minItem )
+      { minItem = pq.top( ); pq.pop( ); }
+    bool isEmpty( ) const
+      { return pq.empty( ); }
+};
+
+/**
+ * Time one run of shortest paths and compare against the reference.
+ */
+void report( const string & name, function<vector<Distance>( )> run,
+             const vector<Distance> & reference )
+{
+    auto start = chrono::steady_clock::now( );
+    vector<Distance> dist = run( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << name << "\t"
+         << chrono::duration<double, milli>( end - start ).count( ) << " ms";
+    if( !reference.empty( ) && dist != reference )
+        cout << "\tOops! distances differ";
+    cout << endl;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int numVertices = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    int avgDegree = argc > 2 ? atoi( argv[ 2 ] ) : 8;
+    int maxWeight = argc > 3 ? atoi( argv[ 3 ] ) : 1000;
+
+    UniformRandom r{ 12345 };
+    Graph g = randomGraph( numVertices, avgDegree, maxWeight, r );
+    cout << "Dijkstra on " << numVertices << " vertices, "
+         << g.target.size( ) << " edges, weights in [1, " << maxWeight << "]" << endl;
+
+    BinaryHeap<Entry> binaryHeap;
+    vector<Distance> reference = dijkstra( g, 0, binaryHeap );
+
+    report( "BinaryHeap", [ & ] { BinaryHeap<Entry> pq;
+                                  return dijkstra( g, 0, pq ); }, reference );
+    report( "std::priority_queue", [ & ] { StdPriorityQueue pq;
+                                  return dijkstra( g, 0, pq ); }, reference );
+    report( "LeftistHeap", [ & ] { LeftistHeap<Entry> pq;
+                                  return dijkstra( g, 0, pq ); }, reference );
+    report( "BinomialQueue", [ & ] { BinomialQueue<Entry> pq;
+                                  return dijkstra( g, 0, pq ); }, reference );
+    report( "PairingHeap", [ & ] { PairingHeap<Entry> pq;
+                                  return dijkstra( g, 0, pq ); }, reference );
+    report( "PairingHeap+decreaseKey", [ & ] { return dijkstraDecreaseKey( g, 0 ); },
+            reference );
+    report( "RadixHeap", [ & ] { RadixHeap<Entry> pq;
+                                  return dijkstra( g, 0, pq ); }, reference );
+    report( "BucketQueue", [ & ] { BucketQueue<Entry> pq{ (Distance) maxWeight };
+                                  return dijkstra( g, 0, pq ); }, reference );
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include "DisjSets.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// TestFastDisjSets.cpp scaled up: DisjSets (union by size, iterative
+// path halving, unite) against the previous DisjSets (union by height,
+// recursive finds) using each of its finds:
+//     no compression   the const find
+//     compression      the recursive path-compressing find
+// on N elements and
+//     doubling         the unions of TestFastDisjSets, until one set
+//     random           M random edges, as a connected-components pass
+//     queries          N random same-set tests after the random edges
+// Link-time optimization lets DisjSets.cpp inline into the loops here,
+// as the RecursiveDisjSets class defined below does:
+//     g++ -std=c++17 -O2 -flto BenchmarkDisjSets.cpp DisjSets.cpp
+//
+// Usage: BenchmarkDisjSets [ N [ M ] ]
+
+/**
+ * The previous DisjSets: union by height and recursive finds.
+ */
+class RecursiveDisjSets
+{
+  public:
+    explicit RecursiveDisjSets( int numElements ) : s( numElements, -1 )
+      { }
+
+    void unionSets( int root1, int root2 )
+    {
+        if( s[ root2 ] < s[ root1 ] )
+            s[ root1 ] = root2;
+        else
+        {
+            if( s[ root1 ] == s[ root2 ] )
+                --s[ root1 ];
+            s[ root2 ] = root1;
+        }
+    }
+
+    int findNoCompression( int x ) const
+    {
+        if( s[ x ] < 0 )
+            return x;
+        else
+            return findNoCompression( s[ x ] );
+    }
+
+    int find( int x )
+    {
+        if( s[ x ] < 0 )
+            return x;
+        else
+            return s[ x ] = find( s[ x ] );
+    }
+
+  private:
+    vector<int> s;
+};
+
+/**
+ * Time work( ), which returns a checksum, and print ms and the checksum.
+ */
+void report( const string & name, function<long long( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    long long sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 34 ) << name << right << setw( 10 ) << fixed << setprecision( 1 )
+         << chrono::duration<double, milli>( end - start ).count( ) << " ms   " << sum << endl;
+}
+
+/**
+ * Run all workloads with one find strategy: find( ds, x ) and
+ * merge( ds, x, y ), which returns true if x and y were in different sets.
+ */
+template <typename Sets, typename Find, typename Merge>
+void runAll( const string & name, int n, const vector<int> & edges, const vector<int> & queries,
+             Find find, Merge merge )
+{
+    {
+        Sets ds{ n };
+        report( "doubling  " + name, [ & ] {
+            long long merges = 0;
+            for( int k = 1; k < n; k *= 2 )
+                for( int j = 0; j + k < n; j += 2 * k )
+                    merges += merge( ds, j, j + k );
+            return merges; } );
+    }
+
+    Sets ds{ n };
+    report( "random    " + name, [ & ] {
+        long long merges = 0;
+        for( size_t e = 0; e < edges.size( ); e += 2 )
+            merges += merge( ds, edges[ e ], edges[ e + 1 ] );
+        return merges; } );
+    report( "queries   " + name, [ & ] {
+        long long same = 0;
+        for( int i = 0; i < n; ++i )
+            same += find( ds, queries[ 2 * i ] ) == find( ds, queries[ 2 * i + 1 ] );
+        return same; } );
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1 << 24;
+    long long m = argc > 2 ? atoll( argv[ 2 ] ) : n;
+
+    UniformRandom r{ 1729 };
+    vector<int> edges( 2 * m ), queries( 2 * n );
+    for( int & x : edges )
+        x = r.nextInt( n );
+    for( int & x : queries )
+        x = r.nextInt( n );
+
+    cout << n << " elements, " << m << " random edges" << endl;
+    runAll<RecursiveDisjSets>( "no compression", n, edges, queries,
+        []( RecursiveDisjSets & ds, int x ) { return ds.findNoCompression( x ); },
+        []( RecursiveDisjSets & ds, int x, int y )
+        {
+            int root1 = ds.findNoCompression( x ), root2 = ds.findNoCompression( y );
+            if( root1 != root2 )
+                ds.unionSets( root1, root2 );
+            return root1 != root2;
+        } );
+    runAll<RecursiveDisjSets>( "compression", n, edges, queries,
+        []( RecursiveDisjSets & ds, int x ) { return ds.find( x ); },
+        []( RecursiveDisjSets & ds, int x, int y )
+        {
+            int root1 = ds.find( x ), root2 = ds.find( y );
+            if( root1 != root2 )
+                ds.unionSets( root1, root2 );
+            return root1 != root2;
+        } );
+    runAll<DisjSets>( "halving, unite", n, edges, queries,
+        []( DisjSets & ds, int x ) { return ds.find( x ); },
+        []( DisjSets & ds, int x, int y ) { return ds.unite( x, y ); } );
+
+    return 0;
+}
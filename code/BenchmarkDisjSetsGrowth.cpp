@@ -0,0 +1,99 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include "DisjSets.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Growth and checkpointing of DisjSets with N elements:
+//     construct    DisjSets{ N }, the fixed universe
+//     makeSet      N makeSets from empty
+//     streaming    N makeSets, each new element united with a random
+//                  earlier one half the time, as IDs arrive in a
+//                  deduplication job
+//     compact      dense relabeling after streaming
+//     save, load   a checkpoint of the streamed sets to FILE and back
+//                  (load reads from the page cache if FILE is still
+//                  there; the file is deleted at the end)
+// N = 2^30 needs about 9 GB: the array doubles as it grows, so 4 GB
+// and 8 GB exist together for a moment.
+//
+// Usage: BenchmarkDisjSetsGrowth [ N [ FILE ] ]
+
+/**
+ * Time work( ), which returns a checksum; print ms, and MB/s for
+ * bytes moved if nonzero.
+ */
+void report( const string & name, double bytes, function<long long( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    long long sum = work( );
+    double seconds = chrono::duration<double>( chrono::steady_clock::now( ) - start ).count( );
+
+    cout << left << setw( 12 ) << name << right << setw( 10 ) << fixed << setprecision( 1 )
+         << seconds * 1000 << " ms";
+    if( bytes > 0 )
+        cout << setw( 10 ) << bytes / seconds / 1e6 << " MB/s";
+    else
+        cout << setw( 15 ) << "";
+    cout << "   " << sum << endl;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1 << 27;
+    string filename = argc > 2 ? argv[ 2 ] : "BenchmarkDisjSetsGrowth.bin";
+    double bytes = 24 + 4.0 * n;
+
+    cout << n << " elements, checkpoint of " << fixed << setprecision( 1 ) << bytes / 1e6 << " MB" << endl;
+    {
+        report( "construct", 0, [ & ] { DisjSets ds{ n }; return (long long) ds.numSets( ); } );
+        report( "makeSet", 0, [ & ] {
+            DisjSets ds;
+            for( int i = 0; i < n; ++i )
+                ds.makeSet( );
+            return (long long) ds.numSets( ); } );
+    }
+
+    UniformRandom r{ 99991 };
+    DisjSets ds;
+    report( "streaming", 0, [ & ] {
+        for( int i = 0; i < n; ++i )
+        {
+            int x = ds.makeSet( );
+            if( x > 0 && r.nextInt( 2 ) == 0 )
+                ds.unite( x, r.nextInt( x ) );
+        }
+        return (long long) ds.numSets( ); } );
+
+    {
+        vector<int> labels;
+        report( "compact", 0, [ & ] { return (long long) ds.compact( labels ); } );
+    }
+
+    report( "save", bytes, [ & ] {
+        if( !ds.save( filename ) )
+            cout << "Save failed!" << endl;
+        return (long long) ds.size( ); } );
+    {
+        DisjSets restored;
+        report( "load", bytes, [ & ] {
+            if( !restored.load( filename ) )
+                cout << "Load failed!" << endl;
+            return (long long) restored.numSets( ); } );
+        for( int i = 0; i < 1000; ++i )
+        {
+            int x = r.nextInt( n );
+            if( restored.find( x ) != ds.find( x ) )
+                cout << "Restored sets differ!" << endl;
+        }
+    }
+    remove( filename.c_str( ) );
+
+    return 0;
+}
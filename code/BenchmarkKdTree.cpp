@@ -0,0 +1,185 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include "KdTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare the bulk-built KdTree of KdTree.h with PointerKdTree below,
+// the insert-built two-dimensional tree of KdTree.cpp (counting
+// instead of printing), on N points in [ 0, 10^6 )^2 that are
+//     uniform     uniformly random
+//     clustered   in C Gaussian-like clusters of radius about 1000
+// Timed are the build and Q range counts with square boxes of side
+// 10^4 centred on data points.
+//
+// Usage: BenchmarkKdTree [ N [ Q [ C ] ] ]
+
+/**
+ * The two-dimensional tree of KdTree.cpp.
+ */
+template <typename Comparable>
+class PointerKdTree
+{
+  public:
+    PointerKdTree( ) : root( nullptr ) { }
+
+    ~PointerKdTree( )
+      { makeEmpty( root ); }
+
+    void insert( const vector<Comparable> & x )
+    {
+        insert( x, root, 0 );
+    }
+
+    int countRange( const vector<Comparable> & low,
+                    const vector<Comparable> & high ) const
+    {
+        return countRange( low, high, root, 0 );
+    }
+
+  private:
+    struct KdNode
+    {
+        vector<Comparable> data;
+        KdNode            *left;
+        KdNode            *right;
+
+        KdNode( const vector<Comparable> & item )
+          : data( item ), left( nullptr ), right( nullptr ) { }
+    };
+
+    KdNode *root;
+
+    void insert( const vector<Comparable> & x, KdNode * & t, int level )
+    {
+        if( t == nullptr )
+            t = new KdNode( x );
+        else if( x[ level ] < t->data[ level ] )
+            insert( x, t->left, 1 - level );
+        else
+            insert( x, t->right, 1 - level );
+    }
+
+    int countRange( const vector<Comparable> & low,
+                    const vector<Comparable> & high,
+                    KdNode *t, int level ) const
+    {
+        int count = 0;
+        if( t != nullptr )
+        {
+            if( low[ 0 ] <= t->data[ 0 ] && high[ 0 ] >= t->data[ 0 ] &&
+                low[ 1 ] <= t->data[ 1 ] && high[ 1 ] >= t->data[ 1 ] )
+                ++count;
+
+            if( low[ level ] <= t->data[ level ] )
+                count += countRange( low, high, t->left, 1 - level );
+            if( high[ level ] >= t->data[ level ] )
+                count += countRange( low, high, t->right, 1 - level );
+        }
+        return count;
+    }
+
+    void makeEmpty( KdNode *t )
+    {
+        if( t != nullptr )
+        {
+            makeEmpty( t->left );
+            makeEmpty( t->right );
+            delete t;
+        }
+    }
+};
+
+using Point = array<int, 2>;
+
+/**
+ * Time work( ), which returns a checksum, and print ms and the checksum.
+ */
+void report( const string & test, const string & tree, function<long long( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    long long sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 12 ) << test << setw( 16 ) << tree << right
+         << setw( 10 ) << fixed << setprecision( 1 )
+         << chrono::duration<double, milli>( end - start ).count( )
+         << " ms   " << sum << endl;
+}
+
+void runAll( const string & name, const vector<Point> & pts, const vector<Point> & centres )
+{
+    const int HALF = 5000;
+
+    cout << name << endl;
+    {
+        PointerKdTree<int> t;
+        report( "  build", "PointerKdTree", [ & ] {
+            for( const Point & p : pts )
+                t.insert( { p[ 0 ], p[ 1 ] } );
+            return (long long) pts.size( ); } );
+        report( "  range", "PointerKdTree", [ & ] {
+            long long total = 0;
+            for( const Point & c : centres )
+                total += t.countRange( { c[ 0 ] - HALF, c[ 1 ] - HALF },
+                                       { c[ 0 ] + HALF, c[ 1 ] + HALF } );
+            return total; } );
+    }
+    {
+        KdTree<int, 2> t;
+        report( "  build", "KdTree<int,2>", [ & ] {
+            t.build( pts );
+            return (long long) t.size( ); } );
+        report( "  range", "KdTree<int,2>", [ & ] {
+            long long total = 0;
+            for( const Point & c : centres )
+                total += t.countInRange( { c[ 0 ] - HALF, c[ 1 ] - HALF },
+                                         { c[ 0 ] + HALF, c[ 1 ] + HALF } );
+            return total; } );
+    }
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    int q = argc > 2 ? atoi( argv[ 2 ] ) : 20000;
+    int c = argc > 3 ? atoi( argv[ 3 ] ) : 1000;
+    const int SIDE = 1000000;
+
+    UniformRandom r{ 4242 };
+    vector<Point> uniform( n ), clustered( n ), clusterCentres( c );
+    for( auto & p : uniform )
+        p = { r.nextInt( SIDE ), r.nextInt( SIDE ) };
+    for( auto & p : clusterCentres )
+        p = { r.nextInt( SIDE ), r.nextInt( SIDE ) };
+    for( auto & p : clustered )
+    {
+        const Point & centre = clusterCentres[ r.nextInt( c ) ];
+        int dx = 0, dy = 0;
+        for( int k = 0; k < 4; ++k )    // Sum of uniforms: roughly Gaussian
+        {
+            dx += r.nextInt( -500, 500 );
+            dy += r.nextInt( -500, 500 );
+        }
+        p = { centre[ 0 ] + dx, centre[ 1 ] + dy };
+    }
+
+    vector<Point> uniformQueries( q ), clusteredQueries( q );
+    for( int i = 0; i < q; ++i )
+    {
+        uniformQueries[ i ] = uniform[ r.nextInt( n ) ];
+        clusteredQueries[ i ] = clustered[ r.nextInt( n ) ];
+    }
+
+    cout << n << " points, " << q << " range counts" << endl;
+    runAll( "uniform", uniform, uniformQueries );
+    runAll( "clustered (" + to_string( c ) + " clusters)", clustered, clusteredQueries );
+
+    return 0;
+}
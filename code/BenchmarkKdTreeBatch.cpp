@@ -0,0 +1,94 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <cstdlib>
+#include "KdTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Throughput of KdTree's batch queries on N uniform points in the unit
+// square: Q box counts (boxes holding about 100 points) and Q
+// 10-nearest-neighbor queries, at random places. The baseline answers
+// the queries one by one in input order; the batches sort them along
+// the Z-order curve and run them on 1, 2, 4, ... threads, up to the
+// hardware concurrency (or T).
+//
+// Usage: BenchmarkKdTreeBatch [ N [ Q [ T ] ] ]    (compile with -pthread)
+
+using Tree     = KdTree<double, 2>;
+using Point    = Tree::Point;
+using Neighbor = Tree::Neighbor;
+
+/**
+ * Time work( ), which runs q queries and returns a checksum;
+ * print queries per second.
+ */
+void report( const string & name, int q, function<double( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    double sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 24 ) << name << right << setw( 14 ) << fixed << setprecision( 0 )
+         << q / chrono::duration<double>( end - start ).count( ) << " queries/s   "
+         << setprecision( 6 ) << sum << endl;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    int q = argc > 2 ? atoi( argv[ 2 ] ) : 100000;
+    int maxThreads = argc > 3 ? atoi( argv[ 3 ] ) : max( 1u, thread::hardware_concurrency( ) );
+    const int K = 10;
+    const double HALF = 0.005;
+
+    UniformRandom r{ 2024 };
+    vector<Point> pts( n );
+    for( auto & p : pts )
+        p = { r.nextDouble( ), r.nextDouble( ) };
+    vector<Point> queries( q ), lows( q ), highs( q );
+    for( int i = 0; i < q; ++i )
+    {
+        queries[ i ] = { r.nextDouble( ), r.nextDouble( ) };
+        lows[ i ] = { queries[ i ][ 0 ] - HALF, queries[ i ][ 1 ] - HALF };
+        highs[ i ] = { queries[ i ][ 0 ] + HALF, queries[ i ][ 1 ] + HALF };
+    }
+
+    Tree t{ pts };
+    cout << n << " points, " << q << " queries, up to " << maxThreads << " threads" << endl;
+
+    vector<int> counts( q );
+    vector<Neighbor> out( (long long) q * K );
+    report( "range one by one", q, [ & ] {
+        double sum = 0;
+        for( int i = 0; i < q; ++i )
+            sum += t.countInRange( lows[ i ], highs[ i ] );
+        return sum; } );
+    for( int threads = 1; threads <= maxThreads; threads *= 2 )
+        report( "range batch, " + to_string( threads ) + " thr", q, [ & ] {
+            t.batchCountInRange( lows.data( ), highs.data( ), q, counts.data( ), threads );
+            double sum = 0;
+            for( int c : counts )
+                sum += c;
+            return sum; } );
+
+    report( "kNearest one by one", q, [ & ] {
+        double sum = 0;
+        for( int i = 0; i < q; ++i )
+            sum += out[ t.kNearest( queries[ i ], K, out.data( ) ) - 1 ].distance;
+        return sum; } );
+    for( int threads = 1; threads <= maxThreads; threads *= 2 )
+        report( "kNearest batch, " + to_string( threads ) + " thr", q, [ & ] {
+            t.batchKNearest( queries.data( ), q, K, out.data( ), counts.data( ), threads );
+            double sum = 0;
+            for( int i = 0; i < q; ++i )
+                sum += out[ (long long) i * K + counts[ i ] - 1 ].distance;
+            return sum; } );
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include "DynamicKdTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// A moving-object workload for DynamicKdTree: N points in the unit
+// square, of which M random ones move a short way each round (a remove
+// and an insert). After every round Q range counts (boxes of about 100
+// points) and Q 10-nearest-neighbor queries run on the dynamic tree and
+// on a KdTree freshly built from the same points. Printed per round:
+// ns per update, the build time the fresh tree needed, and query times.
+// The ratio column is dynamic / fresh for the two query kinds together.
+//
+// Usage: BenchmarkKdTreeChurn [ N [ M [ Q [ ROUNDS ] ] ] ]
+
+using Point = array<double, 2>;
+
+double elapsed( chrono::steady_clock::time_point start )
+{
+    return chrono::duration<double, nano>( chrono::steady_clock::now( ) - start ).count( );
+}
+
+/**
+ * Run the queries on tree t; return total ns, adding a checksum to sum.
+ */
+template <typename Tree>
+double runQueries( const Tree & t, const vector<Point> & queries, double half, double & sum )
+{
+    const int K = 10;
+    typename Tree::Neighbor out[ K ];
+    auto start = chrono::steady_clock::now( );
+    for( const Point & q : queries )
+    {
+        sum += t.countInRange( { q[ 0 ] - half, q[ 1 ] - half }, { q[ 0 ] + half, q[ 1 ] + half } );
+        sum += out[ t.kNearest( q, K, out ) - 1 ].distance;
+    }
+    return elapsed( start );
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 500000;
+    int m = argc > 2 ? atoi( argv[ 2 ] ) : n / 10;
+    int q = argc > 3 ? atoi( argv[ 3 ] ) : 20000;
+    int rounds = argc > 4 ? atoi( argv[ 4 ] ) : 40;
+    double half = sqrt( 100.0 / n ) / 2;
+    double step = 0.01;
+
+    UniformRandom r{ 777 };
+    vector<Point> pts( n );
+    DynamicKdTree<double, 2> t;
+    for( auto & p : pts )
+    {
+        p = { r.nextDouble( ), r.nextDouble( ) };
+        t.insert( p );
+    }
+
+    cout << n << " points, " << m << " moves and " << q << " queries of each kind per round" << endl;
+    cout << "round  update ns  fresh build ms  dynamic query ns  fresh query ns  ratio" << endl;
+    vector<Point> queries( q );
+    for( int round = 1; round <= rounds; ++round )
+    {
+        auto start = chrono::steady_clock::now( );
+        for( int i = 0; i < m; ++i )
+        {
+            Point & p = pts[ r.nextInt( n ) ];
+            if( !t.remove( p ) )
+                cout << "Remove error!" << endl;
+            p = { min( 1.0, max( 0.0, p[ 0 ] + ( 2 * r.nextDouble( ) - 1 ) * step ) ),
+                  min( 1.0, max( 0.0, p[ 1 ] + ( 2 * r.nextDouble( ) - 1 ) * step ) ) };
+            t.insert( p );
+        }
+        double updateNs = elapsed( start ) / ( 2.0 * m );
+
+        start = chrono::steady_clock::now( );
+        KdTree<double, 2> fresh{ pts };
+        double buildMs = elapsed( start ) / 1e6;
+
+        for( auto & p : queries )
+            p = { r.nextDouble( ), r.nextDouble( ) };
+        double dynamicSum = 0, freshSum = 0;
+        double dynamicNs = runQueries( t, queries, half, dynamicSum ) / q;
+        double freshNs = runQueries( fresh, queries, half, freshSum ) / q;
+        if( fabs( dynamicSum - freshSum ) > 1e-6 * q )
+            cout << "Dynamic and fresh trees disagree!" << endl;
+
+        cout << setw( 5 ) << round << fixed << setprecision( 1 ) << setw( 11 ) << updateNs
+             << setw( 16 ) << buildMs << setw( 18 ) << dynamicNs << setw( 16 ) << freshNs
+             << setw( 7 ) << setprecision( 2 ) << dynamicNs / freshNs << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include "KdTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Queries per second of KdTree's nearest, kNearest (k = 10, in each
+// metric) and radiusSearch (radius for about 10 points) on N uniform
+// points in the unit square, against brute-force scans. Brute force
+// runs only as many queries as keep it to about 2 * 10^8 distances,
+// and its answers are compared with the tree's.
+// N = 10^8 needs about 4 GB.
+//
+// Usage: BenchmarkKdTreeNearest [ N [ Q ] ]
+
+using Tree     = KdTree<double, 2>;
+using Point    = Tree::Point;
+using Neighbor = Tree::Neighbor;
+
+/**
+ * Time work( ), which runs q queries and returns a checksum;
+ * print queries per second.
+ */
+void report( const string & name, int q, function<double( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    double sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 24 ) << name << right << setw( 14 ) << fixed << setprecision( 0 )
+         << q / chrono::duration<double>( end - start ).count( ) << " queries/s   "
+         << setprecision( 6 ) << sum << endl;
+}
+
+/**
+ * Brute force k nearest under L2: keep a max-heap of k, as the tree does.
+ * Return the distance to the k-th nearest.
+ */
+double bruteKNearest( const vector<Point> & pts, const Point & q, int k, vector<double> & heap )
+{
+    heap.clear( );
+    for( const Point & p : pts )
+    {
+        double dx = p[ 0 ] - q[ 0 ], dy = p[ 1 ] - q[ 1 ];
+        double d = dx * dx + dy * dy;
+        if( (int) heap.size( ) < k )
+        {
+            heap.push_back( d );
+            push_heap( heap.begin( ), heap.end( ) );
+        }
+        else if( d < heap[ 0 ] )
+        {
+            pop_heap( heap.begin( ), heap.end( ) );
+            heap.back( ) = d;
+            push_heap( heap.begin( ), heap.end( ) );
+        }
+    }
+    return sqrt( heap[ 0 ] );
+}
+
+int main( int argc, char *argv[ ] )
+{
+    long long n = argc > 1 ? atoll( argv[ 1 ] ) : 1000000;
+    int q = argc > 2 ? atoi( argv[ 2 ] ) : 200000;
+    const int K = 10;
+    int bruteQueries = max( 1LL, min<long long>( q, 200000000 / n ) );
+
+    UniformRandom r{ 99 };
+    vector<Point> pts( n );
+    for( auto & p : pts )
+        p = { r.nextDouble( ), r.nextDouble( ) };
+    vector<Point> queries( q );
+    for( auto & p : queries )
+        p = { r.nextDouble( ), r.nextDouble( ) };
+    double radius = sqrt( K / ( M_PI * n ) );
+
+    Tree t;
+    auto start = chrono::steady_clock::now( );
+    t.build( pts );
+    cout << n << " points, built in " << fixed << setprecision( 1 )
+         << chrono::duration<double>( chrono::steady_clock::now( ) - start ).count( )
+         << " s; " << q << " queries, " << bruteQueries << " by brute force" << endl;
+
+    Neighbor out[ K ];
+    vector<Neighbor> inRadius;
+    report( "nearest L2", q, [ & ] {
+        double sum = 0;
+        for( const Point & p : queries )
+            sum += t.nearest( p ).distance;
+        return sum; } );
+    report( "kNearest L2", q, [ & ] {
+        double sum = 0;
+        for( const Point & p : queries )
+            sum += out[ t.kNearest( p, K, out ) - 1 ].distance;
+        return sum; } );
+    report( "kNearest L1", q, [ & ] {
+        double sum = 0;
+        for( const Point & p : queries )
+            sum += out[ t.kNearest<L1Metric>( p, K, out ) - 1 ].distance;
+        return sum; } );
+    report( "kNearest LInf", q, [ & ] {
+        double sum = 0;
+        for( const Point & p : queries )
+            sum += out[ t.kNearest<LInfMetric>( p, K, out ) - 1 ].distance;
+        return sum; } );
+    report( "radiusSearch L2", q, [ & ] {
+        double sum = 0;
+        for( const Point & p : queries )
+        {
+            t.radiusSearch( p, radius, inRadius );
+            sum += inRadius.size( );
+        }
+        return sum; } );
+
+    vector<double> heap;
+    double treeSum = 0;
+    for( int i = 0; i < bruteQueries; ++i )
+        treeSum += out[ t.kNearest( queries[ i ], K, out ) - 1 ].distance;
+    report( "kNearest L2 brute", bruteQueries, [ & ] {
+        double sum = 0;
+        for( int i = 0; i < bruteQueries; ++i )
+            sum += bruteKNearest( pts, queries[ i ], K, heap );
+        if( fabs( sum - treeSum ) > 1e-9 * bruteQueries )
+            cout << "Brute force disagrees with the tree!" << endl;
+        return sum; } );
+
+    return 0;
+}
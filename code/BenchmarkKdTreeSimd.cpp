@@ -0,0 +1,106 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include "KdTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Leaf scanning in KdTree: range counts and 10-nearest-neighbor queries
+// on N uniform points in the unit cube, with leaves of 16, 32 and 64
+// points, against leaves of one point (a scalar test per node, as in
+// KdTree.cpp). Boxes hold about B points. Run it twice to isolate the
+// vector instructions:
+//     g++ -std=c++17 -O2 -mavx2 BenchmarkKdTreeSimd.cpp
+//     g++ -std=c++17 -O2 -mavx2 -DKD_TREE_NO_SIMD BenchmarkKdTreeSimd.cpp
+//
+// Usage: BenchmarkKdTreeSimd [ N [ Q [ B ] ] ]
+
+/**
+ * Time work( ), which runs q queries and returns a checksum;
+ * print ns per query.
+ */
+void report( const string & name, int q, function<double( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    double sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 28 ) << name << right << setw( 10 ) << fixed << setprecision( 1 )
+         << chrono::duration<double, nano>( end - start ).count( ) / q << " ns/query   "
+         << setprecision( 3 ) << sum << endl;
+}
+
+/**
+ * Run the range counts and kNN queries on one tree.
+ */
+template <typename Tree>
+void runAll( const string & name, const vector<typename Tree::Point> & pts,
+             const vector<typename Tree::Point> & lows, const vector<typename Tree::Point> & highs )
+{
+    const int K = 10;
+    typename Tree::Neighbor out[ K ];
+    int q = lows.size( );
+    Tree t{ pts };
+
+    report( name + " range", q, [ & ] {
+        double sum = 0;
+        for( int i = 0; i < q; ++i )
+            sum += t.countInRange( lows[ i ], highs[ i ] );
+        return sum; } );
+    report( name + " kNearest", q, [ & ] {
+        double sum = 0;
+        for( int i = 0; i < q; ++i )
+            sum += out[ t.kNearest( lows[ i ], K, out ) - 1 ].distance;
+        return sum; } );
+}
+
+/**
+ * Make the points and boxes in D dimensions of coordinate type T,
+ * and run every leaf size.
+ */
+template <typename T, int D>
+void runType( const string & type, int n, int q, int perBox )
+{
+    using Point = array<T, D>;
+    UniformRandom r{ 8080 };
+    double side = pow( double( perBox ) / n, 1.0 / D );
+    vector<Point> pts( n ), lows( q ), highs( q );
+    for( auto & p : pts )
+        for( int d = 0; d < D; ++d )
+            p[ d ] = T( r.nextDouble( ) );
+    for( int i = 0; i < q; ++i )
+        for( int d = 0; d < D; ++d )
+        {
+            lows[ i ][ d ] = T( r.nextDouble( ) * ( 1 - side ) );
+            highs[ i ][ d ] = T( lows[ i ][ d ] + side );
+        }
+
+    cout << type << endl;
+    runAll<KdTree<T, D, 1>>( "  leaf 1", pts, lows, highs );
+    runAll<KdTree<T, D, 16>>( "  leaf 16", pts, lows, highs );
+    runAll<KdTree<T, D, 32>>( "  leaf 32", pts, lows, highs );
+    runAll<KdTree<T, D, 64>>( "  leaf 64", pts, lows, highs );
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    int q = argc > 2 ? atoi( argv[ 2 ] ) : 100000;
+    int perBox = argc > 3 ? atoi( argv[ 3 ] ) : 1000;
+
+#ifdef KD_TREE_AVX2
+    cout << "AVX2 leaf scans; ";
+#else
+    cout << "Scalar leaf scans; ";
+#endif
+    cout << n << " points, " << q << " queries, about " << perBox << " points per box" << endl;
+    runType<double, 2>( "double, 2-d", n, q, perBox );
+    runType<float, 3>( "float, 3-d", n, q, perBox );
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "Kruskal.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Kruskal's algorithm on a random graph with N vertices and M edges of
+// uniformly random float weights, kept in an edge file FILE (12 bytes
+// per edge; deleted at the end). Timed are
+//     write, read      the edge file (read is from the page cache)
+//     std::sort        std::sort by weight, then the DisjSets scan
+//     kruskal          radix sort, then the scan, for a spanning tree
+//     kruskal, k = N/100
+//                      the same, stopping at N / 100 clusters
+// The defaults, N = 10^7 and M = 10^8, need about 3 GB.
+//
+//     g++ -std=c++17 -O2 -flto BenchmarkKruskal.cpp DisjSets.cpp
+//
+// Usage: BenchmarkKruskal [ N [ M [ FILE ] ] ]
+
+using Edge = WeightedEdge<float>;
+
+/**
+ * Time work( ), which returns a checksum; print s, and MB/s for
+ * bytes moved if nonzero.
+ */
+void report( const string & name, double bytes, function<double( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    double sum = work( );
+    double seconds = chrono::duration<double>( chrono::steady_clock::now( ) - start ).count( );
+
+    cout << left << setw( 20 ) << name << right << setw( 8 ) << fixed << setprecision( 2 )
+         << seconds << " s";
+    if( bytes > 0 )
+        cout << setw( 10 ) << setprecision( 0 ) << bytes / seconds / 1e6 << " MB/s";
+    else
+        cout << setw( 15 ) << "";
+    cout << "   " << setprecision( 1 ) << sum << endl;
+}
+
+/**
+ * Replace edges with the contents of filename, freeing the old ones first.
+ */
+void reread( const string & filename, vector<Edge> & edges )
+{
+    vector<Edge>( ).swap( edges );
+    if( !readEdges( filename, edges ) )
+        cout << "Read failed!" << endl;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 10000000;
+    long long m = argc > 2 ? atoll( argv[ 2 ] ) : 100000000;
+    string filename = argc > 3 ? argv[ 3 ] : "BenchmarkKruskal.bin";
+    double bytes = double( m ) * sizeof( Edge );
+
+    cout << n << " vertices, " << m << " edges, " << fixed << setprecision( 0 )
+         << bytes / 1e6 << " MB edge file" << endl;
+    {
+        UniformRandom r{ 1926 };
+        vector<Edge> edges( m );
+        for( Edge & e : edges )
+            e = { r.nextInt( n ), r.nextInt( n ), float( r.nextDouble( ) ) };
+        report( "write", bytes, [ & ] {
+            if( !writeEdges( filename, edges ) )
+                cout << "Write failed!" << endl;
+            return double( edges.size( ) ); } );
+    }
+
+    vector<Edge> edges, forest;
+    report( "read", bytes, [ & ] { reread( filename, edges ); return double( edges.size( ) ); } );
+
+    double expected = 0;
+    report( "std::sort", 0, [ & ] {
+        sort( edges.begin( ), edges.end( ),
+              []( const Edge & a, const Edge & b ) { return a.weight < b.weight; } );
+        DisjSets ds{ n };
+        for( const Edge & e : edges )
+            if( ds.unite( e.u, e.v ) )
+                expected += e.weight;
+        return expected; } );
+
+    reread( filename, edges );
+    report( "kruskal", 0, [ & ] {
+        DisjSets ds{ n };
+        double total = kruskal( ds, edges, forest );
+        if( fabs( total - expected ) > 1e-6 * fabs( expected ) )
+            cout << "Spanning tree weights differ!" << endl;
+        return total; } );
+
+    reread( filename, edges );
+    report( "kruskal, k = N/100", 0, [ & ] {
+        DisjSets ds{ n };
+        kruskal( ds, edges, forest, n / 100 );
+        return double( ds.numSets( ) ); } );
+
+    remove( filename.c_str( ) );
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <climits>
+#include <cstdlib>
+#include <new>
+#include "AvlTree.h"
+#include "RedBlackTree.h"
+#include "SplayTree.h"
+#include "NodeStorage.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare the two node storage policies of NodeStorage.h on
+// AvlTree, RedBlackTree and SplayTree holding N random int keys:
+//     bytes/node   heap bytes in use after the inserts, divided by N;
+//                  "+ malloc" adds the usual 16 bytes of malloc
+//                  bookkeeping per allocation
+//     insert       ns per insert of N keys in random order
+//     lookup       ns per contains, half hits and half misses
+//     makeEmpty    ms to free the whole tree
+//
+// Usage: BenchmarkNodeStorage [ N ]
+
+/*
+ * Global allocation counters, maintained by the replacement
+ * operator new / operator delete below.
+ */
+static long long liveAllocations = 0;
+static long long currentBytes = 0;
+
+static const size_t HEADER = alignof( max_align_t );
+static const int MALLOC_OVERHEAD = 16;
+
+void * operator new( size_t n )
+{
+    char *p = static_cast<char *>( malloc( n + HEADER ) );
+    if( p == nullptr )
+        throw bad_alloc{ };
+    *reinterpret_cast<size_t *>( p ) = n;
+    ++liveAllocations;
+    currentBytes += n;
+    return p + HEADER;
+}
+
+void operator delete( void *q ) noexcept
+{
+    if( q == nullptr )
+        return;
+    char *p = static_cast<char *>( q ) - HEADER;
+    --liveAllocations;
+    currentBytes -= *reinterpret_cast<size_t *>( p );
+    free( p );
+}
+
+void operator delete( void *q, size_t ) noexcept
+{
+    operator delete( q );
+}
+
+double elapsed( chrono::steady_clock::time_point start, double unit )
+{
+    return chrono::duration<double, nano>( chrono::steady_clock::now( ) - start ).count( ) / unit;
+}
+
+/**
+ * Insert keys into t, look up probes, then empty t; print the measurements.
+ */
+template <typename Tree>
+void run( const string & name, Tree & t, const vector<int> & keys, const vector<int> & probes )
+{
+    long long startBytes = currentBytes;
+    long long startAllocations = liveAllocations;
+
+    auto start = chrono::steady_clock::now( );
+    for( int k : keys )
+        t.insert( k );
+    double insertTime = elapsed( start, keys.size( ) );
+
+    double bytes = double( currentBytes - startBytes ) / keys.size( );
+    double withMalloc = bytes + double( MALLOC_OVERHEAD ) * ( liveAllocations - startAllocations )
+                                / keys.size( );
+
+    start = chrono::steady_clock::now( );
+    long long hits = 0;
+    for( int p : probes )
+        hits += t.contains( p );
+    double lookupTime = elapsed( start, probes.size( ) );
+
+    start = chrono::steady_clock::now( );
+    t.makeEmpty( );
+    double emptyTime = elapsed( start, 1e6 );
+
+    cout << left << setw( 26 ) << name << right << fixed << setprecision( 1 )
+         << setw( 8 ) << bytes << setw( 10 ) << withMalloc
+         << setw( 10 ) << insertTime << setw( 10 ) << lookupTime
+         << setw( 12 ) << setprecision( 2 ) << emptyTime << "   " << hits << endl;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+
+        // Even keys are present, odd keys are misses
+    UniformRandom r{ 1729 };
+    vector<int> keys( n );
+    for( int i = 0; i < n; ++i )
+        keys[ i ] = 2 * i;
+    for( int i = n - 1; i > 0; --i )
+        swap( keys[ i ], keys[ r.nextInt( i + 1 ) ] );
+    vector<int> probes( n );
+    for( auto & p : probes )
+        p = r.nextInt( 2 * n );
+
+    cout << n << " keys" << endl;
+    cout << left << setw( 26 ) << "tree" << right << setw( 8 ) << "bytes"
+         << setw( 10 ) << "+ malloc" << setw( 10 ) << "insert" << setw( 10 ) << "lookup"
+         << setw( 12 ) << "makeEmpty" << "   hits" << endl;
+    cout << left << setw( 26 ) << "" << right << setw( 8 ) << "/node"
+         << setw( 10 ) << "/node" << setw( 10 ) << "ns" << setw( 10 ) << "ns"
+         << setw( 12 ) << "ms" << endl;
+    {
+        AvlTree<int, HeapNodes> t;
+        run( "AvlTree, HeapNodes", t, keys, probes );
+    }
+    {
+        AvlTree<int, ArenaNodes> t;
+        run( "AvlTree, ArenaNodes", t, keys, probes );
+    }
+    {
+        RedBlackTree<int, HeapNodes> t{ INT_MIN };
+        run( "RedBlackTree, HeapNodes", t, keys, probes );
+    }
+    {
+        RedBlackTree<int, ArenaNodes> t{ INT_MIN };
+        run( "RedBlackTree, ArenaNodes", t, keys, probes );
+    }
+    {
+        SplayTree<int, HeapNodes> t;
+        run( "SplayTree, HeapNodes", t, keys, probes );
+    }
+    {
+        SplayTree<int, ArenaNodes> t;
+        run( "SplayTree, ArenaNodes", t, keys, probes );
+    }
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include "AvlTree.h"
+#include "Treap.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare order-statistic queries on a changing set of N distinct keys.
+// Each round inserts one new key and then asks one query: rank( x ),
+// select( k ) or countInRange( lo, hi ), in turn.
+//     AvlTree, Treap      use the subtree sizes, O( log N ) per query
+//     copy and sort       keeps an unsorted vector and sorts a copy for
+//                         every query, which is O( N log N )
+//     sorted vector       keeps the vector sorted by insertion, O( N )
+//                         per insert but O( log N ) per query
+//
+// Usage: BenchmarkOrderStatistics [ N [ Q ] ]
+
+/**
+ * Time work( ), which returns a checksum, and print ns per round.
+ */
+void report( const string & name, long long ops, function<long long( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    long long sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 16 ) << name << right
+         << setw( 14 ) << fixed << setprecision( 1 )
+         << chrono::duration<double, nano>( end - start ).count( ) / ops
+         << " ns/round   " << sum << endl;
+}
+
+/**
+ * Answer query i on a sorted vector.
+ */
+long long answer( const vector<int> & sorted, int i, int x, int y )
+{
+    switch( i % 3 )
+    {
+      case 0:
+        return lower_bound( sorted.begin( ), sorted.end( ), x ) - sorted.begin( );
+      case 1:
+        return sorted[ y % sorted.size( ) ];
+      default:
+        return upper_bound( sorted.begin( ), sorted.end( ), max( x, y ) )
+             - lower_bound( sorted.begin( ), sorted.end( ), min( x, y ) );
+    }
+}
+
+/**
+ * Answer query i on a tree with rank, select and countInRange.
+ */
+template <typename Tree>
+long long answer( const Tree & t, int i, int x, int y )
+{
+    switch( i % 3 )
+    {
+      case 0:
+        return t.rank( x );
+      case 1:
+        return t.select( y % t.size( ) + 1 );
+      default:
+        return t.countInRange( min( x, y ), max( x, y ) );
+    }
+}
+
+/**
+ * Run the rounds of insert and query on a tree holding the first n keys.
+ */
+template <typename Tree>
+long long run( Tree & t, const vector<int> & keys, const vector<int> & qs, int n )
+{
+    long long sum = 0;
+    for( int i = 0; i + 1 < int( qs.size( ) ); ++i )
+    {
+        t.insert( keys[ n + i ] );
+        sum += answer( t, i, qs[ i ], qs[ i + 1 ] );
+    }
+    return sum;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 100000;
+    int q = argc > 2 ? atoi( argv[ 2 ] ) : 300;
+
+    UniformRandom r{ 2718 };
+    vector<int> keys( n + q );
+    for( int i = 0; i < n + q; ++i )
+        keys[ i ] = 2 * i;
+    for( int i = n + q - 1; i > 0; --i )
+        swap( keys[ i ], keys[ r.nextInt( i + 1 ) ] );
+    vector<int> qs( q + 1 );
+    for( auto & x : qs )
+        x = r.nextInt( 2 * ( n + q ) );
+
+    cout << n << " keys, " << q << " rounds of insert and query" << endl;
+    {
+        AvlTree<int> t;
+        for( int i = 0; i < n; ++i )
+            t.insert( keys[ i ] );
+        report( "AvlTree", q, [ & ] { return run( t, keys, qs, n ); } );
+    }
+    {
+        Treap<int> t;
+        for( int i = 0; i < n; ++i )
+            t.insert( keys[ i ] );
+        report( "Treap", q, [ & ] { return run( t, keys, qs, n ); } );
+    }
+    {
+        vector<int> v( keys.begin( ), keys.begin( ) + n );
+        report( "copy and sort", q, [ & ] {
+            long long sum = 0;
+            for( int i = 0; i < q; ++i )
+            {
+                v.push_back( keys[ n + i ] );
+                vector<int> sorted = v;
+                sort( sorted.begin( ), sorted.end( ) );
+                sum += answer( sorted, i, qs[ i ], qs[ i + 1 ] );
+            }
+            return sum; } );
+    }
+    {
+        vector<int> sorted( keys.begin( ), keys.begin( ) + n );
+        sort( sorted.begin( ), sorted.end( ) );
+        report( "sorted vector", q, [ & ] {
+            long long sum = 0;
+            for( int i = 0; i < q; ++i )
+            {
+                int x = keys[ n + i ];
+                sorted.insert( lower_bound( sorted.begin( ), sorted.end( ), x ), x );
+                sum += answer( sorted, i, qs[ i ], qs[ i + 1 ] );
+            }
+            return sum; } );
+    }
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <climits>
+#include <cstdlib>
+#include "BinarySearchTree.h"
+#include "AvlTree.h"
+#include "RedBlackTree.h"
+#include "SplayTree.h"
+#include "Treap.h"
+#include "BPlusTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare the ordered sets in this directory on
+//     insert     N distinct random keys, in random order
+//     lookup     N contains calls, half hits and half misses
+//     scan       range scans of S consecutive items from random start keys
+// Only the trees with iterators can run the scan; the binary trees
+// are represented there by std::set and a sorted vector.
+//
+// Usage: BenchmarkOrderedSets [ N [ S ] ]
+
+/**
+ * Time work( ), which returns a checksum, and print ns per operation.
+ */
+void report( const string & test, const string & tree, long long ops,
+             function<long long( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    long long sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 8 ) << test << setw( 20 ) << tree << right
+         << setw( 10 ) << fixed << setprecision( 1 )
+         << chrono::duration<double, nano>( end - start ).count( ) / ops
+         << " ns/op   " << sum << endl;
+}
+
+/**
+ * Insert all keys, then look up all probes; print both timings.
+ */
+template <typename Tree>
+void insertAndLookup( const string & name, Tree & t, const vector<int> & keys,
+                      const vector<int> & probes )
+{
+    report( "insert", name, keys.size( ), [ & ] {
+        for( int k : keys )
+            t.insert( k );
+        return 0LL; } );
+    report( "lookup", name, probes.size( ), [ & ] {
+        long long hits = 0;
+        for( int p : probes )
+            hits += t.contains( p );
+        return hits; } );
+}
+
+/**
+ * Sum the scanLength items starting at each start key, using iterators.
+ */
+template <typename Container>
+long long scan( const Container & c, const vector<int> & starts, int scanLength )
+{
+    long long sum = 0;
+    for( int s : starts )
+    {
+        auto itr = c.lower_bound( s );
+        for( int i = 0; i < scanLength && itr != c.end( ); ++i, ++itr )
+            sum += *itr;
+    }
+    return sum;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    int scanLength = argc > 2 ? atoi( argv[ 2 ] ) : 100;
+
+        // Even keys are present, odd keys are misses
+    UniformRandom r{ 1618 };
+    vector<int> keys( n );
+    for( int i = 0; i < n; ++i )
+        keys[ i ] = 2 * i;
+    for( int i = n - 1; i > 0; --i )
+        swap( keys[ i ], keys[ r.nextInt( i + 1 ) ] );
+    vector<int> probes( n );
+    for( auto & p : probes )
+        p = r.nextInt( 2 * n );
+    vector<int> starts( max( 1, n / scanLength ) );
+    for( auto & s : starts )
+        s = r.nextInt( 2 * n );
+
+    cout << n << " keys, scans of " << scanLength << " items" << endl;
+    {
+        BinarySearchTree<int> t;
+        insertAndLookup( "BinarySearchTree", t, keys, probes );
+    }
+    {
+        AvlTree<int> t;
+        insertAndLookup( "AvlTree", t, keys, probes );
+    }
+    {
+        RedBlackTree<int> t{ INT_MIN };
+        insertAndLookup( "RedBlackTree", t, keys, probes );
+    }
+    {
+        SplayTree<int> t;
+        insertAndLookup( "SplayTree", t, keys, probes );
+    }
+    {
+        Treap<int> t;
+        insertAndLookup( "Treap", t, keys, probes );
+    }
+    {
+        set<int> t;
+        report( "insert", "std::set", n, [ & ] {
+            for( int k : keys )
+                t.insert( k );
+            return 0LL; } );
+        report( "lookup", "std::set", n, [ & ] {
+            long long hits = 0;
+            for( int p : probes )
+                hits += t.count( p );
+            return hits; } );
+        report( "scan", "std::set", starts.size( ) * scanLength,
+                [ & ] { return scan( t, starts, scanLength ); } );
+    }
+    {
+        BPlusTree<int> t;
+        insertAndLookup( "BPlusTree", t, keys, probes );
+        report( "scan", "BPlusTree", starts.size( ) * scanLength,
+                [ & ] { return scan( t, starts, scanLength ); } );
+    }
+    {
+        vector<int> sorted = keys;
+        sort( sorted.begin( ), sorted.end( ) );
+        struct SortedVector
+        {
+            const vector<int> & v;
+            vector<int>::const_iterator lower_bound( int x ) const
+              { return std::lower_bound( v.begin( ), v.end( ), x ); }
+            vector<int>::const_iterator end( ) const
+              { return v.end( ); }
+        } sv{ sorted };
+        report( "scan", "sorted vector", starts.size( ) * scanLength,
+                [ & ] { return scan( sv, starts, scanLength ); } );
+    }
+
+    return 0;
+}
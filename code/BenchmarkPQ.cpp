@@ -0,0 +1,422 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <utility>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <new>
+#include "BinaryHeap.h"
+#include "LeftistHeap.h"
+#include "BinomialQueue.h"
+#include "PairingHeap.h"
+#include "RadixHeap.h"
+#include "UniformRandom.h"
+#include "PQPolicy.h"
+using namespace std;
+
+// Benchmark every priority queue in this directory on four workloads:
+//     heapsort       N inserts followed by N deleteMins
+//     decrease-key   Dijkstra-like: each deleteMin followed by a few
+//                    decreaseKeys (lazy reinsertion unless the heap
+//                    supports decreaseKey)
+//     meld-tree      N/8 heaps of 8 items melded pairwise into one, then drained
+//     meld-absorb    one heap absorbs N/8 heaps of 8 items, with a
+//                    deleteMin after each merge
+//     sliding window minimum of a stream over a window of W items
+// For each run, report ns per operation, the number of allocations
+// and the peak number of heap bytes in use.
+//
+// Usage: BenchmarkPQ [ N [ W ] ]
+
+/*
+ * Global allocation counters, maintained by the replacement
+ * operator new / operator delete below.
+ */
+static long long numAllocations = 0;
+static long long currentBytes = 0;
+static long long peakBytes = 0;
+
+static const size_t HEADER = alignof( max_align_t );
+
+void * operator new( size_t n )
+{
+    char *p = static_cast<char *>( malloc( n + HEADER ) );
+    if( p == nullptr )
+        throw bad_alloc{ };
+    *reinterpret_cast<size_t *>( p ) = n;
+    ++numAllocations;
+    if( ( currentBytes += n ) > peakBytes )
+        peakBytes = currentBytes;
+    return p + HEADER;
+}
+
+void operator delete( void *q ) noexcept
+{
+    if( q == nullptr )
+        return;
+    char *p = static_cast<char *>( q ) - HEADER;
+    currentBytes -= *reinterpret_cast<size_t *>( p );
+    free( p );
+}
+
+void operator delete( void *q, size_t ) noexcept
+{
+    operator delete( q );
+}
+
+/**
+ * Measurements of one run.
+ */
+struct Result
+{
+    double    nsPerOp;
+    long long allocations;
+    long long peak;
+    long long checksum;
+};
+
+/**
+ * Time work( ), which returns the number of operations it performed
+ * and a checksum, while tracking allocations made inside it.
+ */
+Result measure( function<pair<long long, long long>( )> work )
+{
+    long long startAllocations = numAllocations;
+    long long startBytes = currentBytes;
+    peakBytes = currentBytes;
+
+    auto start = chrono::steady_clock::now( );
+    pair<long long, long long> opsAndSum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    return Result{ chrono::duration<double, nano>( end - start ).count( ) / opsAndSum.first,
+                   numAllocations - startAllocations, peakBytes - startBytes,
+                   opsAndSum.second };
+}
+
+/**
+ * std::priority_queue with the insert/deleteMin/isEmpty interface.
+ */
+template <typename Comparable>
+struct StdPriorityQueue
+{
+    priority_queue<Comparable, vector<Comparable>, greater<Comparable>> pq;
+
+    void insert( const Comparable & x )
+      { pq.push( x ); }
+    const Comparable & findMin( ) const
+      { return pq.top( ); }
+    void deleteMin( )
+      { pq.pop( ); }
+    void deleteMin( Comparable & minItem )
+      { minItem = pq.top( ); pq.pop( ); }
+    bool isEmpty( ) const
+      { return pq.empty( ); }
+};
+
+/**
+ * BinaryHeap whose merge always reinserts rhs item by item,
+ * for comparison with BinaryHeap::merge, which rebuilds the heap
+ * unless rhs is small.
+ */
+template <typename Comparable>
+struct ReinsertBinaryHeap : public BinaryHeap<Comparable>
+{
+    void merge( ReinsertBinaryHeap & rhs )
+    {
+        Comparable x;
+        while( !rhs.isEmpty( ) )
+        {
+            rhs.deleteMin( x );
+            this->insert( std::move( x ) );
+        }
+    }
+};
+
+/**
+ * N inserts, then N deleteMins.
+ */
+template <typename PriorityQueue>
+pair<long long, long long> heapsort( const vector<unsigned int> & keys )
+{
+    PriorityQueue pq;
+    for( auto k : keys )
+        pq.insert( k );
+
+    long long sum = 0, i = 0;
+    unsigned int x;
+    while( !pq.isEmpty( ) )
+    {
+        pq.deleteMin( x );
+        sum += x * ( ++i % 7 );
+    }
+    return { 2 * keys.size( ), sum };
+}
+
+/**
+ * Dijkstra-like workload with lazy deletion: a decreaseKey inserts
+ * a new entry, and entries whose key is stale are skipped.
+ */
+template <typename PriorityQueue>
+pair<long long, long long> decreaseKeyLazy( const vector<unsigned int> & keys,
+                                            const vector<int> & choices )
+{
+    using Entry = pair<unsigned int, int>;
+    int n = keys.size( );
+    vector<unsigned int> key = keys;
+    vector<bool> removed( n, false );
+    PriorityQueue pq;
+    for( int i = 0; i < n; ++i )
+        pq.insert( Entry{ key[ i ], i } );
+
+    long long ops = n, sum = 0;
+    size_t c = 0;
+    Entry e;
+    while( !pq.isEmpty( ) )
+    {
+        pq.deleteMin( e );
+        ++ops;
+        if( removed[ e.second ] || e.first != key[ e.second ] )
+            continue;
+        removed[ e.second ] = true;
+        sum += e.first;
+        for( int j = 0; j < 4; ++j, ++c )
+        {
+            int v = choices[ c % choices.size( ) ];
+            if( !removed[ v ] && key[ v ] > e.first )
+            {
+                key[ v ] = e.first + ( key[ v ] - e.first ) / 2;
+                pq.insert( Entry{ key[ v ], v } );
+                ++ops;
+            }
+        }
+    }
+    return { ops, sum };
+}
+
+/**
+ * The same workload as decreaseKeyLazy, using PairingHeap::decreaseKey.
+ */
+pair<long long, long long> decreaseKeyPairing( const vector<unsigned int> & keys,
+                                               const vector<int> & choices )
+{
+    using Entry = pair<unsigned int, int>;
+    int n = keys.size( );
+    vector<unsigned int> key = keys;
+    vector<bool> removed( n, false );
+    PairingHeap<Entry> pq;
+    vector<PairingHeap<Entry>::Position> pos( n );
+    for( int i = 0; i < n; ++i )
+        pos[ i ] = pq.insert( Entry{ key[ i ], i } );
+
+    long long ops = n, sum = 0;
+    size_t c = 0;
+    Entry e;
+    while( !pq.isEmpty( ) )
+    {
+        pq.deleteMin( e );
+        ++ops;
+        removed[ e.second ] = true;
+        sum += e.first;
+        for( int j = 0; j < 4; ++j, ++c )
+        {
+            int v = choices[ c % choices.size( ) ];
+            if( !removed[ v ] && key[ v ] > e.first )
+            {
+                key[ v ] = e.first + ( key[ v ] - e.first ) / 2;
+                pq.decreaseKey( pos[ v ], Entry{ key[ v ], v } );
+                ++ops;
+            }
+        }
+    }
+    return { ops, sum };
+}
+
+/**
+ * Build N/8 heaps of 8 items, meld them pairwise into one, then drain it.
+ */
+template <typename PriorityQueue>
+pair<long long, long long> meld( const vector<unsigned int> & keys )
+{
+    const int SMALL = 8;
+    int numHeaps = ( keys.size( ) + SMALL - 1 ) / SMALL;
+    vector<PriorityQueue> heaps( numHeaps );
+    for( size_t i = 0; i < keys.size( ); ++i )
+        heaps[ i / SMALL ].insert( keys[ i ] );
+
+    long long ops = keys.size( );
+    for( int step = 1; step < numHeaps; step *= 2 )
+        for( int i = 0; i + step < numHeaps; i += 2 * step )
+        {
+            heaps[ i ].merge( heaps[ i + step ] );
+            ++ops;
+        }
+
+    long long sum = 0, i = 0;
+    unsigned int x;
+    while( !heaps[ 0 ].isEmpty( ) )
+    {
+        heaps[ 0 ].deleteMin( x );
+        sum += x * ( ++i % 7 );
+        ++ops;
+    }
+    return { ops, sum };
+}
+
+/**
+ * One heap repeatedly absorbs a heap of 8 items and removes its minimum.
+ */
+template <typename PriorityQueue>
+pair<long long, long long> meldAbsorb( const vector<unsigned int> & keys )
+{
+    const int SMALL = 8;
+    PriorityQueue main;
+    long long ops = 0, sum = 0, i = 0;
+    unsigned int x;
+    for( size_t start = 0; start < keys.size( ); start += SMALL )
+    {
+        PriorityQueue small;
+        for( size_t j = start; j < start + SMALL && j < keys.size( ); ++j )
+            small.insert( keys[ j ] );
+        main.merge( small );
+        main.deleteMin( x );
+        sum += x * ( ++i % 7 );
+        ops += SMALL + 2;
+    }
+    return { ops, sum };
+}
+
+/**
+ * Sliding window minimum over a window of w items,
+ * removing expired minima lazily.
+ */
+template <typename PriorityQueue>
+pair<long long, long long> slidingWindow( const vector<unsigned int> & keys, int w )
+{
+    using Entry = pair<unsigned int, int>;
+    PriorityQueue pq;
+    long long ops = 0, sum = 0;
+    for( int i = 0; i < (int) keys.size( ); ++i )
+    {
+        pq.insert( Entry{ keys[ i ], i } );
+        ++ops;
+        while( pq.findMin( ).second <= i - w )
+        {
+            pq.deleteMin( );
+            ++ops;
+        }
+        sum += pq.findMin( ).first;
+    }
+    return { ops, sum };
+}
+
+/**
+ * Print one line of the results table.
+ */
+void print( const string & workload, const string & heap, const Result & r )
+{
+    cout << left << setw( 14 ) << workload << setw( 26 ) << heap << right
+         << setw( 10 ) << fixed << setprecision( 1 ) << r.nsPerOp
+         << setw( 12 ) << r.allocations
+         << setw( 14 ) << r.peak
+         << "   " << r.checksum << endl;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 200000;
+    int w = argc > 2 ? atoi( argv[ 2 ] ) : 1000;
+
+    UniformRandom r{ 2718 };
+    vector<unsigned int> keys( n );
+    for( auto & k : keys )
+        k = r.nextInt( 0, 1 << 30 );
+    vector<int> choices( 4 * n );
+    for( auto & c : choices )
+        c = r.nextInt( n );
+
+    using Entry = pair<unsigned int, int>;
+
+    cout << left << setw( 14 ) << "workload" << setw( 26 ) << "heap" << right
+         << setw( 10 ) << "ns/op" << setw( 12 ) << "allocs"
+         << setw( 14 ) << "peak bytes" << "   checksum" << endl;
+
+    print( "heapsort", "BinaryHeap", measure( [ & ] {
+        return heapsort<BinaryHeap<unsigned int>>( keys ); } ) );
+    print( "heapsort", "std::priority_queue", measure( [ & ] {
+        return heapsort<StdPriorityQueue<unsigned int>>( keys ); } ) );
+    print( "heapsort", "LeftistHeap", measure( [ & ] {
+        return heapsort<LeftistHeap<unsigned int>>( keys ); } ) );
+    print( "heapsort", "BinomialQueue", measure( [ & ] {
+        return heapsort<BinomialQueue<unsigned int>>( keys ); } ) );
+    print( "heapsort", "PairingHeap", measure( [ & ] {
+        return heapsort<PairingHeap<unsigned int>>( keys ); } ) );
+    print( "heapsort", "RadixHeap", measure( [ & ] {
+        return heapsort<RadixHeap<unsigned int>>( keys ); } ) );
+
+    print( "decrease-key", "BinaryHeap (lazy)", measure( [ & ] {
+        return decreaseKeyLazy<BinaryHeap<Entry>>( keys, choices ); } ) );
+    print( "decrease-key", "std::priority_queue (lazy)", measure( [ & ] {
+        return decreaseKeyLazy<StdPriorityQueue<Entry>>( keys, choices ); } ) );
+    print( "decrease-key", "LeftistHeap (lazy)", measure( [ & ] {
+        return decreaseKeyLazy<LeftistHeap<Entry>>( keys, choices ); } ) );
+    print( "decrease-key", "BinomialQueue (lazy)", measure( [ & ] {
+        return decreaseKeyLazy<BinomialQueue<Entry>>( keys, choices ); } ) );
+    print( "decrease-key", "PairingHeap (lazy)", measure( [ & ] {
+        return decreaseKeyLazy<PairingHeap<Entry>>( keys, choices ); } ) );
+    print( "decrease-key", "PairingHeap::decreaseKey", measure( [ & ] {
+        return decreaseKeyPairing( keys, choices ); } ) );
+    print( "decrease-key", "RadixHeap (lazy)", measure( [ & ] {
+        return decreaseKeyLazy<RadixHeap<Entry>>( keys, choices ); } ) );
+
+    print( "meld-tree", "BinaryHeap", measure( [ & ] {
+        return meld<BinaryHeap<unsigned int>>( keys ); } ) );
+    print( "meld-tree", "BinaryHeap (reinsert)", measure( [ & ] {
+        return meld<ReinsertBinaryHeap<unsigned int>>( keys ); } ) );
+    print( "meld-tree", "LeftistHeap", measure( [ & ] {
+        return meld<LeftistHeap<unsigned int>>( keys ); } ) );
+    print( "meld-tree", "BinomialQueue", measure( [ & ] {
+        return meld<BinomialQueue<unsigned int>>( keys ); } ) );
+    print( "meld-tree", "PairingHeap", measure( [ & ] {
+        return meld<PairingHeap<unsigned int>>( keys ); } ) );
+
+    print( "meld-absorb", "BinaryHeap", measure( [ & ] {
+        return meldAbsorb<BinaryHeap<unsigned int>>( keys ); } ) );
+    print( "meld-absorb", "BinaryHeap (reinsert)", measure( [ & ] {
+        return meldAbsorb<ReinsertBinaryHeap<unsigned int>>( keys ); } ) );
+    print( "meld-absorb", "LeftistHeap", measure( [ & ] {
+        return meldAbsorb<LeftistHeap<unsigned int>>( keys ); } ) );
+    print( "meld-absorb", "BinomialQueue", measure( [ & ] {
+        return meldAbsorb<BinomialQueue<unsigned int>>( keys ); } ) );
+    print( "meld-absorb", "PairingHeap", measure( [ & ] {
+        return meldAbsorb<PairingHeap<unsigned int>>( keys ); } ) );
+
+    print( "window", "BinaryHeap", measure( [ & ] {
+        return slidingWindow<BinaryHeap<Entry>>( keys, w ); } ) );
+    print( "window", "std::priority_queue", measure( [ & ] {
+        return slidingWindow<StdPriorityQueue<Entry>>( keys, w ); } ) );
+    print( "window", "LeftistHeap", measure( [ & ] {
+        return slidingWindow<LeftistHeap<Entry>>( keys, w ); } ) );
+    print( "window", "BinomialQueue", measure( [ & ] {
+        return slidingWindow<BinomialQueue<Entry>>( keys, w ); } ) );
+    print( "window", "PairingHeap", measure( [ & ] {
+        return slidingWindow<PairingHeap<Entry>>( keys, w ); } ) );
+
+    cout << endl << "Policy choices (PQPolicy.h):" << endl;
+    print( "heapsort", "PreferredPQ", measure( [ & ] {
+        return heapsort<PreferredPQ<PQWorkload::HEAPSORT, unsigned int>>( keys ); } ) );
+    print( "decrease-key", "PreferredPQ", measure( [ & ] {
+        return decreaseKeyLazy<PreferredPQ<PQWorkload::DECREASE_KEY, Entry>>(
+                   keys, choices ); } ) );
+    print( "meld-tree", "PreferredPQ", measure( [ & ] {
+        return meld<PreferredPQ<PQWorkload::MELD, unsigned int>>( keys ); } ) );
+    print( "meld-absorb", "PreferredPQ", measure( [ & ] {
+        return meldAbsorb<PreferredPQ<PQWorkload::MELD, unsigned int>>( keys ); } ) );
+    print( "window", "PreferredPQ", measure( [ & ] {
+        return slidingWindow<PreferredPQ<PQWorkload::SLIDING_WINDOW, Entry>>( keys, w ); } ) );
+
+    return 0;
+}
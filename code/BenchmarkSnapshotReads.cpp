@@ -0,0 +1,169 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <climits>
+#include <cstdlib>
+#include "RedBlackTree.h"
+#include "PersistentRedBlackTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare read throughput on a set of N int keys while one writer
+// keeps inserting random keys, with R reader threads:
+//     locked               RedBlackTree behind a shared_mutex; readers take
+//                          it shared for each lookup, the writer exclusive
+//     snapshot/lookup      PersistentRedBlackTree::contains, which searches
+//                          the current version in place, taking no lock
+//                          and no reference count
+//     snapshot/copy        a reader takes a snapshot for each lookup;
+//                          every copy updates the reference count of the
+//                          shared root node, so readers contend on it
+//     snapshot/1000        a reader takes a snapshot, does 1000 lookups
+//                          on it, then takes the next one
+// Each run lasts D ms. Printed are the total lookups and the inserts
+// done in that time, in millions per second.
+//
+// Usage: BenchmarkSnapshotReads [ N [ R [ D ] ] ]     (compile with -pthread)
+
+static atomic<long long> totalHits{ 0 };     // Keeps the lookups from being optimized away
+
+/**
+ * Run reader( id, stop ) on each of numReaders threads and writer( stop )
+ * on one more, for ms milliseconds. Each returns its operation count.
+ * Print the totals.
+ */
+void report( const string & name, int numReaders, int ms,
+             function<long long( int, const atomic<bool> & )> reader,
+             function<long long( const atomic<bool> & )> writer )
+{
+    atomic<bool> stop{ false };
+    vector<long long> reads( numReaders );
+    long long writes = 0;
+
+    vector<thread> threads;
+    for( int i = 0; i < numReaders; ++i )
+        threads.emplace_back( [ &, i ] { reads[ i ] = reader( i, stop ); } );
+    threads.emplace_back( [ & ] { writes = writer( stop ); } );
+
+    auto start = chrono::steady_clock::now( );
+    this_thread::sleep_for( chrono::milliseconds( ms ) );
+    stop = true;
+    for( auto & t : threads )
+        t.join( );
+    double us = chrono::duration<double, micro>( chrono::steady_clock::now( ) - start ).count( );
+
+    long long totalReads = 0;
+    for( long long r : reads )
+        totalReads += r;
+    cout << left << setw( 18 ) << name << right << setw( 4 ) << numReaders
+         << fixed << setprecision( 2 ) << setw( 12 ) << totalReads / us
+         << setw( 12 ) << writes / us << endl;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    int maxReaders = argc > 2 ? atoi( argv[ 2 ] ) : max( 4u, thread::hardware_concurrency( ) );
+    int ms = argc > 3 ? atoi( argv[ 3 ] ) : 500;
+
+    vector<int> keys( n );
+    for( int i = 0; i < n; ++i )
+        keys[ i ] = 2 * i;
+
+    RedBlackTree<int> locked{ INT_MIN, keys.begin( ), keys.end( ) };
+    shared_mutex lock;
+    PersistentRedBlackTree<int> persistent;
+    for( int k : keys )
+        persistent.insert( k );
+
+    cout << n << " keys, 1 writer, " << ms << " ms per run" << endl;
+    cout << left << setw( 18 ) << "tree" << right << setw( 4 ) << "R"
+         << setw( 12 ) << "Mreads/s" << setw( 12 ) << "Mwrites/s" << endl;
+
+    auto writerRandom = [ & ]( int seed ) { return UniformRandom{ 7000 + seed }; };
+    for( int readers = 1; readers <= maxReaders; readers *= 2 )
+    {
+        report( "locked", readers, ms,
+            [ & ]( int id, const atomic<bool> & stop ) {
+                UniformRandom r{ id };
+                long long count = 0, hits = 0;
+                while( !stop )
+                {
+                    shared_lock<shared_mutex> guard{ lock };
+                    hits += locked.contains( r.nextInt( 4 * n ) );
+                    ++count;
+                }
+                totalHits += hits;
+                return count; },
+            [ & ]( const atomic<bool> & stop ) {
+                UniformRandom r = writerRandom( readers );
+                long long count = 0;
+                for( ; !stop; ++count )
+                {
+                    int x = r.nextInt( 4 * n );
+                    unique_lock<shared_mutex> guard{ lock };
+                    locked.insert( x );
+                }
+                return count; } );
+
+        report( "snapshot/lookup", readers, ms,
+            [ & ]( int id, const atomic<bool> & stop ) {
+                UniformRandom r{ id };
+                long long count = 0, hits = 0;
+                for( ; !stop; ++count )
+                    hits += persistent.contains( r.nextInt( 4 * n ) );
+                totalHits += hits;
+                return count; },
+            [ & ]( const atomic<bool> & stop ) {
+                UniformRandom r = writerRandom( readers );
+                long long count = 0;
+                for( ; !stop; ++count )
+                    persistent.insert( r.nextInt( 4 * n ) );
+                return count; } );
+
+        report( "snapshot/copy", readers, ms,
+            [ & ]( int id, const atomic<bool> & stop ) {
+                UniformRandom r{ id };
+                long long count = 0, hits = 0;
+                for( ; !stop; ++count )
+                    hits += persistent.snapshot( ).contains( r.nextInt( 4 * n ) );
+                totalHits += hits;
+                return count; },
+            [ & ]( const atomic<bool> & stop ) {
+                UniformRandom r = writerRandom( readers );
+                long long count = 0;
+                for( ; !stop; ++count )
+                    persistent.insert( r.nextInt( 4 * n ) );
+                return count; } );
+
+        report( "snapshot/1000", readers, ms,
+            [ & ]( int id, const atomic<bool> & stop ) {
+                UniformRandom r{ id };
+                long long count = 0, hits = 0;
+                while( !stop )
+                {
+                    auto s = persistent.snapshot( );
+                    for( int i = 0; i < 1000; ++i )
+                        hits += s.contains( r.nextInt( 4 * n ) );
+                    count += 1000;
+                }
+                totalHits += hits;
+                return count; },
+            [ & ]( const atomic<bool> & stop ) {
+                UniformRandom r = writerRandom( readers );
+                long long count = 0;
+                for( ; !stop; ++count )
+                    persistent.insert( r.nextInt( 4 * n ) );
+                return count; } );
+    }
+    cout << totalHits << " hits" << endl;
+
+    return 0;
+}
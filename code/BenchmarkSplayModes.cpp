@@ -0,0 +1,116 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include "SplayTree.h"
+#include "AvlTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare the contains modes of SplayTree with AvlTree on N keys,
+// inserted in random order, under M lookups that are
+//     zipf         Zipf-distributed with exponent S over a random
+//                  popularity order of the keys
+//     uniform      uniformly random keys
+//     sequential   0, 1, ..., N - 1, over and over
+// Each tree is built afresh per workload. Printed are ns per lookup.
+//
+// Usage: BenchmarkSplayModes [ N [ M [ S ] ] ]
+
+struct Variant
+{
+    const char *name;
+    SplayMode   mode;
+    double      parameter;
+};
+
+static const Variant variants[ ] = {
+    { "splay", SplayMode::SPLAY, 0 },
+    { "semi", SplayMode::SEMI_SPLAY, 0 },
+    { "p=0.1", SplayMode::RANDOM_SPLAY, 0.1 },
+    { "depth>2lg", SplayMode::DEPTH_SPLAY, 2 } };
+
+/**
+ * Time the lookups of accesses in t, and print ns per lookup.
+ */
+template <typename Tree>
+void report( Tree & t, const vector<int> & accesses )
+{
+    auto start = chrono::steady_clock::now( );
+    long long hits = 0;
+    for( int x : accesses )
+        hits += t.contains( x );
+    auto end = chrono::steady_clock::now( );
+
+    cout << setw( 10 ) << fixed << setprecision( 1 )
+         << chrono::duration<double, nano>( end - start ).count( ) / accesses.size( );
+    if( hits != (long long) accesses.size( ) )
+        cout << " (lookup error!)";
+}
+
+/**
+ * Run one workload on every tree, on one line.
+ */
+void runAll( const string & workload, const vector<int> & keys, const vector<int> & accesses )
+{
+    cout << left << setw( 12 ) << workload << right;
+    for( const Variant & v : variants )
+    {
+        SplayTree<int> t;
+        for( int k : keys )
+            t.insert( k );
+        t.setSplayMode( v.mode, v.parameter );
+        report( t, accesses );
+    }
+    AvlTree<int> avl;
+    for( int k : keys )
+        avl.insert( k );
+    report( avl, accesses );
+    cout << endl;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    int m = argc > 2 ? atoi( argv[ 2 ] ) : 2000000;
+    double s = argc > 3 ? atof( argv[ 3 ] ) : 0.99;
+
+    UniformRandom r{ 31337 };
+    vector<int> keys( n );
+    for( int i = 0; i < n; ++i )
+        keys[ i ] = i;
+    for( int i = n - 1; i > 0; --i )
+        swap( keys[ i ], keys[ r.nextInt( i + 1 ) ] );
+
+        // keys doubles as the popularity order: keys[ 0 ] is hottest
+    vector<double> cumulative( n );
+    double sum = 0;
+    for( int i = 0; i < n; ++i )
+        cumulative[ i ] = sum += 1 / pow( i + 1, s );
+    vector<int> zipf( m ), uniform( m ), sequential( m );
+    for( int i = 0; i < m; ++i )
+    {
+        double u = r.nextDouble( ) * sum;
+        int rank = upper_bound( cumulative.begin( ), cumulative.end( ), u ) - cumulative.begin( );
+        zipf[ i ] = keys[ min( rank, n - 1 ) ];
+        uniform[ i ] = r.nextInt( n );
+        sequential[ i ] = i % n;
+    }
+
+    cout << n << " keys, " << m << " lookups, Zipf exponent " << s << "; ns per lookup" << endl;
+    cout << left << setw( 12 ) << "workload" << right;
+    for( const Variant & v : variants )
+        cout << setw( 10 ) << v.name;
+    cout << setw( 10 ) << "AvlTree" << endl;
+
+    runAll( "zipf", keys, zipf );
+    runAll( "uniform", keys, uniform );
+    runAll( "sequential", keys, sequential );
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include "BinarySearchTree.h"
+#include "AvlTree.h"
+#include "EytzingerSet.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare lookup latency on a read-only set of N int keys, for N from
+// 1000 up to MAX in steps of 10:
+//     BinarySearchTree   contains on the pointer tree, built by random inserts
+//     AvlTree            contains on the pointer tree, built by random inserts
+//     binarySearch       Fig02_09.cpp's binary search on a sorted vector
+//     EytzingerSet       contains on the frozen AvlTree
+// Each size runs Q lookups of random keys, half of them hits.
+// The trees are only built for N <= TREE_MAX, since they need about
+// 40 bytes per key and a long time to build; the arrays need 8.
+//
+// Usage: BenchmarkStaticSearch [ MAX [ TREE_MAX [ Q ] ] ]
+
+const int NOT_FOUND = -1;
+
+/**
+ * Performs the standard binary search using two comparisons per level.
+ * Returns index where item is found or -1 if not found.
+ * (The routine of Fig02_09.cpp.)
+ */
+template <typename Comparable>
+int binarySearch( const vector<Comparable> & a, const Comparable & x )
+{
+    int low = 0, high = a.size( ) - 1;
+
+    while( low <= high )
+    {
+        int mid = ( low + high ) / 2;
+
+        if( a[ mid ] < x )
+            low = mid + 1;
+        else if( a[ mid ] > x )
+            high = mid - 1;
+        else
+            return mid;   // Found
+    }
+    return NOT_FOUND;
+}
+
+/**
+ * Time work( ), which returns a checksum, and print ns per lookup.
+ */
+void report( const string & name, long long ops, function<long long( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    long long sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 20 ) << name << right
+         << setw( 10 ) << fixed << setprecision( 1 )
+         << chrono::duration<double, nano>( end - start ).count( ) / ops
+         << " ns/lookup   " << sum << endl;
+}
+
+/**
+ * Count the probes that t contains.
+ */
+template <typename Set>
+long long hits( const Set & t, const vector<int> & probes )
+{
+    long long sum = 0;
+    for( int p : probes )
+        sum += t.contains( p );
+    return sum;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int maxSize = argc > 1 ? atoi( argv[ 1 ] ) : 10000000;
+    int treeMax = argc > 2 ? atoi( argv[ 2 ] ) : 10000000;
+    int q = argc > 3 ? atoi( argv[ 3 ] ) : 1000000;
+
+    UniformRandom r{ 1618 };
+    for( long long size = 1000; size <= maxSize; size *= 10 )
+    {
+        int n = size;
+
+            // Even keys are present, odd keys are misses
+        vector<int> sorted( n );
+        for( int i = 0; i < n; ++i )
+            sorted[ i ] = 2 * i;
+        vector<int> probes( q );
+        for( auto & p : probes )
+            p = r.nextInt( 2 * n );
+
+        cout << n << " keys, " << q << " lookups" << endl;
+        EytzingerSet<int> frozen;
+        if( n <= treeMax )
+        {
+            vector<int> keys = sorted;
+            for( int i = n - 1; i > 0; --i )
+                swap( keys[ i ], keys[ r.nextInt( i + 1 ) ] );
+            {
+                BinarySearchTree<int> t;
+                for( int k : keys )
+                    t.insert( k );
+                report( "BinarySearchTree", q, [ & ] { return hits( t, probes ); } );
+            }
+            AvlTree<int> t;
+            for( int k : keys )
+                t.insert( k );
+            report( "AvlTree", q, [ & ] { return hits( t, probes ); } );
+            frozen = t.freeze( );
+        }
+        else
+            frozen = EytzingerSet<int>{ sorted.begin( ), sorted.end( ) };
+
+        report( "binarySearch", q, [ & ] {
+            long long sum = 0;
+            for( int p : probes )
+                sum += binarySearch( sorted, p ) != NOT_FOUND;
+            return sum; } );
+        report( "EytzingerSet", q, [ & ] { return hits( frozen, probes ); } );
+    }
+
+    return 0;
+}
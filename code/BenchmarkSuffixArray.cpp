@@ -0,0 +1,154 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "InducedSuffixArray.h"
+#include "UniformRandom.h"
+
+    // createSuffixArray (DC3) and createSuffixArraySlow (sorting),
+    // exactly as in SuffixArray.cpp, without its demonstration main
+#define main suffixArrayDemo
+#include "SuffixArray.cpp"
+#undef main
+using namespace std;
+
+// Suffix array construction on N bytes of
+//     dna     uniformly random ACGT
+//     log     log lines from a few templates, with long repeats
+// by createSuffixArraySlow, createSuffixArray, and SA-IS with 32-bit
+// and 64-bit indexes, alone and followed by the LCP array. The first
+// two always build the LCP array too. Each run is in its own process
+// (Linux only), and reports its time and its peak resident memory
+// above the text, from VmHWM in /proc/self/status. The checksums
+// agree when the suffix arrays do. createSuffixArraySlow copies every
+// suffix into a string to compare them for the LCP array, which is
+// quadratic, so it runs only for N up to SLOW_LIMIT. N = 10^8 needs
+// about 4 GB, for createSuffixArray.
+//
+// Usage: BenchmarkSuffixArray [ N ]
+
+const size_t SLOW_LIMIT = 200000;
+
+/**
+ * Return the value, in kB, of field in /proc/self/status.
+ */
+long statusKB( const string & field )
+{
+    ifstream in( "/proc/self/status" );
+    string line;
+    while( getline( in, line ) )
+        if( line.compare( 0, field.length( ), field ) == 0 )
+            return atol( line.c_str( ) + field.length( ) + 1 );
+    return 0;
+}
+
+/**
+ * Run work( ), which returns a checksum, in a child process;
+ * print its time and peak memory above what it started with.
+ */
+void report( const string & name, function<uint64_t( )> work )
+{
+    cout << left << setw( 24 ) << name << right << flush;
+    if( fork( ) == 0 )
+    {
+        long startKB = statusKB( "VmRSS" );
+        auto start = chrono::steady_clock::now( );
+        uint64_t sum = work( );
+        double seconds = chrono::duration<double>( chrono::steady_clock::now( ) - start ).count( );
+
+        cout << setw( 8 ) << fixed << setprecision( 2 ) << seconds << " s"
+             << setw( 8 ) << ( statusKB( "VmHWM" ) - startKB ) / 1024 << " MB   "
+             << hex << sum << dec << endl;
+        _exit( 0 );
+    }
+    wait( nullptr );
+}
+
+/**
+ * Return a checksum of a suffix array, equal for equal arrays.
+ */
+template <typename Index>
+uint64_t checksum( const vector<Index> & sa )
+{
+    uint64_t sum = 0;
+    for( size_t i = 0; i < sa.size( ); ++i )
+        sum = sum * 1000003 + sa[ i ];
+    return sum;
+}
+
+/**
+ * Return n bytes of log lines built from a few templates.
+ */
+string makeLog( size_t n, UniformRandom & r )
+{
+    const char *LEVELS[ ] = { "INFO", "INFO", "INFO", "WARN", "DEBUG" };
+    const char *EVENTS[ ] = { "request served in ", "cache miss, fetched in ",
+                              "connection closed after ", "retrying after " };
+    string log;
+    while( log.length( ) < n )
+        log += "2026-10-19 12:" + to_string( 10 + r.nextInt( 50 ) ) + ":"
+               + to_string( 10 + r.nextInt( 50 ) ) + " " + LEVELS[ r.nextInt( 5 ) ]
+               + " worker-" + to_string( r.nextInt( 16 ) ) + " "
+               + EVENTS[ r.nextInt( 4 ) ] + to_string( r.nextInt( 1000 ) ) + " ms\n";
+    log.resize( n );
+    return log;
+}
+
+/**
+ * Time every construction on text.
+ */
+void benchmark( const string & text )
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>( text.data( ) );
+    size_t n = text.length( );
+
+    if( n <= SLOW_LIMIT )
+        report( "createSuffixArraySlow", [ & ] {
+            vector<int> sa( n ), lcp( n );
+            createSuffixArraySlow( text, sa, lcp );
+            return checksum( sa ); } );
+    else
+        cout << left << setw( 24 ) << "createSuffixArraySlow" << "  skipped, N > "
+             << SLOW_LIMIT << right << endl;
+    report( "createSuffixArray", [ & ] {
+        vector<int> sa( n ), lcp( n );
+        createSuffixArray( text, sa, lcp );
+        return checksum( sa ); } );
+    report( "SA-IS 32", [ & ] {
+        vector<uint32_t> sa( n );
+        inducedSuffixArray( bytes, uint32_t( n ), sa.data( ) );
+        return checksum( sa ); } );
+    report( "SA-IS 32 + LCP", [ & ] {
+        vector<uint32_t> sa( n ), lcp( n );
+        inducedSuffixArray( bytes, uint32_t( n ), sa.data( ) );
+        lcpArray( bytes, uint32_t( n ), sa.data( ), lcp.data( ) );
+        return checksum( sa ); } );
+    report( "SA-IS 64", [ & ] {
+        vector<uint64_t> sa( n );
+        inducedSuffixArray( bytes, uint64_t( n ), sa.data( ) );
+        return checksum( sa ); } );
+}
+
+int main( int argc, char *argv[ ] )
+{
+    size_t n = argc > 1 ? atoll( argv[ 1 ] ) : 20000000;
+    UniformRandom r{ 50 };
+
+    string dna( n, ' ' );
+    for( char & c : dna )
+        c = "ACGT"[ r.nextInt( 4 ) ];
+    cout << n << " bytes of dna" << endl;
+    benchmark( dna );
+
+    string log = makeLog( n, r );
+    cout << n << " bytes of log" << endl;
+    benchmark( log );
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include "Treap.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare ways to form the union, intersection and difference of a set
+// of N random keys with a set of M random keys:
+//     split/join        Treap::unionWith, intersectWith and differenceWith,
+//                       with 1 and with T threads
+//     inserts           union by inserting the M keys one by one,
+//                       intersection and difference by M removes / lookups
+//     std::set_union    and the other algorithms, on sorted vectors
+// Building the operands is not timed.
+//
+// Usage: BenchmarkTreapSetOps [ N [ M [ T ] ] ]     (compile with -pthread)
+
+/**
+ * Time work( ), which returns a checksum, and print ms.
+ */
+void report( const string & test, const string & method, function<long long( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    long long sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 14 ) << test << setw( 22 ) << method << right
+         << setw( 10 ) << fixed << setprecision( 1 )
+         << chrono::duration<double, milli>( end - start ).count( )
+         << " ms   " << sum << endl;
+}
+
+/**
+ * Build a treap from keys by single inserts.
+ */
+Treap<int> build( const vector<int> & keys )
+{
+    Treap<int> t;
+    for( int k : keys )
+        t.insert( k );
+    return t;
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    int m = argc > 2 ? atoi( argv[ 2 ] ) : 1000000;
+    int numThreads = argc > 3 ? atoi( argv[ 3 ] ) : 4;
+
+    UniformRandom r{ 31415 };
+    vector<int> a( n );
+    vector<int> b( m );
+    for( auto & x : a )
+        x = r.nextInt( 2 * n );
+    for( auto & x : b )
+        x = r.nextInt( 2 * n );
+    vector<int> sa = a;
+    vector<int> sb = b;
+    sort( sa.begin( ), sa.end( ) );
+    sa.erase( unique( sa.begin( ), sa.end( ) ), sa.end( ) );
+    sort( sb.begin( ), sb.end( ) );
+    sb.erase( unique( sb.begin( ), sb.end( ) ), sb.end( ) );
+
+    cout << sa.size( ) << " and " << sb.size( ) << " distinct keys, "
+         << numThreads << " threads" << endl;
+
+    for( int threads : { 1, numThreads } )
+    {
+        string method = "split/join x" + to_string( threads );
+        {
+            Treap<int> ta = build( a );
+            Treap<int> tb = build( b );
+            report( "union", method, [ & ] {
+                ta.unionWith( tb, threads );
+                return (long long) ta.size( ); } );
+        }
+        {
+            Treap<int> ta = build( a );
+            Treap<int> tb = build( b );
+            report( "intersection", method, [ & ] {
+                ta.intersectWith( tb, threads );
+                return (long long) ta.size( ); } );
+        }
+        {
+            Treap<int> ta = build( a );
+            Treap<int> tb = build( b );
+            report( "difference", method, [ & ] {
+                ta.differenceWith( tb, threads );
+                return (long long) ta.size( ); } );
+        }
+    }
+
+    {
+        Treap<int> ta = build( a );
+        report( "union", "inserts", [ & ] {
+            for( int x : b )
+                ta.insert( x );
+            return (long long) ta.size( ); } );
+    }
+    {
+        Treap<int> ta = build( a );
+        report( "intersection", "lookups and inserts", [ & ] {
+            Treap<int> result;
+            for( int x : sb )
+                if( ta.contains( x ) )
+                    result.insert( x );
+            return (long long) result.size( ); } );
+    }
+    {
+        Treap<int> ta = build( a );
+        report( "difference", "removes", [ & ] {
+            for( int x : b )
+                ta.remove( x );
+            return (long long) ta.size( ); } );
+    }
+
+    report( "union", "std::set_union", [ & ] {
+        vector<int> out;
+        set_union( sa.begin( ), sa.end( ), sb.begin( ), sb.end( ), back_inserter( out ) );
+        return (long long) out.size( ); } );
+    report( "intersection", "std::set_intersection", [ & ] {
+        vector<int> out;
+        set_intersection( sa.begin( ), sa.end( ), sb.begin( ), sb.end( ), back_inserter( out ) );
+        return (long long) out.size( ); } );
+    report( "difference", "std::set_difference", [ & ] {
+        vector<int> out;
+        set_difference( sa.begin( ), sa.end( ), sb.begin( ), sb.end( ), back_inserter( out ) );
+        return (long long) out.size( ); } );
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <streambuf>
+#include <cstdlib>
+#include "BinarySearchTree.h"
+#include "AvlTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Compare in-order scans of N random keys:
+//     iterator    begin( ) to end( ) with the parent-linked iterators
+//     recursive   printTree into a stream that parses the keys back
+//                 into a vector, the only traversal the trees had before
+// and range scans of S items from random start keys:
+//     iterator    lower_bound( x ), then S increments
+//     recursive   collect every key as above, then binary search
+// The recursive range scan is O( N ) per scan, so it runs R scans only.
+//
+// Usage: BenchmarkTreeScan [ N [ S [ R ] ] ]
+
+/**
+ * A stream buffer that parses the decimal integers written to it,
+ * one per line, and appends them to a vector.
+ */
+class CollectingBuffer : public streambuf
+{
+  public:
+    explicit CollectingBuffer( vector<int> & out ) : items( out ), value{ 0 }, negative{ false }
+      { }
+
+  protected:
+    int overflow( int c ) override
+    {
+        if( c == '\n' )
+        {
+            items.push_back( negative ? -value : value );
+            value = 0;
+            negative = false;
+        }
+        else if( c == '-' )
+            negative = true;
+        else if( c != EOF )
+            value = 10 * value + ( c - '0' );
+        return c;
+    }
+
+  private:
+    vector<int> & items;
+    int value;
+    bool negative;
+};
+
+/**
+ * Time work( ), which returns a checksum, and print ns per item.
+ */
+void report( const string & test, const string & tree, long long ops,
+             function<long long( )> work )
+{
+    auto start = chrono::steady_clock::now( );
+    long long sum = work( );
+    auto end = chrono::steady_clock::now( );
+
+    cout << left << setw( 16 ) << test << setw( 18 ) << tree << right
+         << setw( 10 ) << fixed << setprecision( 2 )
+         << chrono::duration<double, nano>( end - start ).count( ) / ops
+         << " ns/item   " << sum << endl;
+}
+
+/**
+ * Collect the items of t in sorted order through printTree.
+ */
+template <typename Tree>
+void collect( const Tree & t, vector<int> & items )
+{
+    items.clear( );
+    CollectingBuffer buffer{ items };
+    streambuf *old = cout.rdbuf( &buffer );
+    t.printTree( );
+    cout.rdbuf( old );
+}
+
+/**
+ * Run the four scans on t.
+ */
+template <typename Tree>
+void scans( const string & name, const Tree & t, int n, const vector<int> & starts,
+            int scanLength, int recursiveScans )
+{
+    report( "full iterator", name, n, [ & ] {
+        long long sum = 0;
+        for( int x : t )
+            sum += x;
+        return sum; } );
+    report( "full recursive", name, n, [ & ] {
+        vector<int> items;
+        collect( t, items );
+        long long sum = 0;
+        for( int x : items )
+            sum += x;
+        return sum; } );
+
+    report( "range iterator", name, (long long) starts.size( ) * scanLength, [ & ] {
+        long long sum = 0;
+        for( int s : starts )
+        {
+            auto itr = t.lower_bound( s );
+            for( int i = 0; i < scanLength && itr != t.end( ); ++i, ++itr )
+                sum += *itr;
+        }
+        return sum; } );
+    report( "range recursive", name, (long long) recursiveScans * scanLength, [ & ] {
+        long long sum = 0;
+        vector<int> items;
+        for( int j = 0; j < recursiveScans; ++j )
+        {
+            collect( t, items );
+            auto itr = std::lower_bound( items.begin( ), items.end( ), starts[ j ] );
+            for( int i = 0; i < scanLength && itr != items.end( ); ++i, ++itr )
+                sum += *itr;
+        }
+        return sum; } );
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    int scanLength = argc > 2 ? atoi( argv[ 2 ] ) : 100;
+    int recursiveScans = argc > 3 ? atoi( argv[ 3 ] ) : 10;
+
+    UniformRandom r{ 4242 };
+    vector<int> keys( n );
+    for( int i = 0; i < n; ++i )
+        keys[ i ] = 2 * i;
+    for( int i = n - 1; i > 0; --i )
+        swap( keys[ i ], keys[ r.nextInt( i + 1 ) ] );
+    vector<int> starts( max( recursiveScans, n / scanLength ) );
+    for( auto & s : starts )
+        s = r.nextInt( 2 * n );
+
+    cout << n << " keys, range scans of " << scanLength << " items" << endl;
+    {
+        BinarySearchTree<int> t;
+        for( int k : keys )
+            t.insert( k );
+        scans( "BinarySearchTree", t, n, starts, scanLength, recursiveScans );
+    }
+    {
+        AvlTree<int> t;
+        for( int k : keys )
+            t.insert( k );
+        scans( "AvlTree", t, n, starts, scanLength, recursiveScans );
+    }
+
+    return 0;
+}
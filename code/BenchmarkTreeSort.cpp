@@ -0,0 +1,82 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include "TreeSort.h"
+#include "Sort.h"
+#include "UniformRandom.h"
+using namespace std;
+
+// Time tree sort in each of its modes against Sort.h's mergeSort
+// and quicksort, on N ints that are
+//     sorted       0, 1, ..., N - 1
+//     random       a random permutation of 0 .. N - 1
+//     duplicates   random keys from [ 0, D )
+// Printed are ns per item; every result is checked.
+//
+// Usage: BenchmarkTreeSort [ N [ D ] ]
+
+/**
+ * Sort a copy of input with sortFunction, print the time per item,
+ * and check the result against expected.
+ */
+void report( const string & name, const vector<int> & input, const vector<int> & expected,
+             function<void( vector<int> & )> sortFunction )
+{
+    vector<int> a = input;
+    auto start = chrono::steady_clock::now( );
+    sortFunction( a );
+    auto end = chrono::steady_clock::now( );
+
+    cout << "  " << left << setw( 20 ) << name << right << setw( 10 ) << fixed
+         << setprecision( 1 )
+         << chrono::duration<double, nano>( end - start ).count( ) / input.size( )
+         << " ns/item" << ( a == expected ? "" : "   WRONG" ) << endl;
+}
+
+void runAll( const string & inputName, const vector<int> & input )
+{
+    vector<int> expected = input;
+    std::sort( expected.begin( ), expected.end( ) );
+
+    cout << inputName << endl;
+    report( "treeSort AVL", input, expected,
+            [ ]( vector<int> & a ) { treeSort( a, TreeSortMode::AVL ); } );
+    report( "treeSort RED_BLACK", input, expected,
+            [ ]( vector<int> & a ) { treeSort( a, TreeSortMode::RED_BLACK ); } );
+    report( "treeSort TREAP", input, expected,
+            [ ]( vector<int> & a ) { treeSort( a, TreeSortMode::TREAP ); } );
+    report( "treeSort COUNTED", input, expected,
+            [ ]( vector<int> & a ) { treeSort( a, TreeSortMode::COUNTED ); } );
+    report( "mergeSort", input, expected,
+            [ ]( vector<int> & a ) { mergeSort( a ); } );
+    report( "quicksort", input, expected,
+            [ ]( vector<int> & a ) { quicksort( a ); } );
+}
+
+int main( int argc, char *argv[ ] )
+{
+    int n = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+    int d = argc > 2 ? atoi( argv[ 2 ] ) : 100;
+
+    UniformRandom r{ 2718 };
+    vector<int> sorted( n );
+    for( int i = 0; i < n; ++i )
+        sorted[ i ] = i;
+    vector<int> shuffled = sorted;
+    for( int i = n - 1; i > 0; --i )
+        swap( shuffled[ i ], shuffled[ r.nextInt( i + 1 ) ] );
+    vector<int> duplicates( n );
+    for( auto & x : duplicates )
+        x = r.nextInt( d );
+
+    cout << n << " items" << endl;
+    runAll( "sorted", sorted );
+    runAll( "random", shuffled );
+    runAll( "duplicates from [ 0, " + to_string( d ) + " )", duplicates );
+
+    return 0;
+}
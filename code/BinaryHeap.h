@@ -15,6 +15,7 @@ using namespace std;
 // Comparable findMin( )  --> Return smallest item
 // bool isEmpty( )        --> Return true if empty; else false
 // void makeEmpty( )      --> Remove all items
+// void merge( rhs )      --> Absorb rhs into this heap
 // ******************ERRORS********************************
 // Throws UnderflowException as warranted
 
@@ -113,6 +114,34 @@ class BinaryHeap
     void makeEmpty( )
       { currentSize = 0; }
 
+    /**
+     * Merge rhs into the priority queue.
+     * rhs becomes empty. rhs must be different from this.
+     * A small rhs is inserted item by item; otherwise the items
+     * are appended and the heap is rebuilt with buildHeap,
+     * which is linear in the combined size.
+     */
+    void merge( BinaryHeap & rhs )
+    {
+        if( this == &rhs )    // Avoid aliasing problems
+            return;
+
+        if( 4 * rhs.currentSize < currentSize )
+        {
+            for( int i = 1; i <= rhs.currentSize; ++i )
+                insert( std::move( rhs.array[ i ] ) );
+            rhs.currentSize = 0;
+            return;
+        }
+
+        if( currentSize + rhs.currentSize >= array.size( ) )
+            array.resize( 2 * ( currentSize + rhs.currentSize ) + 1 );
+        for( int i = 1; i <= rhs.currentSize; ++i )
+            array[ ++currentSize ] = std::move( rhs.array[ i ] );
+        rhs.currentSize = 0;
+        buildHeap( );
+    }
+
   private:
     int                currentSize;  // Number of elements in heap
     vector<Comparable> array;        // The heap array
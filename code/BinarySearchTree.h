@@ -2,7 +2,10 @@
 #define BINARY_SEARCH_TREE_H
 
 #include "dsexceptions.h"
+#include "EytzingerSet.h"
 #include <algorithm>
+#include <iterator>
+#include <utility>
 using namespace std;       
 
 // BinarySearchTree class
@@ -18,13 +21,120 @@ using namespace std;
 // boolean isEmpty( )     --> Return true if empty; else false
 // void makeEmpty( )      --> Remove all items
 // void printTree( )      --> Print tree in sorted order
+// const_iterator begin( ), end( )
+//                        --> Bidirectional in-order iteration
+// const_iterator lower_bound( x )
+//                        --> First item not less than x
+// const_iterator upper_bound( x )
+//                        --> First item greater than x
+// pair equal_range( x )  --> Iterators bounding the items equal to x
+// pair range( lo, hi )   --> Iterators bounding the items in [ lo, hi ]
+// EytzingerSet freeze( ) --> Return a read-only copy for fast lookups
 // ******************ERRORS********************************
 // Throws UnderflowException as warranted
+// Throws IteratorOutOfBoundsException if an iterator moves
+//     beyond begin( ) or end( )
 
 template <typename Comparable>
 class BinarySearchTree
 {
+    struct BinaryNode;
+
   public:
+    /**
+     * In-order iterator. Each step follows child and parent links,
+     * so a full scan takes linear time and no stack.
+     * Removing an item invalidates iterators to it.
+     */
+    class const_iterator
+    {
+      public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type        = Comparable;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const Comparable *;
+        using reference         = const Comparable &;
+
+        const_iterator( ) : tree{ nullptr }, current{ nullptr }
+          { }
+
+        const Comparable & operator* ( ) const
+          { return current->element; }
+
+        const Comparable * operator-> ( ) const
+          { return &current->element; }
+
+        const_iterator & operator++ ( )
+        {
+            if( current == nullptr )
+                throw IteratorOutOfBoundsException{ };
+            if( current->right != nullptr )
+                current = tree->findMin( current->right );
+            else
+            {
+                const BinaryNode *child;
+                do
+                {
+                    child = current;
+                    current = current->parent;
+                } while( current != nullptr && child == current->right );
+            }
+            return *this;
+        }
+
+        const_iterator operator++ ( int )
+        {
+            const_iterator old = *this;
+            ++( *this );
+            return old;
+        }
+
+        const_iterator & operator-- ( )
+        {
+            const BinaryNode *p = current;
+            if( p == nullptr )
+                p = tree->findMax( tree->root );
+            else if( p->left != nullptr )
+                p = tree->findMax( p->left );
+            else
+            {
+                const BinaryNode *child;
+                do
+                {
+                    child = p;
+                    p = p->parent;
+                } while( p != nullptr && child == p->left );
+            }
+            if( p == nullptr )
+                throw IteratorOutOfBoundsException{ };
+            current = p;
+            return *this;
+        }
+
+        const_iterator operator-- ( int )
+        {
+            const_iterator old = *this;
+            --( *this );
+            return old;
+        }
+
+        bool operator== ( const const_iterator & rhs ) const
+          { return current == rhs.current; }
+
+        bool operator!= ( const const_iterator & rhs ) const
+          { return !( *this == rhs ); }
+
+      private:
+        const BinarySearchTree *tree;
+        const BinaryNode       *current;    // nullptr for end( )
+
+        const_iterator( const BinarySearchTree *t, const BinaryNode *p )
+          : tree{ t }, current{ p }
+          { }
+
+        friend class BinarySearchTree;
+    };
+
     BinarySearchTree( ) : root{ nullptr }
     {
     }
@@ -34,7 +144,7 @@ class BinarySearchTree
      */
     BinarySearchTree( const BinarySearchTree & rhs ) : root{ nullptr }
     {
-        root = clone( rhs.root );
+        root = clone( rhs.root, nullptr );
     }
 
     /**
@@ -71,6 +181,64 @@ class BinarySearchTree
         std::swap( root, rhs.root );       
         return *this;
     }
+
+    const_iterator begin( ) const
+      { return const_iterator{ this, findMin( root ) }; }
+
+    const_iterator end( ) const
+      { return const_iterator{ this, nullptr }; }
+
+    /**
+     * Return an iterator to the first item not less than x.
+     */
+    const_iterator lower_bound( const Comparable & x ) const
+    {
+        BinaryNode *bound = nullptr;
+        for( BinaryNode *t = root; t != nullptr; )
+            if( t->element < x )
+                t = t->right;
+            else
+            {
+                bound = t;
+                t = t->left;
+            }
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * Return an iterator to the first item greater than x.
+     */
+    const_iterator upper_bound( const Comparable & x ) const
+    {
+        BinaryNode *bound = nullptr;
+        for( BinaryNode *t = root; t != nullptr; )
+            if( x < t->element )
+            {
+                bound = t;
+                t = t->left;
+            }
+            else
+                t = t->right;
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * Return the iterators bounding the items equal to x,
+     * as lower_bound( x ) and upper_bound( x ).
+     */
+    pair<const_iterator, const_iterator> equal_range( const Comparable & x ) const
+    {
+        return { lower_bound( x ), upper_bound( x ) };
+    }
+
+    /**
+     * Return the iterators bounding the items in the closed range [ lo, hi ].
+     */
+    pair<const_iterator, const_iterator> range( const Comparable & lo,
+                                                const Comparable & hi ) const
+    {
+        return { lower_bound( lo ), upper_bound( hi ) };
+    }
     
     
     /**
@@ -123,6 +291,15 @@ class BinarySearchTree
             printTree( root, out );
     }
 
+    /**
+     * Return a read-only copy of the items, laid out for fast
+     * lookups; later changes to the tree do not affect it.
+     */
+    EytzingerSet<Comparable> freeze( ) const
+    {
+        return EytzingerSet<Comparable>{ begin( ), end( ) };
+    }
+
     /**
      * Make the tree logically empty.
      */
@@ -136,7 +313,7 @@ class BinarySearchTree
      */
     void insert( const Comparable & x )
     {
-        insert( x, root );
+        insert( x, root, nullptr );
     }
      
     /**
@@ -144,7 +321,7 @@ class BinarySearchTree
      */
     void insert( Comparable && x )
     {
-        insert( std::move( x ), root );
+        insert( std::move( x ), root, nullptr );
     }
     
     /**
@@ -162,12 +339,15 @@ class BinarySearchTree
         Comparable element;
         BinaryNode *left;
         BinaryNode *right;
+        BinaryNode *parent;    // nullptr for the root
 
-        BinaryNode( const Comparable & theElement, BinaryNode *lt, BinaryNode *rt )
-          : element{ theElement }, left{ lt }, right{ rt } { }
+        BinaryNode( const Comparable & theElement, BinaryNode *lt, BinaryNode *rt,
+                    BinaryNode *pt = nullptr )
+          : element{ theElement }, left{ lt }, right{ rt }, parent{ pt } { }
         
-        BinaryNode( Comparable && theElement, BinaryNode *lt, BinaryNode *rt )
-          : element{ std::move( theElement ) }, left{ lt }, right{ rt } { }
+        BinaryNode( Comparable && theElement, BinaryNode *lt, BinaryNode *rt,
+                    BinaryNode *pt = nullptr )
+          : element{ std::move( theElement ) }, left{ lt }, right{ rt }, parent{ pt } { }
     };
 
     BinaryNode *root;
@@ -177,16 +357,17 @@ class BinarySearchTree
      * Internal method to insert into a subtree.
      * x is the item to insert.
      * t is the node that roots the subtree.
+     * par is the parent of t.
      * Set the new root of the subtree.
      */
-    void insert( const Comparable & x, BinaryNode * & t )
+    void insert( const Comparable & x, BinaryNode * & t, BinaryNode *par )
     {
         if( t == nullptr )
-            t = new BinaryNode{ x, nullptr, nullptr };
+            t = new BinaryNode{ x, nullptr, nullptr, par };
         else if( x < t->element )
-            insert( x, t->left );
+            insert( x, t->left, t );
         else if( t->element < x )
-            insert( x, t->right );
+            insert( x, t->right, t );
         else
             ;  // Duplicate; do nothing
     }
@@ -195,16 +376,17 @@ class BinarySearchTree
      * Internal method to insert into a subtree.
      * x is the item to insert.
      * t is the node that roots the subtree.
+     * par is the parent of t.
      * Set the new root of the subtree.
      */
-    void insert( Comparable && x, BinaryNode * & t )
+    void insert( Comparable && x, BinaryNode * & t, BinaryNode *par )
     {
         if( t == nullptr )
-            t = new BinaryNode{ std::move( x ), nullptr, nullptr };
+            t = new BinaryNode{ std::move( x ), nullptr, nullptr, par };
         else if( x < t->element )
-            insert( std::move( x ), t->left );
+            insert( std::move( x ), t->left, t );
         else if( t->element < x )
-            insert( std::move( x ), t->right );
+            insert( std::move( x ), t->right, t );
         else
             ;  // Duplicate; do nothing
     }
@@ -232,6 +414,8 @@ class BinarySearchTree
         {
             BinaryNode *oldNode = t;
             t = ( t->left != nullptr ) ? t->left : t->right;
+            if( t != nullptr )
+                t->parent = oldNode->parent;
             delete oldNode;
         }
     }
@@ -321,14 +505,17 @@ class BinarySearchTree
     }
 
     /**
-     * Internal method to clone subtree.
+     * Internal method to clone subtree; par is the parent of the copy.
      */
-    BinaryNode * clone( BinaryNode *t ) const
+    BinaryNode * clone( BinaryNode *t, BinaryNode *par ) const
     {
         if( t == nullptr )
             return nullptr;
-        else
-            return new BinaryNode{ t->element, clone( t->left ), clone( t->right ) };
+
+        BinaryNode *copy = new BinaryNode{ t->element, nullptr, nullptr, par };
+        copy->left = clone( t->left, copy );
+        copy->right = clone( t->right, copy );
+        return copy;
     }
 };
 
@@ -0,0 +1,147 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include "dsexceptions.h"
+#include "PriorityKey.h"
+#include <vector>
+using namespace std;
+
+// BucketQueue class (Dial's algorithm)
+//
+// CONSTRUCTION: with the maximum key span C; at any time all keys
+//     in the queue lie in [ m, m + C ], where m is the last minimum.
+//     For Dijkstra's algorithm, C is the largest edge weight.
+//
+// Items are unsigned integer keys, or pairs whose first component
+// is an unsigned integer key (see PriorityKey.h).
+// The queue is monotone: an inserted key may not be smaller than the
+// key of the last item returned by findMin or deleteMin.
+//
+// ******************PUBLIC OPERATIONS*********************
+// void insert( x )       --> Insert x
+// deleteMin( minItem )   --> Remove (and optionally return) smallest item
+// Comparable findMin( )  --> Return smallest item
+// bool isEmpty( )        --> Return true if empty; else false
+// void makeEmpty( )      --> Remove all items
+// ******************ERRORS********************************
+// Throws UnderflowException as warranted
+// Throws IllegalArgumentException if insert is out of range
+
+template <typename Comparable>
+class BucketQueue
+{
+  public:
+    using Key = PriorityKeyType<Comparable>;
+
+    explicit BucketQueue( Key maxSpan )
+      : buckets( maxSpan + 1 ), currentSize{ 0 }, current{ 0 }, last{ 0 }
+    {
+    }
+
+    bool isEmpty( ) const
+      { return currentSize == 0; }
+
+    /**
+     * Find the smallest item in the priority queue.
+     * Return the smallest item, or throw Underflow if empty.
+     */
+    const Comparable & findMin( ) const
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+        advance( );
+        return buckets[ current ].back( );
+    }
+
+    /**
+     * Insert item x, allowing duplicates.
+     * Throws IllegalArgumentException if x's key is outside
+     * [ last, last + maxSpan ].
+     */
+    void insert( const Comparable & x )
+    {
+        Comparable copy = x;
+        insert( std::move( copy ) );
+    }
+
+    /**
+     * Insert item x, allowing duplicates.
+     * Throws IllegalArgumentException if x's key is outside
+     * [ last, last + maxSpan ].
+     */
+    void insert( Comparable && x )
+    {
+        Key k = priorityKey( x );
+        if( k < last || k - last >= buckets.size( ) )
+            throw IllegalArgumentException{ };
+
+        buckets[ k % buckets.size( ) ].push_back( std::move( x ) );
+        ++currentSize;
+    }
+
+    /**
+     * Remove the minimum item.
+     * Throws UnderflowException if empty.
+     */
+    void deleteMin( )
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+
+        advance( );
+        buckets[ current ].pop_back( );
+        --currentSize;
+    }
+
+    /**
+     * Remove the minimum item and place it in minItem.
+     * Throws UnderflowException if empty.
+     */
+    void deleteMin( Comparable & minItem )
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+
+        advance( );
+        minItem = std::move( buckets[ current ].back( ) );
+        buckets[ current ].pop_back( );
+        --currentSize;
+    }
+
+    /**
+     * Make the priority queue logically empty.
+     * The monotonicity bound is reset as well.
+     */
+    void makeEmpty( )
+    {
+        for( auto & b : buckets )
+            b.clear( );
+        currentSize = 0;
+        current = 0;
+        last = 0;
+    }
+
+  private:
+    vector<vector<Comparable>> buckets;  // Circular array of maxSpan + 1 buckets
+    int currentSize;                     // Number of elements in queue
+    mutable size_t current;              // Bucket holding the minimum
+    mutable Key last;                    // Key of the last minimum; equals
+                                         // current modulo buckets.size( )
+
+    /**
+     * Internal method to move current forward, circularly, to the
+     * first nonempty bucket. The queue must not be empty.
+     * Only the cursor moves, so this is logically const.
+     */
+    void advance( ) const
+    {
+        while( buckets[ current ].empty( ) )
+        {
+            if( ++current == buckets.size( ) )
+                current = 0;
+            ++last;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,160 @@
+#include "ConcurrentDisjSets.h"
+#include <thread>
+
+/**
+ * Construct the disjoint sets object.
+ * numElements is the initial number of disjoint sets.
+ */
+ConcurrentDisjSets::ConcurrentDisjSets( int numElements ) : parent( numElements )
+{
+    for( int i = 0; i < numElements; ++i )
+        parent[ i ].store( i, memory_order_relaxed );
+}
+
+/**
+ * Return the number of elements.
+ */
+int ConcurrentDisjSets::size( ) const
+{
+    return parent.size( );
+}
+
+/**
+ * Return the linking priority of x: a bijective hash, so no two
+ * elements tie and the order is unrelated to the numbering.
+ */
+unsigned ConcurrentDisjSets::priority( int x )
+{
+    unsigned h = x;
+    h ^= h >> 16;
+    h *= 0x7feb352dU;
+    h ^= h >> 15;
+    h *= 0x846ca68bU;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * Perform a find with path halving. Other threads may be
+ * linking and halving meanwhile; the result was the root
+ * of x's set at some moment during the call.
+ * Return the set containing x.
+ */
+int ConcurrentDisjSets::find( int x )
+{
+    for( ; ; )
+    {
+        int p = parent[ x ].load( memory_order_acquire );
+        int grandparent = parent[ p ].load( memory_order_acquire );
+        if( p == grandparent )
+            return p;
+        parent[ x ].compare_exchange_weak( p, grandparent, memory_order_release,
+                                           memory_order_relaxed );
+        x = grandparent;
+    }
+}
+
+/**
+ * Return true if x and y are in the same set. A root found for x
+ * may be linked under another meanwhile, so a negative answer is
+ * confirmed by checking that x's root is still a root.
+ */
+bool ConcurrentDisjSets::sameSet( int x, int y )
+{
+    for( ; ; )
+    {
+        int root1 = find( x );
+        int root2 = find( y );
+        if( root1 == root2 )
+            return true;
+        if( parent[ root1 ].load( memory_order_acquire ) == root1 )
+            return false;
+    }
+}
+
+/**
+ * Union the sets containing x and y.
+ * Return true if they were different sets, false otherwise.
+ */
+bool ConcurrentDisjSets::unite( int x, int y )
+{
+    for( ; ; )
+    {
+        x = find( x );
+        y = find( y );
+        if( x == y )
+            return false;
+        if( priority( y ) < priority( x ) )
+            swap( x, y );
+
+            // Link x, the lower priority root, under y; this fails
+            // only if x stopped being a root since its find
+        int expected = x;
+        if( parent[ x ].compare_exchange_strong( expected, y, memory_order_acq_rel ) )
+            return true;
+    }
+}
+
+/**
+ * Call work( start, end ) on consecutive blocks [ start, end ) of
+ * 0 .. n - 1, handed out to numThreads threads, this one included.
+ */
+template <typename Work>
+static void forEachBlock( long long n, int numThreads, Work work )
+{
+    const long long BLOCK = 4096;
+    atomic<long long> next{ 0 };
+
+    auto worker = [ & ]
+    {
+        for( long long start; ( start = next.fetch_add( BLOCK ) ) < n; )
+            work( start, start + BLOCK < n ? start + BLOCK : n );
+    };
+    vector<thread> threads;
+    for( int t = 1; t < numThreads; ++t )
+        threads.emplace_back( worker );
+    worker( );
+    for( auto & t : threads )
+        t.join( );
+}
+
+/**
+ * Unite the pairs edges[ 0 .. n - 1 ] on numThreads threads.
+ * Return the number of unions that merged two sets.
+ */
+long long ConcurrentDisjSets::parallelUnite( const pair<int, int> *edges, long long n,
+                                             int numThreads )
+{
+    atomic<long long> merges{ 0 };
+    forEachBlock( n, numThreads, [ & ]( long long start, long long end )
+    {
+        long long merged = 0;
+        for( long long e = start; e < end; ++e )
+            merged += unite( edges[ e ].first, edges[ e ].second );
+        merges += merged;
+    } );
+    return merges;
+}
+
+/**
+ * Label every element with the root of its set, on numThreads
+ * threads; no unions may run meanwhile. Elements are in the
+ * same set iff their labels are equal.
+ * Return the number of sets.
+ */
+int ConcurrentDisjSets::components( vector<int> & labels, int numThreads )
+{
+    labels.resize( parent.size( ) );
+    atomic<int> roots{ 0 };
+    forEachBlock( parent.size( ), numThreads, [ & ]( long long start, long long end )
+    {
+        int count = 0;
+        for( int x = start; x < end; ++x )
+        {
+            labels[ x ] = find( x );
+            count += labels[ x ] == x;
+        }
+        roots += count;
+    } );
+    return roots;
+}
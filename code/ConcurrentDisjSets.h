@@ -0,0 +1,64 @@
+#ifndef CONCURRENT_DISJ_SETS_H
+#define CONCURRENT_DISJ_SETS_H
+
+// ConcurrentDisjSets class
+//
+// CONSTRUCTION: with int representing initial number of sets
+//
+// Disjoint sets that any number of threads may use at once, without
+// locks. Each element holds an atomic parent; a root is its own
+// parent. unite links one root under the other with a single
+// compare-and-swap, retrying from the new roots if another thread got
+// there first. Which root goes under is decided by a fixed random
+// priority per element (a hash of it), so trees stay shallow whatever
+// the order of the unions. find halves the path with compare-and-swaps
+// that only move an element's parent closer to its root, so a failed
+// one is simply skipped and finds never wait.
+//
+// ******************PUBLIC OPERATIONS*********************
+// bool unite( x, y )         --> Merge the sets containing x and y;
+//                                return false if already the same set
+// int find( x )              --> Return set containing x
+// bool sameSet( x, y )       --> Return true if x and y are in one set
+// int size( )                --> Return number of elements
+// long long parallelUnite( edges, n, numThreads )
+//                            --> unite( e.first, e.second ) for the n
+//                                pairs in edges; return the merges
+// int components( labels, numThreads )
+//                            --> Set labels[ x ] to x's root, and
+//                                return the number of sets
+// The parallel operations split the work among numThreads threads,
+// this one included (compile with -pthread).
+// ******************ERRORS********************************
+// No error checking is performed
+
+#include <atomic>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/**
+ * Concurrent disjoint set class.
+ * Use linking by random priority and path halving.
+ * Elements in the set are numbered starting at 0.
+ */
+class ConcurrentDisjSets
+{
+  public:
+    explicit ConcurrentDisjSets( int numElements );
+
+    int find( int x );
+    bool sameSet( int x, int y );
+    bool unite( int x, int y );
+    int size( ) const;
+
+    long long parallelUnite( const pair<int, int> *edges, long long n, int numThreads );
+    int components( vector<int> & labels, int numThreads );
+
+  private:
+    vector<atomic<int>> parent;
+
+    static unsigned priority( int x );
+};
+
+#endif
@@ -0,0 +1,560 @@
+#ifndef CONCURRENT_SKIP_LIST_H
+#define CONCURRENT_SKIP_LIST_H
+
+#include "dsexceptions.h"
+#include "UniformRandom.h"
+#include <atomic>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// ConcurrentSkipList class
+//
+// CONSTRUCTION: with an optional seed for the level generator
+//
+// A sorted set that any number of threads may use at once: the lazy
+// skip list of Herlihy, Lev, Luchangco and Shavit. contains, findMin
+// and iteration take no locks. insert and remove lock only the
+// predecessors of the changed node, after checking that nothing
+// changed since the search; on a conflict they search again.
+// remove marks a node before unlinking it, so readers skip it.
+//
+// Node levels come from SHARDS random streams that belong to the list,
+// all seeded from its seed; each thread uses one stream, so a list
+// built by one thread is reproducible from its seed.
+//
+// Removed nodes are freed by epoch-based reclamation. Each operation,
+// and each live iterator from begin or lower_bound, counts itself as
+// active in the epoch (0 or 1) current when it started, on a per-thread
+// shard of the counter. A removed node is retired into the list of the
+// current epoch. Once RECLAIM_BATCH nodes wait there, the epoch flips,
+// and when nothing is active in the old epoch, none of its retired
+// nodes can be reached, so they are freed. At most about
+// 2 * RECLAIM_BATCH removed nodes are held, plus those retired while
+// an iterator stays alive: a long-lived iterator delays reclamation.
+//
+// ******************PUBLIC OPERATIONS*********************
+// bool insert( x )       --> Insert x; return false if present
+// bool remove( x )       --> Remove x; return false if not present
+// bool contains( x )     --> Return true if x is present
+// Comparable findMin( )  --> Return smallest item
+// bool isEmpty( )        --> Return true if empty; else false
+// void makeEmpty( )      --> Remove all items (not concurrently)
+// void printTree( )      --> Print list in sorted order
+// const_iterator begin( ), end( )
+//                        --> Forward iteration in sorted order
+// const_iterator lower_bound( x )
+//                        --> First item not less than x
+// ******************ERRORS********************************
+// Throws UnderflowException as warranted
+// Iterators see every item present for the whole scan, and
+// may or may not see items inserted or removed during it
+
+template <typename Comparable>
+class ConcurrentSkipList
+{
+    struct SkipNode;
+
+  public:
+    /**
+     * Forward iterator over the items, in sorted order.
+     */
+    class const_iterator
+    {
+      public:
+        using iterator_category = forward_iterator_tag;
+        using value_type        = Comparable;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const Comparable *;
+        using reference         = const Comparable &;
+
+        const_iterator( ) : current{ nullptr }, tail{ nullptr }, list{ nullptr }
+          { }
+
+        const_iterator( const const_iterator & rhs )
+          : current{ rhs.current }, tail{ rhs.tail }, list{ rhs.list }, epoch{ rhs.epoch }
+        {
+            if( list != nullptr )
+                list->enter( epoch );
+        }
+
+        ~const_iterator( )
+        {
+            if( list != nullptr )
+                list->leave( epoch );
+        }
+
+        const_iterator & operator= ( const const_iterator & rhs )
+        {
+            const_iterator copy = rhs;
+            std::swap( current, copy.current );
+            std::swap( tail, copy.tail );
+            std::swap( list, copy.list );
+            std::swap( epoch, copy.epoch );
+            return *this;
+        }
+
+        const Comparable & operator* ( ) const
+        {
+            if( current == tail )
+                throw IteratorOutOfBoundsException{ };
+            return current->element;
+        }
+
+        const Comparable * operator-> ( ) const
+          { return &**this; }
+
+        const_iterator & operator++ ( )
+        {
+            if( current == tail )
+                throw IteratorOutOfBoundsException{ };
+            current = skipRemoved( current->next[ 0 ], tail );
+            return *this;
+        }
+
+        const_iterator operator++ ( int )
+        {
+            const_iterator old = *this;
+            ++( *this );
+            return old;
+        }
+
+        bool operator== ( const const_iterator & rhs ) const
+          { return current == rhs.current; }
+
+        bool operator!= ( const const_iterator & rhs ) const
+          { return !( *this == rhs ); }
+
+      private:
+        SkipNode *current;
+        SkipNode *tail;
+        const ConcurrentSkipList *list;    // Keeps its nodes from being freed;
+        int epoch;                         //   nullptr for end( )
+
+        const_iterator( SkipNode *p, SkipNode *t ) : current{ p }, tail{ t }, list{ nullptr }
+          { }
+
+            // Takes over the active count of guard
+        const_iterator( SkipNode *p, SkipNode *t, const ConcurrentSkipList *l, int e )
+          : current{ p }, tail{ t }, list{ l }, epoch{ e }
+          { }
+
+        friend class ConcurrentSkipList;
+    };
+
+    explicit ConcurrentSkipList( int seed = currentTimeSeconds( ) )
+      : head{ new SkipNode{ Comparable{ }, MAX_LEVEL - 1 } },
+        tail{ new SkipNode{ Comparable{ }, MAX_LEVEL - 1 } }, theEpoch{ 0 }
+    {
+        for( int level = 0; level < MAX_LEVEL; ++level )
+            head->next[ level ] = tail;
+        head->fullyLinked = tail->fullyLinked = true;
+
+        UniformRandom seeds{ seed };
+        for( Shard & s : shards )
+        {
+            s.levelBits = seeds.nextInt( ) | (uint64_t) seeds.nextInt( ) << 32;
+            s.active[ 0 ] = s.active[ 1 ] = 0;
+        }
+    }
+
+    ConcurrentSkipList( const ConcurrentSkipList & rhs ) = delete;
+    ConcurrentSkipList & operator=( const ConcurrentSkipList & rhs ) = delete;
+
+    ~ConcurrentSkipList( )
+    {
+        makeEmpty( );
+        delete head;
+        delete tail;
+    }
+
+    const_iterator begin( ) const
+    {
+        int e = enter( );
+        return const_iterator{ skipRemoved( head->next[ 0 ], tail ), tail, this, e };
+    }
+
+    const_iterator end( ) const
+      { return const_iterator{ tail, tail }; }
+
+    /**
+     * Return an iterator to the first item not less than x.
+     */
+    const_iterator lower_bound( const Comparable & x ) const
+    {
+        SkipNode *preds[ MAX_LEVEL ];
+        SkipNode *succs[ MAX_LEVEL ];
+        int e = enter( );
+        find( x, preds, succs );
+        return const_iterator{ skipRemoved( succs[ 0 ], tail ), tail, this, e };
+    }
+
+    /**
+     * Returns true if x is found.
+     */
+    bool contains( const Comparable & x ) const
+    {
+        Operation op{ this };
+        SkipNode *preds[ MAX_LEVEL ];
+        SkipNode *succs[ MAX_LEVEL ];
+        int levelFound = find( x, preds, succs );
+        return levelFound != -1 && succs[ levelFound ]->fullyLinked
+               && !succs[ levelFound ]->marked;
+    }
+
+    /**
+     * Find the smallest item.
+     * Throw UnderflowException if empty.
+     */
+    Comparable findMin( ) const
+    {
+        Operation op{ this };
+        SkipNode *first = skipRemoved( head->next[ 0 ], tail );
+        if( first == tail )
+            throw UnderflowException{ };
+        return first->element;
+    }
+
+    bool isEmpty( ) const
+    {
+        Operation op{ this };
+        return skipRemoved( head->next[ 0 ], tail ) == tail;
+    }
+
+    void printTree( ) const
+    {
+        if( isEmpty( ) )
+            cout << "Empty tree" << endl;
+        else
+            for( auto & x : *this )
+                cout << x << endl;
+    }
+
+    /**
+     * Insert x; return false if x is already present.
+     */
+    bool insert( const Comparable & x )
+    {
+        Operation op{ this };
+        int topLevel = randomLevel( );
+        SkipNode *preds[ MAX_LEVEL ];
+        SkipNode *succs[ MAX_LEVEL ];
+
+        for( ; ; )
+        {
+            int levelFound = find( x, preds, succs );
+            if( levelFound != -1 )
+            {
+                SkipNode *found = succs[ levelFound ];
+                if( !found->marked )
+                {
+                    while( !found->fullyLinked )    // Being inserted; wait for it
+                        this_thread::yield( );
+                    return false;
+                }
+                continue;    // Being removed; try again
+            }
+
+            int highestLocked = -1;
+            bool valid = true;
+            for( int level = 0; valid && level <= topLevel; ++level )
+            {
+                SkipNode *pred = preds[ level ];
+                SkipNode *succ = succs[ level ];
+                if( level == 0 || pred != preds[ level - 1 ] )
+                    pred->lock.lock( );
+                highestLocked = level;
+                valid = !pred->marked && !succ->marked && pred->next[ level ] == succ;
+            }
+            if( valid )
+            {
+                SkipNode *newNode = new SkipNode{ x, topLevel };
+                for( int level = 0; level <= topLevel; ++level )
+                    newNode->next[ level ] = succs[ level ];
+                for( int level = 0; level <= topLevel; ++level )
+                    preds[ level ]->next[ level ] = newNode;
+                newNode->fullyLinked = true;
+            }
+            unlock( preds, highestLocked );
+            if( valid )
+                return true;
+        }
+    }
+
+    /**
+     * Remove x; return false if x is not present.
+     */
+    bool remove( const Comparable & x )
+    {
+        Operation op{ this };
+        SkipNode *victim = nullptr;
+        bool isMarked = false;
+        int topLevel = -1;
+        SkipNode *preds[ MAX_LEVEL ];
+        SkipNode *succs[ MAX_LEVEL ];
+
+        for( ; ; )
+        {
+            int levelFound = find( x, preds, succs );
+            if( levelFound != -1 )
+                victim = succs[ levelFound ];
+            if( !isMarked && !( levelFound != -1 && victim->fullyLinked
+                                && victim->topLevel == levelFound && !victim->marked ) )
+                return false;
+
+            if( !isMarked )
+            {
+                topLevel = victim->topLevel;
+                victim->lock.lock( );
+                if( victim->marked )    // Another remove won
+                {
+                    victim->lock.unlock( );
+                    return false;
+                }
+                victim->marked = true;
+                isMarked = true;
+            }
+
+            int highestLocked = -1;
+            bool valid = true;
+            for( int level = 0; valid && level <= topLevel; ++level )
+            {
+                SkipNode *pred = preds[ level ];
+                if( level == 0 || pred != preds[ level - 1 ] )
+                    pred->lock.lock( );
+                highestLocked = level;
+                valid = !pred->marked && pred->next[ level ] == victim;
+            }
+            if( valid )
+            {
+                for( int level = topLevel; level >= 0; --level )
+                    preds[ level ]->next[ level ] = victim->next[ level ].load( );
+                victim->lock.unlock( );
+            }
+            unlock( preds, highestLocked );
+            if( valid )
+            {
+                retire( victim );
+                return true;
+            }
+        }
+    }
+
+    /**
+     * Remove all items and free the removed nodes.
+     * No other thread may use the list meanwhile.
+     */
+    void makeEmpty( )
+    {
+        SkipNode *p = head->next[ 0 ];
+        while( p != tail )
+        {
+            SkipNode *next = p->next[ 0 ];
+            delete p;
+            p = next;
+        }
+        for( int level = 0; level < MAX_LEVEL; ++level )
+            head->next[ level ] = tail;
+        for( vector<SkipNode *> & r : retired )
+        {
+            for( SkipNode *p : r )
+                delete p;
+            r.clear( );
+        }
+    }
+
+  private:
+    static const int MAX_LEVEL = 32;
+    static const int SHARDS = 16;
+    static const size_t RECLAIM_BATCH = 256;
+
+    struct SkipNode
+    {
+        Comparable element;
+        int topLevel;                   // Linked at levels 0 .. topLevel
+        atomic<SkipNode *> *next;
+        atomic<bool> marked;            // Logically removed
+        atomic<bool> fullyLinked;       // Linked at every level
+        mutex lock;
+
+        SkipNode( const Comparable & theElement, int top )
+          : element{ theElement }, topLevel{ top }, next{ new atomic<SkipNode *>[ top + 1 ] },
+            marked{ false }, fullyLinked{ false } { }
+
+        ~SkipNode( )
+          { delete [ ] next; }
+    };
+
+    /**
+     * The per-thread state of the list, one cache line each.
+     */
+    struct alignas( 64 ) Shard
+    {
+        atomic<uint64_t> levelBits;     // Random stream for node levels
+        mutable atomic<int> active[ 2 ];    // Operations and iterators, by epoch
+    };
+
+    /**
+     * Counts one operation as active for its lifetime.
+     */
+    class Operation
+    {
+      public:
+        explicit Operation( const ConcurrentSkipList *l ) : list{ l }, epoch{ l->enter( ) }
+          { }
+
+        ~Operation( )
+          { list->leave( epoch ); }
+
+        Operation( const Operation & rhs ) = delete;
+        Operation & operator=( const Operation & rhs ) = delete;
+
+      private:
+        const ConcurrentSkipList *list;
+        int epoch;
+    };
+
+    SkipNode *head;
+    SkipNode *tail;
+
+    Shard shards[ SHARDS ];
+    atomic<int> theEpoch;
+    vector<SkipNode *> retired[ 2 ];    // Unlinked in each epoch, maybe still being read
+    mutex retiredLock;
+
+    /**
+     * Search for x. Fill preds and succs with the last node before x and
+     * the first node not before x on each level. Return the highest
+     * level on which x was found, or -1.
+     */
+    int find( const Comparable & x, SkipNode *preds[ ], SkipNode *succs[ ] ) const
+    {
+        int levelFound = -1;
+        SkipNode *pred = head;
+        for( int level = MAX_LEVEL - 1; level >= 0; --level )
+        {
+            SkipNode *curr = pred->next[ level ];
+            while( curr != tail && curr->element < x )
+            {
+                pred = curr;
+                curr = pred->next[ level ];
+            }
+            if( levelFound == -1 && curr != tail && !( x < curr->element ) )
+                levelFound = level;
+            preds[ level ] = pred;
+            succs[ level ] = curr;
+        }
+        return levelFound;
+    }
+
+    /**
+     * Return p, or the first node after it, that is present.
+     */
+    static SkipNode * skipRemoved( SkipNode *p, SkipNode *tail )
+    {
+        while( p != tail && ( p->marked || !p->fullyLinked ) )
+            p = p->next[ 0 ];
+        return p;
+    }
+
+    /**
+     * Unlock preds[ 0 .. highestLocked ], each node once.
+     */
+    static void unlock( SkipNode *preds[ ], int highestLocked )
+    {
+        for( int level = 0; level <= highestLocked; ++level )
+            if( level == 0 || preds[ level ] != preds[ level - 1 ] )
+                preds[ level ]->lock.unlock( );
+    }
+
+    /**
+     * Return the shard of the calling thread; threads take them in turn.
+     */
+    static int shard( )
+    {
+        static atomic<int> nextShard{ 0 };
+        thread_local int s = nextShard++ % SHARDS;
+        return s;
+    }
+
+    /**
+     * Return a level from 0 to MAX_LEVEL - 1; level k with probability 2^-(k+1).
+     * Takes the next value of the thread's stream, a SplitMix64 sequence.
+     */
+    int randomLevel( )
+    {
+        uint64_t z = shards[ shard( ) ].levelBits += 0x9E3779B97F4A7C15;
+        z = ( z ^ z >> 30 ) * 0xBF58476D1CE4E5B9;
+        z = ( z ^ z >> 27 ) * 0x94D049BB133111EB;
+        unsigned int bits = z ^ z >> 31;
+        return __builtin_ctz( ~bits | ( 1u << ( MAX_LEVEL - 1 ) ) );
+    }
+
+    /**
+     * Count the caller as active in the current epoch, and return it.
+     * The epoch is checked again after counting, so a flip in between
+     * cannot go unnoticed.
+     */
+    int enter( ) const
+    {
+        atomic<int> *active = shards[ shard( ) ].active;
+        for( ; ; )
+        {
+            int e = theEpoch;
+            ++active[ e ];
+            if( theEpoch == e )
+                return e;
+            --active[ e ];
+        }
+    }
+
+    /**
+     * Count the caller as active once more in epoch e, which it already is.
+     */
+    void enter( int e ) const
+      { ++shards[ shard( ) ].active[ e ]; }
+
+    void leave( int e ) const
+      { --shards[ shard( ) ].active[ e ]; }
+
+    /**
+     * Return the number of operations and iterators active in epoch e.
+     */
+    int activeIn( int e ) const
+    {
+        int count = 0;
+        for( const Shard & s : shards )
+            count += s.active[ e ];
+        return count;
+    }
+
+    /**
+     * Retire the unlinked node p, and reclaim what is safe to.
+     * Nodes retired in the other epoch are freed once nothing is active
+     * in it: all that could still reach them started before they were
+     * unlinked, so in that epoch or before the flip that ended it.
+     * Then, if enough nodes are waiting, flip to the other epoch.
+     */
+    void retire( SkipNode *p )
+    {
+        vector<SkipNode *> freed;
+        {
+            lock_guard<mutex> guard{ retiredLock };
+            int e = theEpoch;
+            retired[ e ].push_back( p );
+            if( activeIn( 1 - e ) == 0 )
+            {
+                freed.swap( retired[ 1 - e ] );
+                if( retired[ e ].size( ) >= RECLAIM_BATCH )
+                    theEpoch = 1 - e;
+            }
+        }
+        for( SkipNode *q : freed )
+            delete q;
+    }
+};
+
+#endif
@@ -1,10 +1,13 @@
 #include "DisjSets.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 
 /**
  * Construct the disjoint sets object.
  * numElements is the initial number of disjoint sets.
  */
-DisjSets::DisjSets( int numElements ) : s( numElements, -1 )
+DisjSets::DisjSets( int numElements ) : s( numElements, -1 ), theNumSets{ numElements }
 {
 }
 
@@ -17,14 +20,194 @@ DisjSets::DisjSets( int numElements ) : s( numElements, -1 )
  */
 void DisjSets::unionSets( int root1, int root2 )
 {
-    if( s[ root2 ] < s[ root1 ] )  // root2 is deeper
+    if( s[ root2 ] < s[ root1 ] )  // root2 is bigger
+    {
+        s[ root2 ] += s[ root1 ];  // Add up the sizes
         s[ root1 ] = root2;        // Make root2 new root
+    }
     else
     {
-        if( s[ root1 ] == s[ root2 ] )
-            --s[ root1 ];          // Update height if same
+        s[ root1 ] += s[ root2 ];
         s[ root2 ] = root1;        // Make root1 new root
     }
+    --theNumSets;
+}
+
+/**
+ * Union the sets containing x and y.
+ * Return true if they were different sets, false otherwise.
+ */
+bool DisjSets::unite( int x, int y )
+{
+    int root1 = find( x );
+    int root2 = find( y );
+    if( root1 == root2 )
+        return false;
+    unionSets( root1, root2 );
+    return true;
+}
+
+/**
+ * Return the number of elements in the set containing x.
+ */
+int DisjSets::setSize( int x )
+{
+    return -s[ find( x ) ];
+}
+
+/**
+ * Return the number of disjoint sets.
+ */
+int DisjSets::numSets( ) const
+{
+    return theNumSets;
+}
+
+/**
+ * Add a new element in a set by itself.
+ * The array grows by doubling, so this is amortized constant time.
+ * Return the new element.
+ */
+int DisjSets::makeSet( )
+{
+    s.push_back( -1 );
+    ++theNumSets;
+    return s.size( ) - 1;
+}
+
+/**
+ * Return the number of elements.
+ */
+int DisjSets::size( ) const
+{
+    return s.size( );
+}
+
+/**
+ * Number the sets 0 .. numSets( ) - 1, in order of their smallest
+ * elements, and set labels[ x ] to the number of x's set. In the same
+ * pass every element is linked straight to its root.
+ * Return the number of sets.
+ */
+int DisjSets::compact( vector<int> & labels )
+{
+    labels.assign( s.size( ), -1 );
+    int next = 0;
+    for( int x = 0; x < (int) s.size( ); ++x )
+    {
+        int root = find( x );
+        if( root != x )
+            s[ x ] = root;
+        if( labels[ root ] < 0 )
+            labels[ root ] = next++;
+        labels[ x ] = labels[ root ];
+    }
+    return next;
+}
+
+static const char SAVE_MAGIC[ 8 ] = { 'D', 'i', 's', 'j', 'S', 'e', 't', '1' };
+
+/**
+ * Write the sets to filename, in the format described in DisjSets.h.
+ * Return false if the file cannot be written.
+ */
+bool DisjSets::save( const string & filename ) const
+{
+    ofstream out( filename, ios::binary );
+    int64_t header[ 2 ] = { (int64_t) s.size( ), theNumSets };
+    out.write( SAVE_MAGIC, sizeof( SAVE_MAGIC ) );
+    out.write( reinterpret_cast<const char *>( header ), sizeof( header ) );
+    out.write( reinterpret_cast<const char *>( s.data( ) ), s.size( ) * sizeof( int ) );
+    out.close( );
+    return !out.fail( );
+}
+
+/**
+ * Return true if entries is a forest of n = entries.size( ) elements
+ * with numSets trees, in the representation of s: every parent in
+ * 0 .. n - 1, no cycles, and every root holding minus the size of
+ * its tree. Takes O( n ) time; each element is walked up from once.
+ */
+static bool isValidForest( const vector<int> & entries, int64_t numSets )
+{
+    const int UNSEEN = -1, ON_PATH = -2;
+    int n = entries.size( );
+    vector<int> rootOf( n, UNSEEN );
+    vector<int> treeSize( n, 0 );
+    int64_t roots = 0;
+
+    for( int i = 0; i < n; ++i )
+    {
+        int e = entries[ i ];
+        if( e < -n || e >= n || e == i )   // e == 0 is not a root
+            return false;
+        roots += e < 0;
+    }
+    if( roots != numSets )
+        return false;
+
+    for( int i = 0; i < n; ++i )
+    {
+            // Walk up to a root, or to an element whose root is known
+        int x = i;
+        while( rootOf[ x ] == UNSEEN && entries[ x ] >= 0 )
+        {
+            rootOf[ x ] = ON_PATH;
+            x = entries[ x ];
+        }
+        if( rootOf[ x ] == ON_PATH )
+            return false;       // Back on this walk: a cycle
+        int root = entries[ x ] < 0 ? x : rootOf[ x ];
+
+        for( x = i; rootOf[ x ] == ON_PATH || rootOf[ x ] == UNSEEN; x = entries[ x ] )
+        {
+            rootOf[ x ] = root;
+            if( x == root )
+                break;
+        }
+        ++treeSize[ root ];
+    }
+
+    for( int i = 0; i < n; ++i )
+        if( entries[ i ] < 0 && -entries[ i ] != treeSize[ i ] )
+            return false;
+    return true;
+}
+
+/**
+ * Replace the sets with those saved in filename.
+ * Return false, leaving the sets unchanged, if the file cannot be
+ * read or is not a valid saved DisjSets: wrong magic or sizes,
+ * missing or trailing bytes, or entries that are not a forest of
+ * the saved number of sets with correct sizes at the roots.
+ */
+bool DisjSets::load( const string & filename )
+{
+    ifstream in( filename, ios::binary );
+    char magic[ sizeof( SAVE_MAGIC ) ];
+    int64_t header[ 2 ];
+    in.read( magic, sizeof( magic ) );
+    in.read( reinterpret_cast<char *>( header ), sizeof( header ) );
+    if( !in || memcmp( magic, SAVE_MAGIC, sizeof( magic ) ) != 0
+        || header[ 0 ] < 0 || header[ 0 ] > INT32_MAX
+        || header[ 1 ] < 0 || header[ 1 ] > header[ 0 ] )
+        return false;
+
+        // Check the file holds the claimed entries before allocating them
+    streampos start = in.tellg( );
+    in.seekg( 0, ios::end );
+    streamoff remaining = in.tellg( ) - start;
+    in.seekg( start );
+    if( !in || remaining < 0 || header[ 0 ] > remaining / int64_t( sizeof( int ) ) )
+        return false;
+
+    vector<int> entries( header[ 0 ] );
+    in.read( reinterpret_cast<char *>( entries.data( ) ), entries.size( ) * sizeof( int ) );
+    if( !in || in.peek( ) != EOF || !isValidForest( entries, header[ 1 ] ) )
+        return false;
+    s = std::move( entries );
+    theNumSets = header[ 1 ];
+    return true;
 }
 
 
@@ -35,23 +218,26 @@ void DisjSets::unionSets( int root1, int root2 )
  */
 int DisjSets::find( int x ) const
 {
-    if( s[ x ] < 0 )
-        return x;
-    else
-        return find( s[ x ] );
+    while( s[ x ] >= 0 )
+        x = s[ x ];
+    return x;
 }
 
 
 /**
- * Perform a find with path compression.
+ * Perform a find with path halving: every node on the path
+ * is made to point to its grandparent, in one pass and
+ * without recursion.
  * Error checks omitted again for simplicity.
  * Return the set containing x.
  */
 int DisjSets::find( int x )
 {
-    if( s[ x ] < 0 )
-        return x;
-    else
-        return s[ x ] = find( s[ x ] );
+    while( s[ x ] >= 0 )
+    {
+        if( s[ s[ x ] ] >= 0 )
+            s[ x ] = s[ s[ x ] ];
+        x = s[ x ];
+    }
+    return x;
 }
-
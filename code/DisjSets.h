@@ -4,32 +4,61 @@
 // DisjSets class
 //
 // CONSTRUCTION: with int representing initial number of sets
+//               (default 0; makeSet adds more)
 //
 // ******************PUBLIC OPERATIONS*********************
-// void union( root1, root2 ) --> Merge two sets
+// void unionSets( root1, root2 ) --> Merge two sets, given their roots
+// bool unite( x, y )         --> Merge the sets containing x and y;
+//                                return false if already the same set
 // int find( x )              --> Return set containing x
+// int setSize( x )           --> Return size of set containing x
+// int numSets( )             --> Return number of sets
+// int makeSet( )             --> Add a new singleton set; return its element
+// int size( )                --> Return number of elements
+// int compact( labels )      --> Set labels[ x ] to a dense number for
+//                                x's set; return the number of sets
+// bool save( filename )      --> Write the sets to a binary file
+// bool load( filename )      --> Replace the sets with a saved file
 // ******************ERRORS********************************
-// No error checking is performed
+// No error checking is performed, except that save and load
+// return false if the file cannot be written or read; load also
+// rejects, in O( n ), a file whose entries are not a valid forest
+//
+// A saved file is a 24-byte header ("DisjSet1", then the number of
+// elements and the number of sets as 64-bit integers) followed by the
+// array of 32-bit entries in native byte order, so it can be mapped
+// into memory as it is.
 
+#include <string>
 #include <vector>
 using namespace std;
 
 /**
  * Disjoint set class.
- * Use union by rank and path compression.
+ * Use union by size and path halving.
  * Elements in the set are numbered starting at 0.
  */
 class DisjSets
 {
   public:
-    explicit DisjSets( int numElements );
+    explicit DisjSets( int numElements = 0 );
 
     int find( int x ) const;
     int find( int x );
     void unionSets( int root1, int root2 );
+    bool unite( int x, int y );
+    int setSize( int x );
+    int numSets( ) const;
+
+    int makeSet( );
+    int size( ) const;
+    int compact( vector<int> & labels );
+    bool save( const string & filename ) const;
+    bool load( const string & filename );
 
   private:
-    vector<int> s;
+    vector<int> s;      // Parent, or minus the set size for a root
+    int theNumSets;
 };
 
 #endif
@@ -0,0 +1,289 @@
+#ifndef DYNAMIC_KD_TREE_H
+#define DYNAMIC_KD_TREE_H
+
+#include "KdTree.h"
+
+// DynamicKdTree class: a k-d tree over K-dimensional points
+// that supports insertions and deletions
+//
+// CONSTRUCTION: with no parameters
+//
+// Bentley and Saxe's logarithmic method: the points live in a small
+// unsorted buffer and in static KdTrees, one per level, where level i
+// was built with at most BUFFER_SIZE * 2^i points. A full buffer is
+// merged with levels 0 .. j - 1 into the first empty level j, like a
+// carry in binary addition, so each point is rebuilt O( log N ) times.
+// Deletions mark points in their KdTree; once removed points outnumber
+// the live ones, everything is rebuilt from the live points. A query
+// visits the O( log N ) levels; their sizes fall geometrically, and
+// kNearest runs them largest first into one heap, so queries stay
+// within a small factor (2 to 4 in BenchmarkKdTreeChurn) of a freshly
+// built KdTree.
+//
+// ******************PUBLIC OPERATIONS*********************
+// void insert( p )       --> Insert p (duplicates allowed)
+// bool remove( p )       --> Remove one copy of p; return false if none
+// int size( )            --> Return number of points
+// bool isEmpty( )        --> Return true if empty; else false
+// void makeEmpty( )      --> Remove all points
+// void rangeSearch( low, high, visit )
+//                        --> Call visit( p ) for each point p in the box
+// int countInRange( low, high )
+//                        --> Return number of points in the box
+// Neighbor nearest( q )  --> Return the point closest to q
+// int kNearest( q, k, out )
+//                        --> Store the k points closest to q, nearest
+//                            first, in out[ 0 .. k - 1 ]; return how many
+// void radiusSearch( q, r, out )
+//                        --> Replace the contents of out with the points
+//                            within distance r of q
+// ******************ERRORS********************************
+// Throws UnderflowException if nearest is called on an empty tree
+
+template <typename T, int K, int LeafSize = 16>
+class DynamicKdTree
+{
+  public:
+    using Tree     = KdTree<T, K, LeafSize>;
+    using Point    = typename Tree::Point;
+    using Neighbor = typename Tree::Neighbor;
+
+    DynamicKdTree( ) : theSize{ 0 }, numStored{ 0 }
+      { }
+
+    /**
+     * Insert p into the tree; duplicates are allowed.
+     */
+    void insert( const Point & p )
+    {
+        buffer.push_back( p );
+        ++theSize;
+        if( (int) buffer.size( ) == BUFFER_SIZE )
+            carry( );
+    }
+
+    /**
+     * Remove one copy of p. Return true if p was found.
+     */
+    bool remove( const Point & p )
+    {
+        for( size_t j = 0; j < buffer.size( ); ++j )
+            if( buffer[ j ] == p )
+            {
+                buffer[ j ] = buffer.back( );
+                buffer.pop_back( );
+                --theSize;
+                return true;
+            }
+
+        for( Tree & level : levels )
+            if( level.remove( p ) )
+            {
+                --theSize;
+                if( numStored - ( theSize - (int) buffer.size( ) ) > theSize )
+                    rebuild( );
+                return true;
+            }
+        return false;
+    }
+
+    int size( ) const
+      { return theSize; }
+
+    bool isEmpty( ) const
+      { return theSize == 0; }
+
+    void makeEmpty( )
+    {
+        buffer.clear( );
+        levels.clear( );
+        theSize = numStored = 0;
+    }
+
+    /**
+     * Call visit( p ) for every point p inside the box [ low, high ].
+     */
+    template <typename Visitor>
+    void rangeSearch( const Point & low, const Point & high, Visitor visit ) const
+    {
+        for( const Point & p : buffer )
+            if( inBox( p, low, high ) )
+                visit( p );
+        for( const Tree & level : levels )
+            level.rangeSearch( low, high, visit );
+    }
+
+    /**
+     * Return the number of points inside the box [ low, high ].
+     */
+    int countInRange( const Point & low, const Point & high ) const
+    {
+        int count = 0;
+        for( const Point & p : buffer )
+            count += inBox( p, low, high );
+        for( const Tree & level : levels )
+            count += level.countInRange( low, high );
+        return count;
+    }
+
+    /**
+     * Return the point closest to q, and its distance.
+     * Throw UnderflowException if empty.
+     */
+    template <typename Metric = L2Metric>
+    Neighbor nearest( const Point & q, Metric metric = Metric{ } ) const
+    {
+        Neighbor best;
+        if( kNearest( q, 1, &best, metric ) == 0 )
+            throw UnderflowException{ };
+        return best;
+    }
+
+    /**
+     * Find the k points closest to q and store them in out[ 0 .. k - 1 ],
+     * nearest first; out must have room for k. All levels search into
+     * one heap, largest first, so the smaller levels are mostly pruned
+     * against the neighbors already found.
+     * Return the number stored, which is less than k only if size( ) is.
+     */
+    template <typename Metric = L2Metric>
+    int kNearest( const Point & q, int k, Neighbor *out, Metric metric = Metric{ } ) const
+    {
+        int found = 0;
+        if( isEmpty( ) || k <= 0 )
+            return 0;
+
+        for( auto itr = levels.rbegin( ); itr != levels.rend( ); ++itr )
+            if( !itr->isEmpty( ) )
+            {
+                array<double, K> offsets{ };
+                itr->kNearest( q, k, out, found, metric, offsets, 0, 0, itr->numPoints );
+            }
+        for( const Point & p : buffer )
+        {
+            double dist = reducedDistance<Metric>( p, q );
+            if( found < k || dist < out[ 0 ].distance )
+                Tree::offer( out, found, k, Neighbor{ p, dist } );
+        }
+
+        sort_heap( out, out + found, Tree::closer );
+        for( int j = 0; j < found; ++j )
+            out[ j ].distance = Metric::toDistance( out[ j ].distance );
+        return found;
+    }
+
+    /**
+     * Replace the contents of out with the points within distance r
+     * of q, in no particular order.
+     */
+    template <typename Metric = L2Metric>
+    void radiusSearch( const Point & q, double r, vector<Neighbor> & out,
+                       Metric metric = Metric{ } ) const
+    {
+        out.clear( );
+        if( isEmpty( ) || r < 0 )
+            return;
+
+        double reduced = Metric::fromDistance( r );
+        for( const Point & p : buffer )
+        {
+            double dist = reducedDistance<Metric>( p, q );
+            if( dist <= reduced )
+                out.push_back( Neighbor{ p, dist } );
+        }
+        for( const Tree & level : levels )
+            if( !level.isEmpty( ) )
+            {
+                array<double, K> offsets{ };
+                level.radiusSearch( q, reduced, out, metric, offsets, 0, 0, level.numPoints );
+            }
+        for( Neighbor & n : out )
+            n.distance = Metric::toDistance( n.distance );
+    }
+
+  private:
+    static const int BUFFER_SIZE = 4 * LeafSize;
+
+    vector<Point> buffer;       // Newest points, unsorted
+    vector<Tree> levels;        // levels[ i ] built with <= BUFFER_SIZE * 2^i points
+    int theSize;                // Live points, buffer included
+    int numStored;              // Points in the levels, removed ones included
+
+    /**
+     * Return true if p lies inside the box [ low, high ].
+     */
+    static bool inBox( const Point & p, const Point & low, const Point & high )
+    {
+        for( int d = 0; d < K; ++d )
+            if( p[ d ] < low[ d ] || high[ d ] < p[ d ] )
+                return false;
+        return true;
+    }
+
+    /**
+     * Return the reduced distance between a and b under Metric.
+     */
+    template <typename Metric>
+    static double reducedDistance( const Point & a, const Point & b )
+    {
+        double dist = Metric::term( double( a[ 0 ] ) - double( b[ 0 ] ) );
+        for( int d = 1; d < K; ++d )
+            dist = Metric::combine( dist, Metric::term( double( a[ d ] ) - double( b[ d ] ) ) );
+        return dist;
+    }
+
+    /**
+     * Merge the full buffer and levels 0 .. j - 1 into the first
+     * level j that holds no live points.
+     */
+    void carry( )
+    {
+        vector<Point> merged = std::move( buffer );
+        buffer.clear( );
+
+        size_t j = 0;
+        for( ; j < levels.size( ) && !levels[ j ].isEmpty( ); ++j )
+        {
+            levels[ j ].getPoints( merged );
+            numStored -= levels[ j ].numPoints;
+            levels[ j ] = Tree{ };
+        }
+        if( j == levels.size( ) )
+            levels.emplace_back( );
+        else
+            numStored -= levels[ j ].numPoints;
+
+        numStored += merged.size( );
+        levels[ j ].build( std::move( merged ) );
+    }
+
+    /**
+     * Rebuild from the live points only, spreading them over the
+     * levels by the binary digits of their number of buffers.
+     */
+    void rebuild( )
+    {
+        vector<Point> all = std::move( buffer );
+        for( const Tree & level : levels )
+            level.getPoints( all );
+        levels.clear( );
+        numStored = 0;
+
+        size_t start = 0;
+        size_t blocks = all.size( ) / BUFFER_SIZE;
+        for( int i = 0; ( blocks >> i ) != 0; ++i )
+        {
+            levels.emplace_back( );
+            if( blocks >> i & 1 )
+            {
+                size_t count = (size_t) BUFFER_SIZE << i;
+                levels[ i ].build( vector<Point>( all.begin( ) + start, all.begin( ) + start + count ) );
+                start += count;
+                numStored += count;
+            }
+        }
+        buffer.assign( all.begin( ) + start, all.end( ) );
+    }
+};
+
+#endif
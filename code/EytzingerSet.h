@@ -0,0 +1,208 @@
+#ifndef EYTZINGER_SET_H
+#define EYTZINGER_SET_H
+
+#include "dsexceptions.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// EytzingerSet class
+//
+// CONSTRUCTION: zero parameter, or a sorted range of distinct items
+//               (the search trees build one with freeze( ))
+//
+// A read-only set that stores its items in an array in Eytzinger
+// (breadth-first) order: the root in slot 1, the children of slot k
+// in slots 2k and 2k+1. The top levels of the implicit tree share a
+// few cache lines, and each step of a search goes to a slot whose
+// address is known in advance, so the search can prefetch the cache
+// line holding the nodes four levels (for 4-byte items) further down
+// and needs no branch on the comparison.
+//
+// ******************PUBLIC OPERATIONS*********************
+// bool contains( x )     --> Return true if x is present
+// Comparable findMin( )  --> Return smallest item
+// Comparable findMax( )  --> Return largest item
+// int size( )            --> Return number of items
+// boolean isEmpty( )     --> Return true if empty; else false
+// ******************ERRORS********************************
+// Throws UnderflowException as warranted
+// Throws IllegalArgumentException if the range is not sorted
+//     or has duplicates
+
+template <typename Comparable>
+class EytzingerSet
+{
+  public:
+    EytzingerSet( ) : theSize{ 0 }, items{ nullptr }
+      { }
+
+    /**
+     * Construct from the items in [ first, last ), which must be
+     * in strictly increasing order; throw IllegalArgumentException
+     * if they are not. The range is read twice: once to check the
+     * order and count the items, then to copy each item straight
+     * into its slot.
+     */
+    template <typename ForwardIterator>
+    EytzingerSet( ForwardIterator first, ForwardIterator last ) : EytzingerSet{ }
+    {
+        size_t n = 0;
+        for( ForwardIterator prev = first, itr = first; itr != last; prev = itr++, ++n )
+            if( n > 0 && !( *prev < *itr ) )
+                throw IllegalArgumentException{ };
+
+        theSize = n;
+        items = allocate( n );
+        place( first, 1 );
+    }
+
+    EytzingerSet( const EytzingerSet & rhs ) : EytzingerSet{ }
+    {
+        items = allocate( rhs.theSize );
+        for( int k = 1; k <= rhs.theSize; ++k )
+            new ( items + k ) Comparable{ rhs.items[ k ] };
+        theSize = rhs.theSize;
+    }
+
+    EytzingerSet( EytzingerSet && rhs ) : theSize{ rhs.theSize }, items{ rhs.items }
+    {
+        rhs.theSize = 0;
+        rhs.items = nullptr;
+    }
+
+    ~EytzingerSet( )
+    {
+        for( int k = 1; k <= theSize; ++k )
+            items[ k ].~Comparable( );
+        deallocate( items );
+    }
+
+    EytzingerSet & operator=( const EytzingerSet & rhs )
+    {
+        EytzingerSet copy = rhs;
+        std::swap( *this, copy );
+        return *this;
+    }
+
+    EytzingerSet & operator=( EytzingerSet && rhs )
+    {
+        std::swap( theSize, rhs.theSize );
+        std::swap( items, rhs.items );
+        return *this;
+    }
+
+    /**
+     * Returns true if x is found.
+     * The descent always runs to the bottom of the implicit tree;
+     * the last slot whose item was not less than x is recovered from
+     * the path bits of k: strip the trailing right turns and one left turn.
+     */
+    bool contains( const Comparable & x ) const
+    {
+        size_t n = theSize;
+        size_t k = 1;
+        while( k <= n )
+        {
+            prefetch( k * ITEMS_PER_LINE );
+            k = 2 * k + ( items[ k ] < x );
+        }
+        k >>= __builtin_ffsll( ~k );
+        return k != 0 && !( x < items[ k ] );
+    }
+
+    /**
+     * Find the smallest item.
+     * Throw UnderflowException if empty.
+     */
+    const Comparable & findMin( ) const
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+        int k = 1;
+        while( 2 * k <= theSize )
+            k = 2 * k;
+        return items[ k ];
+    }
+
+    /**
+     * Find the largest item.
+     * Throw UnderflowException if empty.
+     */
+    const Comparable & findMax( ) const
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+        int k = 1;
+        while( 2 * k + 1 <= theSize )
+            k = 2 * k + 1;
+        return items[ k ];
+    }
+
+    int size( ) const
+      { return theSize; }
+
+    bool isEmpty( ) const
+      { return theSize == 0; }
+
+  private:
+    static const size_t LINE = 64;
+    static const size_t ITEMS_PER_LINE = sizeof( Comparable ) < LINE ? LINE / sizeof( Comparable ) : 1;
+
+    int theSize;
+    Comparable *items;    // items[ 1 .. theSize ]; slot 0 is not constructed
+
+    /**
+     * Allocate slots 0..n on a cache line boundary, so that slots
+     * k * ITEMS_PER_LINE .. ( k + 1 ) * ITEMS_PER_LINE - 1 share a line.
+     * The block is over-allocated and aligned by hand (C++11 has no
+     * aligned operator new); the pointer to free is kept just before
+     * the aligned slots.
+     */
+    static Comparable * allocate( size_t n )
+    {
+        char *raw = static_cast<char *>(
+            ::operator new( ( n + 1 ) * sizeof( Comparable ) + sizeof( void * ) + LINE - 1 ) );
+        uintptr_t aligned = ( reinterpret_cast<uintptr_t>( raw ) + sizeof( void * ) + LINE - 1 )
+                            & ~uintptr_t( LINE - 1 );
+        reinterpret_cast<void **>( aligned )[ -1 ] = raw;
+        return reinterpret_cast<Comparable *>( aligned );
+    }
+
+    static void deallocate( Comparable *p )
+    {
+        if( p != nullptr )
+            ::operator delete( reinterpret_cast<void **>( p )[ -1 ] );
+    }
+
+    /**
+     * Prefetch slot k. k may be past the end, so the address is
+     * formed without pointer arithmetic; prefetches never fault.
+     */
+    void prefetch( size_t k ) const
+    {
+        __builtin_prefetch( reinterpret_cast<const void *>(
+            reinterpret_cast<uintptr_t>( items ) + k * sizeof( Comparable ) ) );
+    }
+
+    /**
+     * Internal method to fill the subtree rooted at slot k with the
+     * items from next on by an in-order walk, advancing next past them.
+     * The recursion is only as deep as the implicit tree, log2( N ).
+     */
+    template <typename ForwardIterator>
+    void place( ForwardIterator & next, size_t k )
+    {
+        if( k > size_t( theSize ) )
+            return;
+        place( next, 2 * k );
+        new ( items + k ) Comparable{ *next };
+        ++next;
+        place( next, 2 * k + 1 );
+    }
+};
+
+#endif
@@ -0,0 +1,275 @@
+#ifndef INDUCED_SUFFIX_ARRAY_H
+#define INDUCED_SUFFIX_ARRAY_H
+
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+using namespace std;
+
+// Suffix arrays by induced sorting (SA-IS)
+//
+// ******************PUBLIC OPERATIONS*********************
+// void inducedSuffixArray( text, n, sa )
+//                        --> Store in sa[ 0 .. n - 1 ] the starting
+//                            positions of the suffixes of text[ 0 .. n - 1 ],
+//                            in sorted order
+// void inducedSuffixArray( str, sa )
+//                        --> Same for a string; sa is resized
+// void lcpArray( text, n, sa, lcp )
+//                        --> Store in lcp[ i ] the length of the longest
+//                            common prefix of suffixes sa[ i - 1 ] and
+//                            sa[ i ]; lcp[ 0 ] is 0
+// ******************ERRORS********************************
+// Throws invalid_argument if n is not less than the largest Index
+//
+// Nong, Zhang and Chan's algorithm, in O( n ) time for any bytes
+// (zeros included; no sentinel is needed). Index is an unsigned type:
+// uint32_t for texts under 4 GB, uint64_t beyond. The work happens in
+// sa itself: each level stores its reduced string in the back of its
+// part of sa and recurses on the front. Besides sa, it needs one bit
+// per position per level (n / 4 bytes over all levels) and two bucket
+// arrays, of 256 entries at the top; deeper levels keep theirs in the
+// unused middle of sa whenever it has room. createSuffixArray in
+// SuffixArray.cpp, by contrast, copies the text into ints and allocates
+// four more arrays at each level, and is limited to int positions.
+
+/**
+ * The type of each suffix, one bit each: S if it is smaller than the
+ * suffix after it, and L if it is larger.
+ */
+class SuffixTypes
+{
+  public:
+    explicit SuffixTypes( size_t n ) : bits( n / 64 + 1, 0 )
+      { }
+
+    bool isS( size_t i ) const
+      { return bits[ i / 64 ] >> i % 64 & 1; }
+
+    void setS( size_t i )
+      { bits[ i / 64 ] |= uint64_t{ 1 } << i % 64; }
+
+    /**
+     * Return true if suffix i is leftmost S: type S after type L.
+     */
+    bool isLMS( size_t i ) const
+      { return i > 0 && isS( i ) && !isS( i - 1 ); }
+
+  private:
+    vector<uint64_t> bits;
+};
+
+/**
+ * Set bucket[ c ] to the start (or, if ends, one past the end)
+ * of the bucket for character c, from the counts of each character.
+ */
+template <typename Index>
+void findBuckets( const Index *counts, Index *bucket, Index K, bool ends )
+{
+    Index sum = 0;
+    for( Index c = 0; c < K; ++c )
+    {
+        sum += counts[ c ];
+        bucket[ c ] = ends ? sum : sum - counts[ c ];
+    }
+}
+
+/**
+ * Induce the order of all suffixes from the LMS suffixes already at
+ * the ends of their buckets in SA: a left-to-right pass places the
+ * L suffixes, starting from suffix n - 1, which follows the empty
+ * suffix; a right-to-left pass then places the S suffixes.
+ */
+template <typename Char, typename Index>
+void induceSuffixes( const Char *s, Index *SA, Index n, const SuffixTypes & types,
+                     const Index *counts, Index *bucket, Index K )
+{
+    const Index EMPTY = numeric_limits<Index>::max( );
+
+    findBuckets( counts, bucket, K, false );
+    SA[ bucket[ s[ n - 1 ] ]++ ] = n - 1;
+    for( Index i = 0; i < n; ++i )
+    {
+        Index j = SA[ i ];
+        if( j != EMPTY && j > 0 && !types.isS( j - 1 ) )
+            SA[ bucket[ s[ j - 1 ] ]++ ] = j - 1;
+    }
+
+    findBuckets( counts, bucket, K, true );
+    for( Index i = n; i-- > 0; )
+    {
+        Index j = SA[ i ];
+        if( j != EMPTY && j > 0 && types.isS( j - 1 ) )
+            SA[ --bucket[ s[ j - 1 ] ] ] = j - 1;
+    }
+}
+
+/**
+ * Return true if the LMS substrings starting at p and q, each running
+ * to the next LMS position inclusive, are equal in characters and types.
+ * The last one runs into the empty suffix, so equals no other.
+ */
+template <typename Char, typename Index>
+bool equalLMSSubstrings( const Char *s, Index n, const SuffixTypes & types, Index p, Index q )
+{
+    for( Index d = 0; ; ++d )
+    {
+        if( p + d == n || q + d == n || s[ p + d ] != s[ q + d ]
+            || types.isS( p + d ) != types.isS( q + d ) )
+            return false;
+        if( d > 0 && types.isLMS( p + d ) )
+            return true;
+    }
+}
+
+/**
+ * One level of SA-IS: store the suffix array of s[ 0 .. n - 1 ], whose
+ * characters are in 0 .. K - 1, in SA[ 0 .. n - 1 ].
+ * SA[ n .. n + fs - 1 ] is free, and holds the buckets if it has room.
+ */
+template <typename Char, typename Index>
+void inducedSuffixArray( const Char *s, Index *SA, Index n, Index K, Index fs )
+{
+    const Index EMPTY = numeric_limits<Index>::max( );
+    if( n == 0 )
+        return;
+
+    SuffixTypes types( n );     // Suffix n - 1 is L, being larger than the empty one
+    for( Index i = n - 1; i-- > 0; )
+        if( s[ i ] < s[ i + 1 ] || ( s[ i ] == s[ i + 1 ] && types.isS( i + 1 ) ) )
+            types.setS( i );
+
+    vector<Index> ownBuckets;
+    Index *counts = SA + n;
+    if( fs / 2 < K )
+    {
+        ownBuckets.resize( size_t( 2 ) * K );
+        counts = ownBuckets.data( );
+    }
+    Index *bucket = counts + K;
+    fill( counts, counts + K, 0 );
+    for( Index i = 0; i < n; ++i )
+        ++counts[ s[ i ] ];
+
+        // Sort the LMS substrings by inducing from the LMS positions
+        // in any order, then pack them, sorted, into SA[ 0 .. n1 - 1 ]
+    fill( SA, SA + n, EMPTY );
+    findBuckets( counts, bucket, K, true );
+    for( Index i = 1; i < n; ++i )
+        if( types.isLMS( i ) )
+            SA[ --bucket[ s[ i ] ] ] = i;
+    induceSuffixes( s, SA, n, types, counts, bucket, K );
+
+    Index n1 = 0;
+    for( Index i = 0; i < n; ++i )
+        if( types.isLMS( SA[ i ] ) )
+            SA[ n1++ ] = SA[ i ];
+
+        // Name them; LMS positions are at least two apart, so the
+        // name of position p fits in SA[ n1 + p / 2 ]. Then move the
+        // names, in text order, to the back: the reduced string s1
+    fill( SA + n1, SA + n, EMPTY );
+    Index names = 0;
+    for( Index i = 0; i < n1; ++i )
+    {
+        if( i == 0 || !equalLMSSubstrings( s, n, types, SA[ i - 1 ], SA[ i ] ) )
+            ++names;
+        SA[ n1 + SA[ i ] / 2 ] = names - 1;
+    }
+    for( Index i = n, j = n; i-- > n1; )
+        if( SA[ i ] != EMPTY )
+            SA[ --j ] = SA[ i ];
+
+        // Sort the LMS suffixes: recurse on s1 unless its names are
+        // already unique, then map s1's positions back to the text
+    Index *s1 = SA + n - n1;
+    if( names < n1 )
+        inducedSuffixArray( (const Index *) s1, SA, n1, names, Index( n - 2 * n1 ) );
+    else
+        for( Index i = 0; i < n1; ++i )
+            SA[ s1[ i ] ] = i;
+
+    for( Index i = n, j = n; i-- > 1; )
+        if( types.isLMS( i ) )
+            SA[ --j ] = i;
+    for( Index i = 0; i < n1; ++i )
+        SA[ i ] = s1[ SA[ i ] ];
+
+        // Put the sorted LMS suffixes at the ends of their buckets,
+        // keeping their order, and induce the rest
+    fill( SA + n1, SA + n, EMPTY );
+    findBuckets( counts, bucket, K, true );
+    for( Index i = n1; i-- > 0; )
+    {
+        Index j = SA[ i ];
+        SA[ i ] = EMPTY;
+        SA[ --bucket[ s[ j ] ] ] = j;
+    }
+    induceSuffixes( s, SA, n, types, counts, bucket, K );
+}
+
+/**
+ * Store in sa[ 0 .. n - 1 ] the suffix array of text[ 0 .. n - 1 ]:
+ * the starting positions of its suffixes, in sorted order.
+ * Throw invalid_argument if n is not less than the largest Index.
+ */
+template <typename Index>
+void inducedSuffixArray( const unsigned char *text, Index n, Index *sa )
+{
+    static_assert( is_unsigned<Index>::value, "Index must be unsigned" );
+    if( n == numeric_limits<Index>::max( ) )
+        throw invalid_argument{ "Text too long for index type" };
+
+    inducedSuffixArray( text, sa, n, Index{ 256 }, Index{ 0 } );
+}
+
+/**
+ * Replace the contents of sa with the suffix array of str.
+ * Throw invalid_argument if str is too long for Index.
+ */
+template <typename Index>
+void inducedSuffixArray( const string & str, vector<Index> & sa )
+{
+    if( str.length( ) >= numeric_limits<Index>::max( ) )
+        throw invalid_argument{ "Text too long for index type" };
+
+    sa.resize( str.length( ) );
+    inducedSuffixArray( reinterpret_cast<const unsigned char *>( str.data( ) ),
+                        Index( str.length( ) ), sa.data( ) );
+}
+
+/**
+ * Kasai et al.'s LCP array from the suffix array sa of text[ 0 .. n - 1 ],
+ * into lcp[ 0 .. n - 1 ]; lcp[ 0 ] is 0. Takes O( n ) time and n more
+ * Indexes for the ranks.
+ */
+template <typename Index>
+void lcpArray( const unsigned char *text, Index n, const Index *sa, Index *lcp )
+{
+    vector<Index> rank( n );
+    for( Index i = 0; i < n; ++i )
+        rank[ sa[ i ] ] = i;
+
+    if( n > 0 )
+        lcp[ 0 ] = 0;
+    Index h = 0;
+    for( Index i = 0; i < n; ++i )
+        if( rank[ i ] > 0 )
+        {
+            Index j = sa[ rank[ i ] - 1 ];
+            while( i + h < n && j + h < n && text[ i + h ] == text[ j + h ] )
+                ++h;
+
+            lcp[ rank[ i ] ] = h;
+            if( h > 0 )
+                --h;
+        }
+        else
+            h = 0;
+}
+
+#endif
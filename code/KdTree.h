@@ -0,0 +1,803 @@
+#ifndef KD_TREE_H
+#define KD_TREE_H
+
+#include "dsexceptions.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+using namespace std;
+
+#if defined( __AVX2__ ) && !defined( KD_TREE_NO_SIMD )
+#define KD_TREE_AVX2
+#include <immintrin.h>
+#endif
+
+// KdTree class: a static k-d tree over K-dimensional points
+//
+// CONSTRUCTION: with no parameters, or a range of points
+//               (built bottom-up in O( N log N ) with median splits)
+//
+// The tree is implicit: a perfect binary tree whose node i has
+// children 2i+1 and 2i+2. Internal nodes hold only a split dimension
+// and value; the points themselves sit inline, in one array, in the
+// order of the leaves. Each leaf is a bucket of at most LeafSize
+// consecutive points, stored as a structure of arrays: all first
+// coordinates, then all second coordinates, and so on. Every node's
+// range of the array is found by halving, so nothing else is stored.
+//
+// Leaves are scanned eight points at a time. Compiled with AVX2
+// (-mavx2) and T one of int, float or double, the box tests and L2
+// distances of the eight run as vector instructions; otherwise, or
+// with -DKD_TREE_NO_SIMD, the same loops run one point at a time.
+//
+// remove only marks a point deleted; the shape of the tree never
+// changes until the next build. DynamicKdTree (DynamicKdTree.h)
+// rebuilds such trees to support updates.
+//
+// ******************PUBLIC OPERATIONS*********************
+// void build( points )   --> Replace the contents with points
+// bool remove( p )       --> Remove one copy of p; return false if none
+// int size( )            --> Return number of points
+// bool isEmpty( )        --> Return true if empty; else false
+// void getPoints( out )  --> Append the points to out
+// void rangeSearch( low, high, visit )
+//                        --> Call visit( p ) for each point p with
+//                            low[ d ] <= p[ d ] <= high[ d ] for all d
+// int countInRange( low, high )
+//                        --> Return number of points in the box
+// void printRange( low, high )
+//                        --> Print the points in the box
+// Neighbor nearest( q )  --> Return the point closest to q
+// int kNearest( q, k, out )
+//                        --> Store the k points closest to q, nearest
+//                            first, in out[ 0 .. k - 1 ]; return how many
+// void radiusSearch( q, r, out )
+//                        --> Replace the contents of out with the points
+//                            within distance r of q, in no particular order
+// The searches take a metric (L2Metric, the default, L1Metric or
+// LInfMetric) and write only to the caller's buffers, so a query
+// allocates nothing once out has grown.
+// void batchRangeSearch( lows, highs, n, visit, numThreads )
+//                        --> Call visit( i, p ) for each point p in box i
+// void batchCountInRange( lows, highs, n, counts, numThreads )
+//                        --> Set counts[ i ] to the number of points in box i
+// void batchKNearest( queries, n, k, out, counts, numThreads )
+//                        --> kNearest for each query i, into
+//                            out[ i * k .. i * k + k - 1 ] and counts[ i ]
+// Batches run in Z-order (Morton order) of the query centres, so
+// consecutive queries touch the same nodes, and are shared out in
+// chunks among numThreads threads (compile with -pthread).
+// ******************ERRORS********************************
+// Throws UnderflowException if nearest is called on an empty tree
+
+/**
+ * Metrics for the nearest neighbor and radius searches. A distance is
+ * combine( ) folded over term( a[ d ] - b[ d ] ) for every dimension;
+ * the searches compare these reduced distances (for L2, the square)
+ * and convert with toDistance only for the results. Since a term grows
+ * with |diff| in every metric, the distance from q to a box is the fold
+ * over q's offsets from the box, which is what prunes subtrees.
+ */
+struct L2Metric
+{
+    static double term( double diff )
+      { return diff * diff; }
+    static double combine( double lhs, double rhs )
+      { return lhs + rhs; }
+    static double fromDistance( double r )
+      { return r * r; }
+    static double toDistance( double reduced )
+      { return sqrt( reduced ); }
+};
+
+struct L1Metric
+{
+    static double term( double diff )
+      { return fabs( diff ); }
+    static double combine( double lhs, double rhs )
+      { return lhs + rhs; }
+    static double fromDistance( double r )
+      { return r; }
+    static double toDistance( double reduced )
+      { return reduced; }
+};
+
+struct LInfMetric
+{
+    static double term( double diff )
+      { return fabs( diff ); }
+    static double combine( double lhs, double rhs )
+      { return max( lhs, rhs ); }
+    static double fromDistance( double r )
+      { return r; }
+    static double toDistance( double reduced )
+      { return reduced; }
+};
+
+#ifdef KD_TREE_AVX2
+/**
+ * Return bit b set iff lo <= c[ b ] <= hi, for b in 0 .. 7.
+ */
+inline unsigned inRange8( const double *c, double lo, double hi )
+{
+    __m256d low = _mm256_set1_pd( lo ), high = _mm256_set1_pd( hi );
+    __m256d a = _mm256_loadu_pd( c ), b = _mm256_loadu_pd( c + 4 );
+    a = _mm256_and_pd( _mm256_cmp_pd( a, low, _CMP_GE_OQ ), _mm256_cmp_pd( a, high, _CMP_LE_OQ ) );
+    b = _mm256_and_pd( _mm256_cmp_pd( b, low, _CMP_GE_OQ ), _mm256_cmp_pd( b, high, _CMP_LE_OQ ) );
+    return _mm256_movemask_pd( a ) | _mm256_movemask_pd( b ) << 4;
+}
+
+inline unsigned inRange8( const float *c, float lo, float hi )
+{
+    __m256 a = _mm256_loadu_ps( c );
+    a = _mm256_and_ps( _mm256_cmp_ps( a, _mm256_set1_ps( lo ), _CMP_GE_OQ ),
+                       _mm256_cmp_ps( a, _mm256_set1_ps( hi ), _CMP_LE_OQ ) );
+    return _mm256_movemask_ps( a );
+}
+
+inline unsigned inRange8( const int *c, int lo, int hi )
+{
+    __m256i a = _mm256_loadu_si256( (const __m256i *) c );
+    __m256i out = _mm256_or_si256( _mm256_cmpgt_epi32( _mm256_set1_epi32( lo ), a ),
+                                   _mm256_cmpgt_epi32( a, _mm256_set1_epi32( hi ) ) );
+    return ~_mm256_movemask_ps( _mm256_castsi256_ps( out ) ) & 0xFF;
+}
+
+/**
+ * Return c[ 0 .. 3 ] as doubles.
+ */
+inline __m256d load4( const double *c )
+  { return _mm256_loadu_pd( c ); }
+
+inline __m256d load4( const float *c )
+  { return _mm256_cvtps_pd( _mm_loadu_ps( c ) ); }
+
+inline __m256d load4( const int *c )
+  { return _mm256_cvtepi32_pd( _mm_loadu_si128( (const __m128i *) c ) ); }
+#endif
+
+template <typename T, int K, int LeafSize = 16>
+class KdTree
+{
+  public:
+    using Point = array<T, K>;
+
+    /**
+     * A search result: a point and its distance from the query.
+     */
+    struct Neighbor
+    {
+        Point  point;
+        double distance;
+    };
+
+    KdTree( ) : numPoints{ 0 }, numRemoved{ 0 }, numInternal{ 0 }
+      { }
+
+    template <typename Iterator>
+    KdTree( Iterator first, Iterator last )
+      { build( vector<Point>( first, last ) ); }
+
+    explicit KdTree( vector<Point> pts )
+      { build( std::move( pts ) ); }
+
+    /**
+     * Replace the contents with pts. Each internal node splits its
+     * range at the median of the dimension in which the range is
+     * widest, so clustered and sorted inputs give a balanced tree too.
+     */
+    void build( vector<Point> pts )
+    {
+        numPoints = pts.size( );
+        numRemoved = 0;
+        removed.clear( );
+        int depth = 0;
+        while( ( ( (long long) numPoints + ( 1LL << depth ) - 1 ) >> depth ) > LeafSize )
+            ++depth;
+        numInternal = ( 1 << depth ) - 1;
+        splitDims.assign( numInternal, 0 );
+        splitValues.assign( numInternal, T{ } );
+
+            // Padding lets the last block of eight read past the end
+        coords.assign( (size_t) K * numPoints + 7, T{ } );
+        build( pts, 0, 0, numPoints );
+    }
+
+    /**
+     * Remove one copy of p, by marking it deleted.
+     * Return true if p was found.
+     */
+    bool remove( const Point & p )
+    {
+        bool found = false;
+        if( isEmpty( ) )
+            return false;
+        if( removed.empty( ) )
+            removed.assign( numPoints, false );
+        forEachBlock( p, p, 0, 0, numPoints, [ & ]( int, int, int j, unsigned mask )
+        {
+            for( int b = 0; !found && b < 8; ++b )
+                if( mask >> b & 1 )
+                {
+                    removed[ j + b ] = true;
+                    ++numRemoved;
+                    found = true;
+                }
+        } );
+        return found;
+    }
+
+    int size( ) const
+      { return numPoints - numRemoved; }
+
+    bool isEmpty( ) const
+      { return size( ) == 0; }
+
+    /**
+     * Append the points to out, in leaf order.
+     */
+    void getPoints( vector<Point> & out ) const
+    {
+        if( !isEmpty( ) )
+            getPoints( out, 0, 0, numPoints );
+    }
+
+    /**
+     * Call visit( p ) for every point p inside the box [ low, high ].
+     */
+    template <typename Visitor>
+    void rangeSearch( const Point & low, const Point & high, Visitor visit ) const
+    {
+        if( isEmpty( ) )
+            return;
+        forEachBlock( low, high, 0, 0, numPoints, [ & ]( int lo, int hi, int j, unsigned mask )
+        {
+            for( int b = 0; b < 8; ++b )
+                if( mask >> b & 1 )
+                    visit( pointAt( j + b, lo, hi ) );
+        } );
+    }
+
+    /**
+     * Return the number of points inside the box [ low, high ].
+     */
+    int countInRange( const Point & low, const Point & high ) const
+    {
+        int count = 0;
+        if( !isEmpty( ) )
+            forEachBlock( low, high, 0, 0, numPoints, [ & ]( int, int, int, unsigned mask )
+            {
+                for( ; mask != 0; mask &= mask - 1 )
+                    ++count;
+            } );
+        return count;
+    }
+
+    /**
+     * Print the points inside the box [ low, high ], one per line.
+     */
+    void printRange( const Point & low, const Point & high, ostream & out = cout ) const
+    {
+        rangeSearch( low, high, [ & ]( const Point & p )
+        {
+            out << "(";
+            for( int d = 0; d < K; ++d )
+                out << ( d == 0 ? "" : "," ) << p[ d ];
+            out << ")" << endl;
+        } );
+    }
+
+    /**
+     * Return the point closest to q, and its distance.
+     * Throw UnderflowException if empty.
+     */
+    template <typename Metric = L2Metric>
+    Neighbor nearest( const Point & q, Metric metric = Metric{ } ) const
+    {
+        Neighbor best;
+        if( kNearest( q, 1, &best, metric ) == 0 )
+            throw UnderflowException{ };
+        return best;
+    }
+
+    /**
+     * Find the k points closest to q and store them in out[ 0 .. k - 1 ],
+     * nearest first; out must have room for k. While searching, out
+     * is a max-heap on distance holding the best points so far, and a
+     * subtree is skipped when its box is no closer than the worst of them.
+     * Return the number stored, which is less than k only if size( ) is.
+     */
+    template <typename Metric = L2Metric>
+    int kNearest( const Point & q, int k, Neighbor *out, Metric metric = Metric{ } ) const
+    {
+        int found = 0;
+        if( isEmpty( ) || k <= 0 )
+            return 0;
+
+        array<double, K> offsets{ };
+        kNearest( q, k, out, found, metric, offsets, 0, 0, numPoints );
+
+        sort_heap( out, out + found, closer );
+        for( int j = 0; j < found; ++j )
+            out[ j ].distance = Metric::toDistance( out[ j ].distance );
+        return found;
+    }
+
+    /**
+     * Replace the contents of out with the points within distance r
+     * of q, in no particular order. out keeps its capacity, so
+     * reusing it across queries avoids allocation.
+     */
+    template <typename Metric = L2Metric>
+    void radiusSearch( const Point & q, double r, vector<Neighbor> & out,
+                       Metric metric = Metric{ } ) const
+    {
+        out.clear( );
+        if( isEmpty( ) || r < 0 )
+            return;
+
+        array<double, K> offsets{ };
+        radiusSearch( q, Metric::fromDistance( r ), out, metric, offsets, 0, 0, numPoints );
+        for( Neighbor & n : out )
+            n.distance = Metric::toDistance( n.distance );
+    }
+
+    /**
+     * Call visit( i, p ) for every point p inside box i, the box
+     * [ lows[ i ], highs[ i ] ], for i in 0 .. n - 1. All points of one
+     * box are visited by the same thread, but different boxes may be
+     * visited concurrently, so visit must be safe for that.
+     */
+    template <typename Visitor>
+    void batchRangeSearch( const Point *lows, const Point *highs, int n, Visitor visit,
+                           int numThreads = 1 ) const
+    {
+        auto centre = [ & ]( int i ) { return boxCentre( lows[ i ], highs[ i ] ); };
+        forEachInCurveOrder( n, centre, numThreads, [ & ]( int i )
+        {
+            rangeSearch( lows[ i ], highs[ i ], [ & ]( const Point & p ) { visit( i, p ); } );
+        } );
+    }
+
+    /**
+     * Set counts[ i ] to the number of points inside box i,
+     * for i in 0 .. n - 1.
+     */
+    void batchCountInRange( const Point *lows, const Point *highs, int n, int *counts,
+                            int numThreads = 1 ) const
+    {
+        auto centre = [ & ]( int i ) { return boxCentre( lows[ i ], highs[ i ] ); };
+        forEachInCurveOrder( n, centre, numThreads, [ & ]( int i )
+            { counts[ i ] = countInRange( lows[ i ], highs[ i ] ); } );
+    }
+
+    /**
+     * Run kNearest( queries[ i ], k ) for i in 0 .. n - 1, storing the
+     * neighbors in out[ i * k .. i * k + k - 1 ] and their number in
+     * counts[ i ]. out must have room for n * k.
+     */
+    template <typename Metric = L2Metric>
+    void batchKNearest( const Point *queries, int n, int k, Neighbor *out, int *counts,
+                        int numThreads = 1, Metric metric = Metric{ } ) const
+    {
+        forEachInCurveOrder( n, [ & ]( int i ) { return queries[ i ]; }, numThreads,
+            [ & ]( int i )
+            { counts[ i ] = kNearest( queries[ i ], k, out + (long long) i * k, metric ); } );
+    }
+
+  private:
+    template <typename, int, int>
+    friend class DynamicKdTree;
+
+    vector<T> coords;                   // Leaf buckets, left to right
+    int numPoints;                      // Including removed ones
+    vector<bool> removed;               // Per point; empty until a remove
+    int numRemoved;
+    vector<unsigned char> splitDims;    // Per internal node
+    vector<T> splitValues;              // Per internal node
+    int numInternal;                    // Nodes 0 .. numInternal - 1 are internal
+
+#ifdef KD_TREE_AVX2
+    static constexpr bool SIMD = is_same<T, double>::value || is_same<T, float>::value
+                                 || is_same<T, int>::value;
+#else
+    static constexpr bool SIMD = false;
+#endif
+
+    /**
+     * Return the midpoint at which node range [ lo, hi ) is split.
+     */
+    static int middle( int lo, int hi )
+      { return lo + ( hi - lo ) / 2; }
+
+    /**
+     * Return the address of coordinate d of point j, which lies in
+     * the leaf holding points lo .. hi - 1.
+     */
+    const T *coordAt( int d, int j, int lo, int hi ) const
+      { return &coords[ (size_t) K * lo + (size_t) d * ( hi - lo ) + ( j - lo ) ]; }
+
+    /**
+     * Return point j of the leaf holding points lo .. hi - 1.
+     */
+    Point pointAt( int j, int lo, int hi ) const
+    {
+        Point p;
+        for( int d = 0; d < K; ++d )
+            p[ d ] = *coordAt( d, j, lo, hi );
+        return p;
+    }
+
+    /**
+     * Return bit b set iff point j + b lies inside the box [ low, high ],
+     * for the up to eight points j + b of the leaf holding lo .. hi - 1.
+     */
+    unsigned blockInBox( const Point & low, const Point & high, int j, int lo, int hi ) const
+    {
+        int n = min( 8, hi - j );
+        if constexpr( SIMD )
+        {
+#ifdef KD_TREE_AVX2
+            unsigned mask = inRange8( coordAt( 0, j, lo, hi ), low[ 0 ], high[ 0 ] );
+            for( int d = 1; d < K && mask != 0; ++d )
+                mask &= inRange8( coordAt( d, j, lo, hi ), low[ d ], high[ d ] );
+            return mask & ( ( 1u << n ) - 1 );
+#endif
+        }
+
+        unsigned mask = ( 1u << n ) - 1;
+        for( int d = 0; d < K && mask != 0; ++d )
+        {
+            const T *c = coordAt( d, j, lo, hi );
+            unsigned outside = 0;
+            for( int b = 0; b < n; ++b )
+                outside |= unsigned( c[ b ] < low[ d ] || high[ d ] < c[ b ] ) << b;
+            mask &= ~outside;
+        }
+        return mask;
+    }
+
+    /**
+     * Store the reduced distances under Metric from q to the up to
+     * eight points j + b of the leaf holding lo .. hi - 1 in dist[ b ].
+     */
+    template <typename Metric>
+    void blockDistances( const Point & q, int j, int lo, int hi, double *dist ) const
+    {
+        if constexpr( SIMD && is_same<Metric, L2Metric>::value )
+        {
+#ifdef KD_TREE_AVX2
+            for( int h = 0; h < 8; h += 4 )
+            {
+                __m256d sum = _mm256_setzero_pd( );
+                for( int d = 0; d < K; ++d )
+                {
+                    __m256d diff = _mm256_sub_pd( load4( coordAt( d, j + h, lo, hi ) ),
+                                                  _mm256_set1_pd( double( q[ d ] ) ) );
+                    sum = _mm256_add_pd( sum, _mm256_mul_pd( diff, diff ) );
+                }
+                _mm256_storeu_pd( dist + h, sum );
+            }
+            return;
+#endif
+        }
+
+        int n = min( 8, hi - j );
+        for( int b = 0; b < n; ++b )
+            dist[ b ] = Metric::term( double( coordAt( 0, j, lo, hi )[ b ] ) - double( q[ 0 ] ) );
+        for( int d = 1; d < K; ++d )
+        {
+            const T *c = coordAt( d, j, lo, hi );
+            for( int b = 0; b < n; ++b )
+                dist[ b ] = Metric::combine( dist[ b ], Metric::term( double( c[ b ] ) - double( q[ d ] ) ) );
+        }
+    }
+
+    /**
+     * Return the centre of the box [ low, high ].
+     */
+    static Point boxCentre( const Point & low, const Point & high )
+    {
+        Point c;
+        for( int d = 0; d < K; ++d )
+            c[ d ] = low[ d ] + ( high[ d ] - low[ d ] ) / 2;
+        return c;
+    }
+
+    /**
+     * Return the indices 0 .. n - 1 sorted by the Z-order position of
+     * centre( i ): each coordinate is scaled to BITS bits within the
+     * bounding box of all the centres, and the bits are interleaved.
+     */
+    template <typename Centre>
+    static vector<int> curveOrder( int n, Centre centre )
+    {
+        const int BITS = 64 / K < 21 ? 64 / K : 21;
+        vector<Point> centres( n );
+        Point minP{ }, maxP{ };
+        for( int i = 0; i < n; ++i )
+        {
+            centres[ i ] = centre( i );
+            for( int d = 0; d < K; ++d )
+            {
+                if( i == 0 || centres[ i ][ d ] < minP[ d ] )
+                    minP[ d ] = centres[ i ][ d ];
+                if( i == 0 || maxP[ d ] < centres[ i ][ d ] )
+                    maxP[ d ] = centres[ i ][ d ];
+            }
+        }
+
+        vector<pair<uint64_t, int>> keys( n );
+        for( int i = 0; i < n; ++i )
+        {
+            uint64_t cell[ K ];
+            for( int d = 0; d < K; ++d )
+            {
+                double extent = double( maxP[ d ] ) - double( minP[ d ] );
+                double fraction = extent > 0 ? ( double( centres[ i ][ d ] ) - double( minP[ d ] ) ) / extent : 0;
+                cell[ d ] = uint64_t( fraction * ( ( 1ULL << BITS ) - 1 ) );
+            }
+            uint64_t key = 0;
+            for( int bit = BITS - 1; bit >= 0; --bit )
+                for( int d = 0; d < K; ++d )
+                    key = key << 1 | ( cell[ d ] >> bit & 1 );
+            keys[ i ] = { key, i };
+        }
+        sort( keys.begin( ), keys.end( ) );
+
+        vector<int> order( n );
+        for( int i = 0; i < n; ++i )
+            order[ i ] = keys[ i ].second;
+        return order;
+    }
+
+    /**
+     * Call query( i ) for i in 0 .. n - 1, in curve order. Chunks of
+     * consecutive queries are handed out through an atomic counter to
+     * numThreads threads, this one included, so slow chunks do not
+     * hold up the others.
+     */
+    template <typename Centre, typename Query>
+    void forEachInCurveOrder( int n, Centre centre, int numThreads, Query query ) const
+    {
+        const int CHUNK = 64;
+        vector<int> order = curveOrder( n, centre );
+        atomic<int> next{ 0 };
+
+        auto worker = [ & ]
+        {
+            for( int start; ( start = next.fetch_add( CHUNK ) ) < n; )
+                for( int j = start; j < n && j < start + CHUNK; ++j )
+                    query( order[ j ] );
+        };
+        vector<thread> threads;
+        for( int t = 1; t < numThreads; ++t )
+            threads.emplace_back( worker );
+        worker( );
+        for( auto & t : threads )
+            t.join( );
+    }
+
+    /**
+     * Return the reduced distance from q to a box, given q's offset
+     * from the box in each dimension (0 where q is inside).
+     */
+    template <typename Metric>
+    static double boxDistance( const array<double, K> & offsets )
+    {
+        double dist = Metric::term( offsets[ 0 ] );
+        for( int d = 1; d < K; ++d )
+            dist = Metric::combine( dist, Metric::term( offsets[ d ] ) );
+        return dist;
+    }
+
+    /**
+     * Heap order for kNearest: the farthest neighbor on top.
+     */
+    static bool closer( const Neighbor & lhs, const Neighbor & rhs )
+      { return lhs.distance < rhs.distance; }
+
+    /**
+     * Add candidate to the max-heap out[ 0 .. found - 1 ] of the best
+     * k so far, which the caller has checked it belongs in.
+     */
+    static void offer( Neighbor *out, int & found, int k, const Neighbor & candidate )
+    {
+        if( found < k )
+        {
+            out[ found++ ] = candidate;
+            push_heap( out, out + found, closer );
+        }
+        else
+        {
+            pop_heap( out, out + k, closer );
+            out[ k - 1 ] = candidate;
+            push_heap( out, out + k, closer );
+        }
+    }
+
+    /**
+     * Internal method for kNearest over node i's range [ lo, hi ).
+     * offsets holds q's offsets from the node's box; the caller has
+     * already checked that the box may hold a better point.
+     * The near child is searched first, so the far one is usually pruned.
+     */
+    template <typename Metric>
+    void kNearest( const Point & q, int k, Neighbor *out, int & found, Metric metric,
+                   array<double, K> & offsets, int i, int lo, int hi ) const
+    {
+        if( i >= numInternal )
+        {
+            double dist[ 8 ];
+            for( int j = lo; j < hi; j += 8 )
+            {
+                int n = min( 8, hi - j );
+                blockDistances<Metric>( q, j, lo, hi, dist );
+                for( int b = 0; b < n; ++b )
+                    if( ( found < k || dist[ b ] < out[ 0 ].distance )
+                        && !( numRemoved > 0 && removed[ j + b ] ) )
+                        offer( out, found, k, Neighbor{ pointAt( j + b, lo, hi ), dist[ b ] } );
+            }
+            return;
+        }
+
+        int dim = splitDims[ i ];
+        int mid = middle( lo, hi );
+        double diff = double( q[ dim ] ) - double( splitValues[ i ] );
+        int nearChild = diff < 0 ? 2 * i + 1 : 2 * i + 2;
+        if( diff < 0 )
+            kNearest( q, k, out, found, metric, offsets, nearChild, lo, mid );
+        else
+            kNearest( q, k, out, found, metric, offsets, nearChild, mid, hi );
+
+        double oldOffset = offsets[ dim ];
+        offsets[ dim ] = fabs( diff );
+        if( found < k || boxDistance<Metric>( offsets ) < out[ 0 ].distance )
+        {
+            if( diff < 0 )
+                kNearest( q, k, out, found, metric, offsets, 2 * i + 2, mid, hi );
+            else
+                kNearest( q, k, out, found, metric, offsets, 2 * i + 1, lo, mid );
+        }
+        offsets[ dim ] = oldOffset;
+    }
+
+    /**
+     * Internal method for radiusSearch over node i's range [ lo, hi ),
+     * with reduced radius r; offsets is as in kNearest.
+     */
+    template <typename Metric>
+    void radiusSearch( const Point & q, double r, vector<Neighbor> & out, Metric metric,
+                       array<double, K> & offsets, int i, int lo, int hi ) const
+    {
+        if( i >= numInternal )
+        {
+            double dist[ 8 ];
+            for( int j = lo; j < hi; j += 8 )
+            {
+                int n = min( 8, hi - j );
+                blockDistances<Metric>( q, j, lo, hi, dist );
+                for( int b = 0; b < n; ++b )
+                    if( dist[ b ] <= r && !( numRemoved > 0 && removed[ j + b ] ) )
+                        out.push_back( Neighbor{ pointAt( j + b, lo, hi ), dist[ b ] } );
+            }
+            return;
+        }
+
+        int dim = splitDims[ i ];
+        int mid = middle( lo, hi );
+        double diff = double( q[ dim ] ) - double( splitValues[ i ] );
+        double oldOffset = offsets[ dim ];
+
+            // Search the near child with offsets unchanged, the far
+            // child only if its box comes within r
+        offsets[ dim ] = diff < 0 ? oldOffset : fabs( diff );
+        if( diff < 0 || boxDistance<Metric>( offsets ) <= r )
+            radiusSearch( q, r, out, metric, offsets, 2 * i + 1, lo, mid );
+        offsets[ dim ] = diff < 0 ? fabs( diff ) : oldOffset;
+        if( diff >= 0 || boxDistance<Metric>( offsets ) <= r )
+            radiusSearch( q, r, out, metric, offsets, 2 * i + 2, mid, hi );
+        offsets[ dim ] = oldOffset;
+    }
+
+    /**
+     * Internal method to append the points of node i's range [ lo, hi ).
+     */
+    void getPoints( vector<Point> & out, int i, int lo, int hi ) const
+    {
+        if( i >= numInternal )
+        {
+            for( int j = lo; j < hi; ++j )
+                if( !( numRemoved > 0 && removed[ j ] ) )
+                    out.push_back( pointAt( j, lo, hi ) );
+            return;
+        }
+        getPoints( out, 2 * i + 1, lo, middle( lo, hi ) );
+        getPoints( out, 2 * i + 2, middle( lo, hi ), hi );
+    }
+
+    /**
+     * Internal method to build node i over points[ lo .. hi - 1 ].
+     * Afterwards the left half holds the items not greater than the
+     * split value and the right half those not less.
+     */
+    void build( vector<Point> & points, int i, int lo, int hi )
+    {
+        if( i >= numInternal )
+        {
+            for( int j = lo; j < hi; ++j )
+                for( int d = 0; d < K; ++d )
+                    coords[ (size_t) K * lo + (size_t) d * ( hi - lo ) + ( j - lo ) ] = points[ j ][ d ];
+            return;
+        }
+
+        int dim = 0;
+        if( lo < hi )
+        {
+            Point minP = points[ lo ], maxP = points[ lo ];
+            for( int j = lo + 1; j < hi; ++j )
+                for( int d = 0; d < K; ++d )
+                {
+                    minP[ d ] = min( minP[ d ], points[ j ][ d ] );
+                    maxP[ d ] = max( maxP[ d ], points[ j ][ d ] );
+                }
+            for( int d = 1; d < K; ++d )
+                if( maxP[ dim ] - minP[ dim ] < maxP[ d ] - minP[ d ] )
+                    dim = d;
+        }
+
+        int mid = middle( lo, hi );
+        if( mid < hi )
+        {
+            nth_element( points.begin( ) + lo, points.begin( ) + mid, points.begin( ) + hi,
+                         [ dim ]( const Point & a, const Point & b ) { return a[ dim ] < b[ dim ]; } );
+            splitValues[ i ] = points[ mid ][ dim ];
+        }
+        splitDims[ i ] = dim;
+
+        build( points, 2 * i + 1, lo, mid );
+        build( points, 2 * i + 2, mid, hi );
+    }
+
+    /**
+     * Internal method to scan the leaves under node i, whose range is
+     * [ lo, hi ), that may meet the box. For each block of up to eight
+     * points of a leaf holding lo .. hi - 1, starting at point j, call
+     * visitBlock( lo, hi, j, mask ), where bit b of mask is set iff
+     * point j + b lies inside the box and is not removed.
+     */
+    template <typename BlockVisitor>
+    void forEachBlock( const Point & low, const Point & high, int i, int lo, int hi,
+                       BlockVisitor visitBlock ) const
+    {
+        if( i >= numInternal )
+        {
+            for( int j = lo; j < hi; j += 8 )
+            {
+                unsigned mask = blockInBox( low, high, j, lo, hi );
+                if( mask != 0 && numRemoved > 0 )
+                    for( int b = 0; b < 8; ++b )
+                        if( mask >> b & 1 && removed[ j + b ] )
+                            mask &= ~( 1u << b );
+                if( mask != 0 )
+                    visitBlock( lo, hi, j, mask );
+            }
+            return;
+        }
+
+        int dim = splitDims[ i ];
+        int mid = middle( lo, hi );
+        if( !( splitValues[ i ] < low[ dim ] ) )
+            forEachBlock( low, high, 2 * i + 1, lo, mid, visitBlock );
+        if( !( high[ dim ] < splitValues[ i ] ) )
+            forEachBlock( low, high, 2 * i + 2, mid, hi, visitBlock );
+    }
+};
+
+#endif
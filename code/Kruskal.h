@@ -0,0 +1,236 @@
+#ifndef KRUSKAL_H
+#define KRUSKAL_H
+
+#include "DisjSets.h"
+#include "UniformRandom.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+using namespace std;
+
+// Kruskal's minimum spanning forest over DisjSets
+//
+// ******************PUBLIC OPERATIONS*********************
+// void radixSortByWeight( edges )
+//                        --> Sort edges by weight, stably, in O( E )
+// WeightSum kruskal( ds, edges, forest, numComponents )
+//                        --> Sort edges, then add the lightest edges
+//                            joining two sets of ds to forest until
+//                            ds has numComponents sets; return weight
+// vector<Edge> randomMaze( rows, cols, seed )
+//                        --> Return the open walls of a random maze
+// bool writeEdges( filename, edges )
+//                        --> Write edges to a binary file
+// bool readEdges( filename, edges )
+//                        --> Replace edges with those in a binary file
+// ******************ERRORS********************************
+// readEdges and writeEdges return false if the file cannot be read
+// or written
+//
+// Weights may be any integer or floating-point type; totals are summed
+// in the widest type of the same kind (WeightSum). An edge file is the
+// WeightedEdge records themselves, back to back, in native byte order,
+// with no header: for float weights, 12 bytes per edge. Padding bytes,
+// for weights narrower than int, are written as zeros.
+// Stopping at numComponents > 1 gives single-linkage clustering; the
+// clusters are then read from ds, for instance with ds.compact( ).
+
+/**
+ * An edge between vertices u and v.
+ */
+template <typename Weight>
+struct WeightedEdge
+{
+    int    u;
+    int    v;
+    Weight weight;
+};
+
+/**
+ * The type in which weights are summed: long double for floating
+ * point, and 64-bit integers of the same signedness otherwise.
+ */
+template <typename Weight>
+using WeightSum = conditional_t<is_floating_point<Weight>::value, long double,
+                  conditional_t<is_signed<Weight>::value, int64_t, uint64_t>>;
+
+/**
+ * Return an unsigned key that orders like weight:
+ * for signed types the sign bit is flipped, and for floating point
+ * the other bits of negative numbers are flipped too.
+ */
+template <typename Weight>
+uint64_t radixKey( Weight weight )
+{
+    using Bits = conditional_t<sizeof( Weight ) == 8, uint64_t,
+                 conditional_t<sizeof( Weight ) == 4, uint32_t,
+                 conditional_t<sizeof( Weight ) == 2, uint16_t, uint8_t>>>;
+    const Bits SIGN = Bits( 1 ) << ( 8 * sizeof( Weight ) - 1 );
+
+    Bits bits;
+    memcpy( &bits, &weight, sizeof( Weight ) );
+    if constexpr( is_floating_point<Weight>::value )
+        return bits & SIGN ? Bits( ~bits ) : Bits( bits | SIGN );
+    else if constexpr( is_signed<Weight>::value )
+        return Bits( bits ^ SIGN );
+    else
+        return bits;
+}
+
+/**
+ * Sort edges by weight with a least significant digit first radix
+ * sort on bytes. All digit counts are taken in one pass, and a byte
+ * that is the same in every key costs no pass.
+ */
+template <typename Weight>
+void radixSortByWeight( vector<WeightedEdge<Weight>> & edges )
+{
+    const int BYTES = sizeof( Weight );
+    vector<size_t> counts( BYTES * 256, 0 );
+    for( const auto & e : edges )
+    {
+        uint64_t key = radixKey( e.weight );
+        for( int b = 0; b < BYTES; ++b )
+            ++counts[ b * 256 + ( key >> 8 * b & 0xFF ) ];
+    }
+
+    vector<WeightedEdge<Weight>> scratch;
+    for( int b = 0; b < BYTES; ++b )
+    {
+        size_t *count = &counts[ b * 256 ];
+        if( edges.empty( ) || count[ radixKey( edges[ 0 ].weight ) >> 8 * b & 0xFF ] == edges.size( ) )
+            continue;
+
+        size_t position = 0;
+        for( int digit = 0; digit < 256; ++digit )
+        {
+            size_t c = count[ digit ];
+            count[ digit ] = position;
+            position += c;
+        }
+        scratch.resize( edges.size( ) );
+        for( const auto & e : edges )
+            scratch[ count[ radixKey( e.weight ) >> 8 * b & 0xFF ]++ ] = e;
+        edges.swap( scratch );
+    }
+}
+
+/**
+ * Kruskal's algorithm: sort edges by weight, then scan them, adding
+ * to forest each edge that joins two sets of ds, until ds is down to
+ * numComponents sets or the edges run out. ds starts with one element
+ * per vertex (and may already hold unions). Edges are left sorted.
+ * Return the total weight of the edges added.
+ */
+template <typename Weight>
+WeightSum<Weight> kruskal( DisjSets & ds, vector<WeightedEdge<Weight>> & edges,
+                           vector<WeightedEdge<Weight>> & forest, int numComponents = 1 )
+{
+    WeightSum<Weight> total = 0;
+    forest.clear( );
+    if( ds.numSets( ) <= numComponents )
+        return total;
+
+    radixSortByWeight( edges );
+    for( const auto & e : edges )
+        if( ds.unite( e.u, e.v ) )
+        {
+            forest.push_back( e );
+            total += e.weight;
+            if( ds.numSets( ) <= numComponents )
+                break;
+        }
+    return total;
+}
+
+/**
+ * Return the walls to open in a rows by cols grid of cells, numbered
+ * row by row, to make a perfect maze: Kruskal's algorithm on the grid
+ * with random weights, so exactly one path joins any two cells.
+ */
+inline vector<WeightedEdge<int>> randomMaze( int rows, int cols, int seed = 1 )
+{
+    UniformRandom r{ seed };
+    vector<WeightedEdge<int>> walls;
+    for( int row = 0; row < rows; ++row )
+        for( int col = 0; col < cols; ++col )
+        {
+            int cell = row * cols + col;
+            if( col + 1 < cols )
+                walls.push_back( { cell, cell + 1, r.nextInt( 1 << 30 ) } );
+            if( row + 1 < rows )
+                walls.push_back( { cell, cell + cols, r.nextInt( 1 << 30 ) } );
+        }
+
+    DisjSets ds{ rows * cols };
+    vector<WeightedEdge<int>> open;
+    kruskal( ds, walls, open );
+    return open;
+}
+
+/**
+ * Write edges to filename as raw records. Records with padding are
+ * built field by field in a zeroed buffer, a block at a time, so equal
+ * edges always give identical files.
+ * Return false if the file cannot be written.
+ */
+template <typename Weight>
+bool writeEdges( const string & filename, const vector<WeightedEdge<Weight>> & edges )
+{
+    using Edge = WeightedEdge<Weight>;
+    const size_t BLOCK = 4096;
+    ofstream out( filename, ios::binary );
+
+    if( sizeof( Edge ) == 2 * sizeof( int ) + sizeof( Weight ) )
+        out.write( reinterpret_cast<const char *>( edges.data( ) ), edges.size( ) * sizeof( Edge ) );
+    else
+    {
+        vector<char> block( BLOCK * sizeof( Edge ), 0 );
+        for( size_t start = 0; start < edges.size( ); start += BLOCK )
+        {
+            size_t count = min( BLOCK, edges.size( ) - start );
+            for( size_t i = 0; i < count; ++i )
+            {
+                const Edge & e = edges[ start + i ];
+                char *record = &block[ i * sizeof( Edge ) ];
+                memcpy( record + offsetof( Edge, u ), &e.u, sizeof( e.u ) );
+                memcpy( record + offsetof( Edge, v ), &e.v, sizeof( e.v ) );
+                memcpy( record + offsetof( Edge, weight ), &e.weight, sizeof( e.weight ) );
+            }
+            out.write( block.data( ), count * sizeof( Edge ) );
+        }
+    }
+    out.close( );
+    return !out.fail( );
+}
+
+/**
+ * Replace edges with the raw records in filename, read in one block.
+ * Return false if the file cannot be read or is not a whole
+ * number of records.
+ */
+template <typename Weight>
+bool readEdges( const string & filename, vector<WeightedEdge<Weight>> & edges )
+{
+    ifstream in( filename, ios::binary | ios::ate );
+    if( !in )
+        return false;
+    streamoff bytes = in.tellg( );
+    if( bytes < 0 || bytes % sizeof( WeightedEdge<Weight> ) != 0 )
+        return false;
+
+    vector<WeightedEdge<Weight>> read( bytes / sizeof( WeightedEdge<Weight> ) );
+    in.seekg( 0 );
+    in.read( reinterpret_cast<char *>( read.data( ) ), bytes );
+    if( !in )
+        return false;
+    edges = std::move( read );
+    return true;
+}
+
+#endif
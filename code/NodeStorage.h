@@ -0,0 +1,358 @@
+#ifndef NODE_STORAGE_H
+#define NODE_STORAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Node storage policies for the linked search trees
+// (AvlTree, RedBlackTree and SplayTree take one as their second
+// template parameter).
+//
+// HeapNodes:  each node is allocated with new and linked by pointers.
+//             This is the default.
+// ArenaNodes: nodes live in chunks of CHUNK_SIZE slots and are linked
+//             by 32-bit indices, which shrinks every link to 4 bytes.
+//             The chunks of a tree are freed all at once, so makeEmpty
+//             is O( number of chunks ) when the nodes need no destructor.
+//             A chunk is allocated even for a one-node tree, so this
+//             policy is meant for large trees.
+//
+// For node type Node, a tree uses
+//     typename Storage::template pointer<Node>   as its link type
+//     typename Storage::template Pool<Node>      to make and free nodes
+//
+// ******************POOL OPERATIONS***********************
+// pointer create( args )         --> Construct a node from args
+// void destroy( p )              --> Destroy node p; nothing if nullptr
+// pointer createSentinel( args ) --> Construct a node that is not owned
+//                                    by the pool (for nullNode, header)
+// void destroySentinel( p )      --> Destroy a sentinel
+// void releaseAll( )             --> Free every node at once; only valid if
+//                                    BULK_RELEASE or all were destroyed
+// void splice( rhs )             --> Take over all nodes of pool rhs
+// void swap( rhs )               --> Exchange the nodes of two pools
+// BULK_RELEASE                   --> releaseAll may skip the destructors
+// CONCURRENT_CREATE              --> create may be called by several threads
+
+/**
+ * Pointer-linked nodes, each allocated by new.
+ */
+struct HeapNodes
+{
+    template <typename Node>
+    using pointer = Node *;
+
+    template <typename Node>
+    class Pool
+    {
+      public:
+        using pointer = Node *;
+
+        static const bool BULK_RELEASE = false;
+        static const bool CONCURRENT_CREATE = true;
+
+        template <typename... Args>
+        pointer create( Args && ... args )
+          { return new Node{ std::forward<Args>( args )... }; }
+
+        void destroy( pointer p )
+          { delete p; }
+
+        template <typename... Args>
+        pointer createSentinel( Args && ... args )
+          { return create( std::forward<Args>( args )... ); }
+
+        void destroySentinel( pointer p )
+          { delete p; }
+
+        void releaseAll( )
+          { }
+
+        void splice( Pool & )
+          { }
+
+        void swap( Pool & )
+          { }
+    };
+};
+
+template <typename Node>
+class ArenaPointer;
+
+/**
+ * The chunks holding every arena node of type Node.
+ * Index i lives in slot i % CHUNK_SIZE of chunk i / CHUNK_SIZE.
+ * Chunk 0 is never used, so index 0 can stand for nullptr.
+ */
+template <typename Node>
+class ArenaChunks
+{
+  public:
+    static const int CHUNK_BITS = 12;
+    static const uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+    static const uint32_t MAX_CHUNKS = 1u << ( 32 - CHUNK_BITS );
+
+    static Node & slot( uint32_t i )
+      { return table[ i >> CHUNK_BITS ][ i & ( CHUNK_SIZE - 1 ) ]; }
+
+    /**
+     * Allocate a chunk and return the index of its first slot.
+     */
+    static uint32_t acquire( )
+    {
+        lock_guard<mutex> guard{ lock };
+        uint32_t id;
+        if( !freeIds.empty( ) )
+        {
+            id = freeIds.back( );
+            freeIds.pop_back( );
+        }
+        else if( used + 1 < MAX_CHUNKS )
+            id = ++used;
+        else
+            throw bad_alloc{ };
+        table[ id ] = static_cast<Node *>( ::operator new( CHUNK_SIZE * sizeof( Node ) ) );
+        return id << CHUNK_BITS;
+    }
+
+    /**
+     * Free the chunk whose first slot is index first.
+     */
+    static void release( uint32_t first )
+    {
+        lock_guard<mutex> guard{ lock };
+        uint32_t id = first >> CHUNK_BITS;
+        ::operator delete( table[ id ] );
+        table[ id ] = nullptr;
+        freeIds.push_back( id );
+    }
+
+    /**
+     * Return a slot for a sentinel node, shared among all trees.
+     */
+    static uint32_t acquireSentinel( )
+    {
+        uint32_t i;
+        {
+            lock_guard<mutex> guard{ lock };
+            if( !freeSentinels.empty( ) )
+            {
+                i = freeSentinels.back( );
+                freeSentinels.pop_back( );
+                return i;
+            }
+        }
+        i = acquire( );
+        lock_guard<mutex> guard{ lock };
+        for( uint32_t j = i + CHUNK_SIZE - 1; j > i; --j )
+            freeSentinels.push_back( j );
+        return i;
+    }
+
+    static void releaseSentinel( uint32_t i )
+    {
+        lock_guard<mutex> guard{ lock };
+        freeSentinels.push_back( i );
+    }
+
+  private:
+    static Node *table[ MAX_CHUNKS ];
+    static uint32_t used;
+    static vector<uint32_t> freeIds;
+    static vector<uint32_t> freeSentinels;
+    static mutex lock;
+};
+
+template <typename Node>
+Node *ArenaChunks<Node>::table[ ArenaChunks<Node>::MAX_CHUNKS ];
+
+template <typename Node>
+uint32_t ArenaChunks<Node>::used = 0;
+
+template <typename Node>
+vector<uint32_t> ArenaChunks<Node>::freeIds;
+
+template <typename Node>
+vector<uint32_t> ArenaChunks<Node>::freeSentinels;
+
+template <typename Node>
+mutex ArenaChunks<Node>::lock;
+
+/**
+ * A 32-bit index that is used like a Node *.
+ */
+template <typename Node>
+class ArenaPointer
+{
+  public:
+    ArenaPointer( ) : index{ 0 }
+      { }
+
+    ArenaPointer( nullptr_t ) : index{ 0 }
+      { }
+
+    Node & operator* ( ) const
+      { return ArenaChunks<Node>::slot( index ); }
+
+    Node * operator-> ( ) const
+      { return &ArenaChunks<Node>::slot( index ); }
+
+    friend bool operator== ( ArenaPointer lhs, ArenaPointer rhs )
+      { return lhs.index == rhs.index; }
+
+    friend bool operator!= ( ArenaPointer lhs, ArenaPointer rhs )
+      { return lhs.index != rhs.index; }
+
+  private:
+    uint32_t index;
+
+    explicit ArenaPointer( uint32_t i ) : index{ i }
+      { }
+
+    template <typename> friend class ArenaNodesPool;
+};
+
+/**
+ * The pool of ArenaNodes: the chunks owned by one tree.
+ * Destroyed slots are chained through their first four bytes.
+ */
+template <typename Node>
+class ArenaNodesPool
+{
+  public:
+    using pointer = ArenaPointer<Node>;
+    using Chunks  = ArenaChunks<Node>;
+
+    static const bool BULK_RELEASE = is_trivially_destructible<Node>::value;
+    static const bool CONCURRENT_CREATE = false;
+
+    ArenaNodesPool( ) : next{ 0 }, limit{ 0 }, freeList{ 0 }
+      { }
+
+    ArenaNodesPool( const ArenaNodesPool & ) = delete;
+    ArenaNodesPool & operator=( const ArenaNodesPool & ) = delete;
+
+    ArenaNodesPool( ArenaNodesPool && rhs ) : ArenaNodesPool{ }
+      { swap( rhs ); }
+
+    ~ArenaNodesPool( )
+      { releaseAll( ); }
+
+    template <typename... Args>
+    pointer create( Args && ... args )
+    {
+        uint32_t i;
+        if( freeList != 0 )
+        {
+            i = freeList;
+            freeList = nextFree( i );
+        }
+        else
+        {
+            if( next == limit )
+            {
+                next = Chunks::acquire( );
+                limit = next + Chunks::CHUNK_SIZE;
+                chunks.push_back( next );
+            }
+            i = next++;
+        }
+        new ( &Chunks::slot( i ) ) Node{ std::forward<Args>( args )... };
+        return pointer{ i };
+    }
+
+    void destroy( pointer p )
+    {
+        if( p == nullptr )
+            return;
+        p->~Node( );
+        nextFree( p.index ) = freeList;
+        freeList = p.index;
+    }
+
+    template <typename... Args>
+    pointer createSentinel( Args && ... args )
+    {
+        uint32_t i = Chunks::acquireSentinel( );
+        new ( &Chunks::slot( i ) ) Node{ std::forward<Args>( args )... };
+        return pointer{ i };
+    }
+
+    void destroySentinel( pointer p )
+    {
+        if( p == nullptr )
+            return;
+        p->~Node( );
+        Chunks::releaseSentinel( p.index );
+    }
+
+    void releaseAll( )
+    {
+        for( uint32_t first : chunks )
+            Chunks::release( first );
+        chunks.clear( );
+        next = limit = freeList = 0;
+    }
+
+    /**
+     * Take over the chunks and free slots of rhs, which becomes empty.
+     * O( chunks + free slots of rhs ).
+     */
+    void splice( ArenaNodesPool & rhs )
+    {
+        if( this == &rhs )
+            return;
+        chunks.insert( chunks.end( ), rhs.chunks.begin( ), rhs.chunks.end( ) );
+        for( uint32_t i = rhs.freeList; i != 0; )
+        {
+            uint32_t n = nextFree( i );
+            nextFree( i ) = freeList;
+            freeList = i;
+            i = n;
+        }
+        for( uint32_t i = rhs.next; i != rhs.limit; ++i )    // Rest of rhs's last chunk
+        {
+            nextFree( i ) = freeList;
+            freeList = i;
+        }
+        rhs.chunks.clear( );
+        rhs.next = rhs.limit = rhs.freeList = 0;
+    }
+
+    void swap( ArenaNodesPool & rhs )
+    {
+        chunks.swap( rhs.chunks );
+        std::swap( next, rhs.next );
+        std::swap( limit, rhs.limit );
+        std::swap( freeList, rhs.freeList );
+    }
+
+  private:
+    vector<uint32_t> chunks;   // First index of each chunk owned
+    uint32_t next;             // Next unused slot in the last chunk
+    uint32_t limit;            // End of the last chunk
+    uint32_t freeList;         // Destroyed slots, 0 terminated
+
+    static uint32_t & nextFree( uint32_t i )
+      { return *reinterpret_cast<uint32_t *>( &Chunks::slot( i ) ); }
+};
+
+/**
+ * Index-linked nodes in per-tree chunks.
+ */
+struct ArenaNodes
+{
+    template <typename Node>
+    using pointer = ArenaPointer<Node>;
+
+    template <typename Node>
+    using Pool = ArenaNodesPool<Node>;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef PQ_POLICY_H
+#define PQ_POLICY_H
+
+#include "BinaryHeap.h"
+#include "PairingHeap.h"
+#include "RadixHeap.h"
+using namespace std;
+
+// PreferredPQ<Workload, Comparable>
+//
+// Compile-time choice of the priority queue to use for a workload
+// profile. The choices follow the measurements of BenchmarkPQ.cpp
+// and BenchmarkDijkstra.cpp; rerun those if the heaps change.
+//
+// On the benchmarks the array-based BinaryHeap beats the pointer-based
+// heaps on every comparison workload, including meld-heavy ones,
+// since its merge only rebuilds when rhs is not small. The pointer
+// heaps are chosen only when stable Positions are required.
+//
+// ******************WORKLOAD PROFILES*********************
+// HEAPSORT          --> Bulk inserts, then bulk deleteMins
+// DECREASE_KEY      --> deleteMins interleaved with decreaseKeys,
+//                       done lazily by reinserting and skipping stale items
+// DECREASE_KEY_POSITIONS
+//                   --> As DECREASE_KEY, but through decreaseKey( Position )
+// MELD              --> Frequent merges
+// SLIDING_WINDOW    --> Steady insert/deleteMin mix at a fixed size
+// MONOTONE_INTEGER  --> Unsigned keys, never below the last minimum
+
+enum class PQWorkload
+{
+    HEAPSORT, DECREASE_KEY, DECREASE_KEY_POSITIONS, MELD,
+    SLIDING_WINDOW, MONOTONE_INTEGER
+};
+
+template <PQWorkload Workload, typename Comparable>
+struct PQPolicy;
+
+template <typename Comparable>
+struct PQPolicy<PQWorkload::HEAPSORT, Comparable>
+  { using type = BinaryHeap<Comparable>; };
+
+template <typename Comparable>
+struct PQPolicy<PQWorkload::DECREASE_KEY, Comparable>
+  { using type = BinaryHeap<Comparable>; };
+
+template <typename Comparable>
+struct PQPolicy<PQWorkload::DECREASE_KEY_POSITIONS, Comparable>
+  { using type = PairingHeap<Comparable>; };
+
+template <typename Comparable>
+struct PQPolicy<PQWorkload::MELD, Comparable>
+  { using type = BinaryHeap<Comparable>; };
+
+template <typename Comparable>
+struct PQPolicy<PQWorkload::SLIDING_WINDOW, Comparable>
+  { using type = BinaryHeap<Comparable>; };
+
+template <typename Comparable>
+struct PQPolicy<PQWorkload::MONOTONE_INTEGER, Comparable>
+  { using type = RadixHeap<Comparable>; };
+
+template <PQWorkload Workload, typename Comparable>
+using PreferredPQ = typename PQPolicy<Workload, Comparable>::type;
+
+#endif
@@ -17,6 +17,7 @@ using namespace std;
 // void makeEmpty( )      --> Remove all items
 // void decreaseKey( Position p, newVal )
 //                        --> Decrease value in Position p
+// void merge( rhs )      --> Absorb rhs into this heap
 // ******************ERRORS********************************
 // Throws UnderflowException as warranted
 
@@ -205,6 +206,23 @@ class PairingHeap
         }
     }
 
+    /**
+     * Merge rhs into the priority queue.
+     * rhs becomes empty. rhs must be different from this.
+     * Positions returned by rhs.insert remain valid in this heap.
+     */
+    void merge( PairingHeap & rhs )
+    {
+        if( this == &rhs )    // Avoid aliasing problems
+            return;
+
+        if( root == nullptr )
+            root = rhs.root;
+        else
+            compareAndLink( root, rhs.root );
+        rhs.root = nullptr;
+    }
+
   private:
     struct PairNode
     {
@@ -0,0 +1,555 @@
+#ifndef PERSISTENT_RED_BLACK_TREE_H
+#define PERSISTENT_RED_BLACK_TREE_H
+
+#include "dsexceptions.h"
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// PersistentRedBlackTree class
+//
+// CONSTRUCTION: zero parameter
+//
+// A red-black tree whose nodes are never changed once built. An update
+// copies the nodes on the path to the change and shares the rest with
+// the previous version (path copying), so a Version taken by snapshot( )
+// stays valid and unchanged while writers go on. Nodes are reference
+// counted, and a node is freed when the last version that uses it is gone.
+// Any number of threads may read and update one tree at a time.
+//
+// The current version is published through an atomic pointer to a Root,
+// which holds the root node and is never changed. Reads take no locks:
+// contains, findMin, findMax and isEmpty search the current Root in place,
+// without touching a reference count; snapshot( ) copies its root node
+// pointer. An update builds the new version and installs a new Root with
+// a compare-and-swap, retrying if another update got there first.
+// (The shared_ptr atomic functions are not used: libstdc++ implements
+// them with a pool of mutexes, and they are deprecated in C++20.)
+//
+// Replaced Roots are freed by epoch-based reclamation, as in
+// ConcurrentSkipList. Each operation counts itself as active in the
+// epoch (0 or 1) current when it started, on a per-thread shard of the
+// counter. A replaced Root is retired into the list of the current epoch;
+// once RECLAIM_BATCH wait there, the epoch flips, and when nothing is
+// active in the old epoch, its retired Roots are freed. A retired Root
+// keeps the nodes of its version alive until then.
+//
+// Insertion is Okasaki's; deletion is Kahrs'.
+//
+// ******************PUBLIC OPERATIONS*********************
+// Version snapshot( )    --> Return the current version
+// void insert( x )       --> Insert x
+// void remove( x )       --> Remove x
+// bool contains( x )     --> Return true if x is present
+// Comparable findMin( )  --> Return smallest item
+// Comparable findMax( )  --> Return largest item
+// bool isEmpty( )        --> Return true if empty; else false
+// void makeEmpty( )      --> Remove all items
+// Copying a tree copies its current version; copies share all nodes
+// void printTree( )      --> Print tree in sorted order
+// Version has contains, findMin, findMax, isEmpty and printTree too,
+// and Version insert( x ), remove( x ), which return a new version
+// ******************ERRORS********************************
+// Throws UnderflowException as warranted
+
+template <typename Comparable>
+class PersistentRedBlackTree
+{
+    struct RedBlackNode;
+    using NodePtr = shared_ptr<const RedBlackNode>;
+
+  public:
+    /**
+     * An immutable version of the tree. Copying is O( 1 ).
+     */
+    class Version
+    {
+      public:
+        Version( )
+          { }
+
+        bool contains( const Comparable & x ) const
+          { return PersistentRedBlackTree::contains( root.get( ), x ); }
+
+        const Comparable & findMin( ) const
+          { return PersistentRedBlackTree::findMin( root.get( ) ); }
+
+        const Comparable & findMax( ) const
+          { return PersistentRedBlackTree::findMax( root.get( ) ); }
+
+        bool isEmpty( ) const
+          { return root == nullptr; }
+
+        void printTree( ) const
+        {
+            if( isEmpty( ) )
+                cout << "Empty tree" << endl;
+            else
+                PersistentRedBlackTree::printTree( root.get( ) );
+        }
+
+        /**
+         * Return the version with x added; this version is unchanged.
+         * O( log N ) new nodes.
+         */
+        Version insert( const Comparable & x ) const
+        {
+            if( contains( x ) )
+                return *this;
+            return Version{ blacken( ins( root, x ) ) };
+        }
+
+        /**
+         * Return the version without x; this version is unchanged.
+         * O( log N ) new nodes.
+         */
+        Version remove( const Comparable & x ) const
+        {
+            if( !contains( x ) )    // del assumes x is present
+                return *this;
+            NodePtr t = del( root, x );
+            return Version{ t == nullptr ? t : blacken( t ) };
+        }
+
+      private:
+        NodePtr root;
+
+        explicit Version( NodePtr t ) : root{ std::move( t ) }
+          { }
+
+        friend class PersistentRedBlackTree;
+    };
+
+    PersistentRedBlackTree( ) : current{ new Root{ nullptr } }, theEpoch{ 0 }
+    {
+        for( Shard & s : shards )
+            s.active[ 0 ] = s.active[ 1 ] = 0;
+    }
+
+    /**
+     * Copy constructor; the copies share all nodes. O( 1 ).
+     */
+    PersistentRedBlackTree( const PersistentRedBlackTree & rhs )
+      : current{ new Root{ rhs.snapshot( ).root } }, theEpoch{ 0 }
+    {
+        for( Shard & s : shards )
+            s.active[ 0 ] = s.active[ 1 ] = 0;
+    }
+
+    PersistentRedBlackTree & operator=( const PersistentRedBlackTree & rhs )
+    {
+        publish( rhs.snapshot( ).root );
+        return *this;
+    }
+
+    /**
+     * Not to be called while other threads use the tree.
+     */
+    ~PersistentRedBlackTree( )
+    {
+        delete current.load( );
+        for( vector<const Root *> & r : retired )
+            for( const Root *p : r )
+                delete p;
+    }
+
+    /**
+     * Return the current version. Later updates do not affect it.
+     */
+    Version snapshot( ) const
+    {
+        Operation op{ this };
+        return Version{ current.load( )->tree };
+    }
+
+    bool contains( const Comparable & x ) const
+    {
+        Operation op{ this };
+        return contains( current.load( )->tree.get( ), x );
+    }
+
+    Comparable findMin( ) const
+    {
+        Operation op{ this };
+        return findMin( current.load( )->tree.get( ) );
+    }
+
+    Comparable findMax( ) const
+    {
+        Operation op{ this };
+        return findMax( current.load( )->tree.get( ) );
+    }
+
+    bool isEmpty( ) const
+    {
+        Operation op{ this };
+        return current.load( )->tree == nullptr;
+    }
+
+    void printTree( ) const
+      { snapshot( ).printTree( ); }
+
+    void makeEmpty( )
+      { publish( nullptr ); }
+
+    /**
+     * Insert x into the tree; duplicates are ignored.
+     */
+    void insert( const Comparable & x )
+    {
+        Operation op{ this };
+        const Root *old = current;
+        unique_ptr<Root> next{ new Root{ nullptr } };
+        do
+        {
+            next->tree = Version{ old->tree }.insert( x ).root;
+            if( next->tree == old->tree )   // x is present
+                return;
+        } while( !current.compare_exchange_weak( old, next.get( ) ) );
+        next.release( );
+        retire( old );
+    }
+
+    /**
+     * Remove x from the tree. Nothing is done if x is not found.
+     */
+    void remove( const Comparable & x )
+    {
+        Operation op{ this };
+        const Root *old = current;
+        unique_ptr<Root> next{ new Root{ nullptr } };
+        do
+        {
+            next->tree = Version{ old->tree }.remove( x ).root;
+            if( next->tree == old->tree )   // x is not present
+                return;
+        } while( !current.compare_exchange_weak( old, next.get( ) ) );
+        next.release( );
+        retire( old );
+    }
+
+  private:
+    enum { RED, BLACK };
+    static const int SHARDS = 16;
+    static const size_t RECLAIM_BATCH = 64;
+
+    struct RedBlackNode
+    {
+        Comparable element;
+        NodePtr    left;
+        NodePtr    right;
+        int        color;
+
+        RedBlackNode( int c, NodePtr lt, const Comparable & theElement, NodePtr rt )
+          : element{ theElement }, left{ std::move( lt ) }, right{ std::move( rt ) }, color{ c } { }
+    };
+
+    /**
+     * A published version. It is not changed once current points to it.
+     */
+    struct Root
+    {
+        NodePtr tree;
+    };
+
+    /**
+     * The per-thread active counts, one cache line each.
+     */
+    struct alignas( 64 ) Shard
+    {
+        mutable atomic<int> active[ 2 ];    // Operations, by epoch
+    };
+
+    /**
+     * Counts one operation as active for its lifetime.
+     */
+    class Operation
+    {
+      public:
+        explicit Operation( const PersistentRedBlackTree *t ) : tree{ t }, epoch{ t->enter( ) }
+          { }
+
+        ~Operation( )
+          { tree->leave( epoch ); }
+
+        Operation( const Operation & rhs ) = delete;
+        Operation & operator=( const Operation & rhs ) = delete;
+
+      private:
+        const PersistentRedBlackTree *tree;
+        int epoch;
+    };
+
+    atomic<const Root *> current;
+
+    Shard shards[ SHARDS ];
+    atomic<int> theEpoch;
+    vector<const Root *> retired[ 2 ];  // Replaced in each epoch, maybe still being read
+    mutex retiredLock;
+
+    /**
+     * Make t the current version, and retire the Root it replaces.
+     */
+    void publish( NodePtr t )
+    {
+        Operation op{ this };
+        retire( current.exchange( new Root{ std::move( t ) } ) );
+    }
+
+    /**
+     * Return the shard of the calling thread; threads take them in turn.
+     */
+    static int shard( )
+    {
+        static atomic<int> nextShard{ 0 };
+        thread_local int s = nextShard++ % SHARDS;
+        return s;
+    }
+
+    /**
+     * Count the caller as active in the current epoch, and return it.
+     * The epoch is checked again after counting, so a flip in between
+     * cannot go unnoticed.
+     */
+    int enter( ) const
+    {
+        atomic<int> *active = shards[ shard( ) ].active;
+        for( ; ; )
+        {
+            int e = theEpoch;
+            ++active[ e ];
+            if( theEpoch == e )
+                return e;
+            --active[ e ];
+        }
+    }
+
+    void leave( int e ) const
+      { --shards[ shard( ) ].active[ e ]; }
+
+    /**
+     * Return the number of operations active in epoch e.
+     */
+    int activeIn( int e ) const
+    {
+        int count = 0;
+        for( const Shard & s : shards )
+            count += s.active[ e ];
+        return count;
+    }
+
+    /**
+     * Retire the replaced Root p, and reclaim what is safe to.
+     * Roots retired in the other epoch are freed once nothing is active
+     * in it: all that could still read them started before they were
+     * replaced, so in that epoch or before the flip that ended it.
+     * Then, if enough Roots are waiting, flip to the other epoch.
+     */
+    void retire( const Root *p )
+    {
+        vector<const Root *> freed;
+        {
+            lock_guard<mutex> guard{ retiredLock };
+            int e = theEpoch;
+            retired[ e ].push_back( p );
+            if( activeIn( 1 - e ) == 0 )
+            {
+                freed.swap( retired[ 1 - e ] );
+                if( retired[ e ].size( ) >= RECLAIM_BATCH )
+                    theEpoch = 1 - e;
+            }
+        }
+        for( const Root *q : freed )
+            delete q;
+    }
+
+    /**
+     * Internal methods that search subtree t in place.
+     */
+    static bool contains( const RedBlackNode *t, const Comparable & x )
+    {
+        while( t != nullptr )
+            if( x < t->element )
+                t = t->left.get( );
+            else if( t->element < x )
+                t = t->right.get( );
+            else
+                return true;
+        return false;
+    }
+
+    static const Comparable & findMin( const RedBlackNode *t )
+    {
+        if( t == nullptr )
+            throw UnderflowException{ };
+        while( t->left != nullptr )
+            t = t->left.get( );
+        return t->element;
+    }
+
+    static const Comparable & findMax( const RedBlackNode *t )
+    {
+        if( t == nullptr )
+            throw UnderflowException{ };
+        while( t->right != nullptr )
+            t = t->right.get( );
+        return t->element;
+    }
+
+    /**
+     * Make a node with color c, children lt and rt.
+     */
+    static NodePtr node( int c, const NodePtr & lt, const Comparable & x, const NodePtr & rt )
+      { return make_shared<const RedBlackNode>( c, lt, x, rt ); }
+
+    static bool isRed( const NodePtr & t )
+      { return t != nullptr && t->color == RED; }
+
+    static bool isBlack( const NodePtr & t )
+      { return t != nullptr && t->color == BLACK; }
+
+    static NodePtr blacken( const NodePtr & t )
+      { return t->color == BLACK ? t : node( BLACK, t->left, t->element, t->right ); }
+
+    static NodePtr redden( const NodePtr & t )
+      { return node( RED, t->left, t->element, t->right ); }
+
+    /**
+     * Make a black node with children a and b, fixing a red child
+     * that has a red child. Both red children of a black node are
+     * also pushed up.
+     */
+    static NodePtr balance( const NodePtr & a, const Comparable & x, const NodePtr & b )
+    {
+        if( isRed( a ) && isRed( b ) )
+            return node( RED, blacken( a ), x, blacken( b ) );
+        if( isRed( a ) )
+        {
+            if( isRed( a->left ) )
+                return node( RED, blacken( a->left ), a->element,
+                             node( BLACK, a->right, x, b ) );
+            if( isRed( a->right ) )
+                return node( RED, node( BLACK, a->left, a->element, a->right->left ),
+                             a->right->element, node( BLACK, a->right->right, x, b ) );
+        }
+        if( isRed( b ) )
+        {
+            if( isRed( b->right ) )
+                return node( RED, node( BLACK, a, x, b->left ), b->element,
+                             blacken( b->right ) );
+            if( isRed( b->left ) )
+                return node( RED, node( BLACK, a, x, b->left->left ),
+                             b->left->element, node( BLACK, b->left->right, b->element, b->right ) );
+        }
+        return node( BLACK, a, x, b );
+    }
+
+    /**
+     * Internal method to insert x, which is not present, into subtree t.
+     * The result may be red with a red child.
+     */
+    static NodePtr ins( const NodePtr & t, const Comparable & x )
+    {
+        if( t == nullptr )
+            return node( RED, nullptr, x, nullptr );
+        if( x < t->element )
+            return t->color == BLACK ? balance( ins( t->left, x ), t->element, t->right )
+                                     : node( RED, ins( t->left, x ), t->element, t->right );
+        else
+            return t->color == BLACK ? balance( t->left, t->element, ins( t->right, x ) )
+                                     : node( RED, t->left, t->element, ins( t->right, x ) );
+    }
+
+    /**
+     * Internal method to remove x, which is present, from subtree t.
+     * If t is black, the black height of the result is one less.
+     */
+    static NodePtr del( const NodePtr & t, const Comparable & x )
+    {
+        if( x < t->element )
+            return isBlack( t->left ) ? balanceLeft( del( t->left, x ), t->element, t->right )
+                                      : node( RED, del( t->left, x ), t->element, t->right );
+        else if( t->element < x )
+            return isBlack( t->right ) ? balanceRight( t->left, t->element, del( t->right, x ) )
+                                       : node( RED, t->left, t->element, del( t->right, x ) );
+        else
+            return fuse( t->left, t->right );
+    }
+
+    /**
+     * Make a node from a, x, b, where the black height of a is one
+     * less than that of b.
+     */
+    static NodePtr balanceLeft( const NodePtr & a, const Comparable & x, const NodePtr & b )
+    {
+        if( isRed( a ) )
+            return node( RED, blacken( a ), x, b );
+        if( isBlack( b ) )
+            return balance( a, x, redden( b ) );
+            // b is red with a black left child
+        return node( RED, node( BLACK, a, x, b->left->left ), b->left->element,
+                     balance( b->left->right, b->element, redden( b->right ) ) );
+    }
+
+    /**
+     * Make a node from a, x, b, where the black height of b is one
+     * less than that of a.
+     */
+    static NodePtr balanceRight( const NodePtr & a, const Comparable & x, const NodePtr & b )
+    {
+        if( isRed( b ) )
+            return node( RED, a, x, blacken( b ) );
+        if( isBlack( a ) )
+            return balance( redden( a ), x, b );
+            // a is red with a black right child
+        return node( RED, balance( redden( a->left ), a->element, a->right->left ),
+                     a->right->element, node( BLACK, a->right->right, x, b ) );
+    }
+
+    /**
+     * Join subtrees a and b of equal black height, all of whose
+     * items in a are less than those in b.
+     */
+    static NodePtr fuse( const NodePtr & a, const NodePtr & b )
+    {
+        if( a == nullptr )
+            return b;
+        if( b == nullptr )
+            return a;
+        if( isRed( a ) && isRed( b ) )
+        {
+            NodePtr m = fuse( a->right, b->left );
+            if( isRed( m ) )
+                return node( RED, node( RED, a->left, a->element, m->left ), m->element,
+                             node( RED, m->right, b->element, b->right ) );
+            return node( RED, a->left, a->element, node( RED, m, b->element, b->right ) );
+        }
+        if( isBlack( a ) && isBlack( b ) )
+        {
+            NodePtr m = fuse( a->right, b->left );
+            if( isRed( m ) )
+                return node( RED, node( BLACK, a->left, a->element, m->left ), m->element,
+                             node( BLACK, m->right, b->element, b->right ) );
+            return balanceLeft( a->left, a->element, node( BLACK, m, b->element, b->right ) );
+        }
+        if( isRed( b ) )
+            return node( RED, fuse( a, b->left ), b->element, b->right );
+        return node( RED, a->left, a->element, fuse( a->right, b ) );
+    }
+
+    static void printTree( const RedBlackNode *t )
+    {
+        if( t != nullptr )
+        {
+            printTree( t->left.get( ) );
+            cout << t->element << endl;
+            printTree( t->right.get( ) );
+        }
+    }
+};
+
+#endif
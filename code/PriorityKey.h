@@ -0,0 +1,41 @@
+#ifndef PRIORITY_KEY_H
+#define PRIORITY_KEY_H
+
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+// Key extraction for the integer priority queues
+// (RadixHeap and BucketQueue).
+//
+// An item is either an unsigned integer, which is its own key,
+// or a pair whose first component is the unsigned integer key
+// and whose second component is a payload (e.g. a vertex number).
+
+/**
+ * Return the key of an unsigned integer item.
+ */
+template <typename Key>
+Key priorityKey( const Key & x )
+{
+    static_assert( is_unsigned<Key>::value, "priority keys must be unsigned" );
+    return x;
+}
+
+/**
+ * Return the key of a (key, payload) item.
+ */
+template <typename Key, typename Payload>
+Key priorityKey( const pair<Key, Payload> & x )
+{
+    static_assert( is_unsigned<Key>::value, "priority keys must be unsigned" );
+    return x.first;
+}
+
+/**
+ * The key type of a Comparable item.
+ */
+template <typename Comparable>
+using PriorityKeyType = decltype( priorityKey( declval<const Comparable &>( ) ) );
+
+#endif
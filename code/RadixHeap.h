@@ -0,0 +1,168 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include "dsexceptions.h"
+#include "PriorityKey.h"
+#include <limits>
+#include <vector>
+using namespace std;
+
+// RadixHeap class
+//
+// CONSTRUCTION: with no parameters
+//
+// Items are unsigned integer keys, or pairs whose first component
+// is an unsigned integer key (see PriorityKey.h).
+// The heap is monotone: an inserted key may not be smaller than the
+// key of the last item returned by findMin or deleteMin.
+//
+// ******************PUBLIC OPERATIONS*********************
+// void insert( x )       --> Insert x
+// deleteMin( minItem )   --> Remove (and optionally return) smallest item
+// Comparable findMin( )  --> Return smallest item
+// bool isEmpty( )        --> Return true if empty; else false
+// void makeEmpty( )      --> Remove all items
+// ******************ERRORS********************************
+// Throws UnderflowException as warranted
+// Throws IllegalArgumentException if insert violates monotonicity
+
+template <typename Comparable>
+class RadixHeap
+{
+  public:
+    using Key = PriorityKeyType<Comparable>;
+
+    RadixHeap( ) : buckets( NUM_BUCKETS ), currentSize{ 0 }, last{ 0 }
+    {
+    }
+
+    bool isEmpty( ) const
+      { return currentSize == 0; }
+
+    /**
+     * Find the smallest item in the priority queue.
+     * Return the smallest item, or throw Underflow if empty.
+     */
+    const Comparable & findMin( ) const
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+        refill( );
+        return buckets[ 0 ].back( );
+    }
+
+    /**
+     * Insert item x, allowing duplicates.
+     * Throws IllegalArgumentException if x's key is smaller than
+     * the key of the last item returned.
+     */
+    void insert( const Comparable & x )
+    {
+        Comparable copy = x;
+        insert( std::move( copy ) );
+    }
+
+    /**
+     * Insert item x, allowing duplicates.
+     * Throws IllegalArgumentException if x's key is smaller than
+     * the key of the last item returned.
+     */
+    void insert( Comparable && x )
+    {
+        Key k = priorityKey( x );
+        if( k < last )
+            throw IllegalArgumentException{ };
+
+        buckets[ bucketIndex( k ) ].push_back( std::move( x ) );
+        ++currentSize;
+    }
+
+    /**
+     * Remove the minimum item.
+     * Throws UnderflowException if empty.
+     */
+    void deleteMin( )
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+
+        refill( );
+        buckets[ 0 ].pop_back( );
+        --currentSize;
+    }
+
+    /**
+     * Remove the minimum item and place it in minItem.
+     * Throws UnderflowException if empty.
+     */
+    void deleteMin( Comparable & minItem )
+    {
+        if( isEmpty( ) )
+            throw UnderflowException{ };
+
+        refill( );
+        minItem = std::move( buckets[ 0 ].back( ) );
+        buckets[ 0 ].pop_back( );
+        --currentSize;
+    }
+
+    /**
+     * Make the priority queue logically empty.
+     * The monotonicity bound is reset as well.
+     */
+    void makeEmpty( )
+    {
+        for( auto & b : buckets )
+            b.clear( );
+        currentSize = 0;
+        last = 0;
+    }
+
+  private:
+    static const int NUM_BUCKETS = numeric_limits<Key>::digits + 1;
+
+    mutable vector<vector<Comparable>> buckets;  // buckets[ i ] holds keys differing
+                                                 // from last first at bit i - 1
+    int currentSize;                             // Number of elements in heap
+    mutable Key last;                            // Key of the last minimum
+
+    /**
+     * Return the bucket for key k: 0 if k equals last, otherwise
+     * one more than the position of the highest bit where k and last differ.
+     */
+    int bucketIndex( Key k ) const
+    {
+        unsigned long long diff = k ^ last;
+        return diff == 0 ? 0 : 64 - __builtin_clzll( diff );
+    }
+
+    /**
+     * Internal method to make bucket 0 hold the minimum items.
+     * If it is empty, the first nonempty bucket is scanned for its
+     * minimum key, which becomes last; its items then all move to
+     * strictly lower buckets. The heap must not be empty.
+     * Only the layout changes, so this is logically const.
+     */
+    void refill( ) const
+    {
+        if( !buckets[ 0 ].empty( ) )
+            return;
+
+        int i = 1;
+        while( buckets[ i ].empty( ) )
+            ++i;
+
+        Key newLast = priorityKey( buckets[ i ][ 0 ] );
+        for( auto & x : buckets[ i ] )
+            if( priorityKey( x ) < newLast )
+                newLast = priorityKey( x );
+        last = newLast;
+
+        vector<Comparable> old = std::move( buckets[ i ] );
+        buckets[ i ].clear( );
+        for( auto & x : old )
+            buckets[ bucketIndex( priorityKey( x ) ) ].push_back( std::move( x ) );
+    }
+};
+
+#endif
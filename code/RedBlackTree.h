@@ -2,13 +2,24 @@
 #define RED_BLACK_TREE_H
 
 #include "dsexceptions.h"
+#include "EytzingerSet.h"
+#include "NodeStorage.h"
+#include <algorithm>
+#include <future>
 #include <iostream> 
+#include <iterator>
+#include <utility>
+#include <vector>
 using namespace std;
 
 // Red-black tree class
 //
 // CONSTRUCTION: with negative infinity object also
-//               used to signal failed finds
+//               used to signal failed finds, and optionally a sorted
+//               random-access range (built in linear time, optionally
+//               by several threads)
+// Storage (HeapNodes or ArenaNodes, see NodeStorage.h) selects how
+// nodes are allocated and linked
 //
 // ******************PUBLIC OPERATIONS*********************
 // void insert( x )       --> Insert x
@@ -19,38 +30,187 @@ using namespace std;
 // bool isEmpty( )        --> Return true if empty; else false
 // void makeEmpty( )      --> Remove all items
 // void printTree( )      --> Print tree in sorted order
+// void unionWith( rhs )  --> Absorb rhs into this tree
+// const_iterator begin( ), end( )
+//                        --> Bidirectional in-order iteration
+// const_iterator lower_bound( x )
+//                        --> First item not less than x
+// const_iterator upper_bound( x )
+//                        --> First item greater than x
+// pair equal_range( x )  --> Iterators bounding the items equal to x
+// pair range( lo, hi )   --> Iterators bounding the items in [ lo, hi ]
+// EytzingerSet freeze( ) --> Return a read-only copy for fast lookups
 // ******************ERRORS********************************
 // Throws UnderflowException as warranted
+// Throws IteratorOutOfBoundsException if an iterator moves
+//     beyond begin( ) or end( )
 
-template <typename Comparable>
+template <typename Comparable, typename Storage = HeapNodes>
 class RedBlackTree
 {
+    struct RedBlackNode;
+    using NodePtr  = typename Storage::template pointer<RedBlackNode>;
+    using NodePool = typename Storage::template Pool<RedBlackNode>;
+
   public:
+    /**
+     * In-order iterator. Each step follows child and parent links,
+     * so a full scan takes linear time and no stack.
+     * Changing the tree invalidates all iterators.
+     */
+    class const_iterator
+    {
+      public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type        = Comparable;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const Comparable *;
+        using reference         = const Comparable &;
+
+        const_iterator( ) : tree{ nullptr }, current{ nullptr }
+          { }
+
+        const Comparable & operator* ( ) const
+          { return current->element; }
+
+        const Comparable * operator-> ( ) const
+          { return &current->element; }
+
+        const_iterator & operator++ ( )
+        {
+            if( current == nullptr )
+                throw IteratorOutOfBoundsException{ };
+            if( current->right != tree->nullNode )
+                current = tree->findMin( current->right );
+            else
+            {
+                NodePtr child;
+                do
+                {
+                    child = current;
+                    current = current->parent;
+                } while( current != nullptr && child == current->right );
+            }
+            return *this;
+        }
+
+        const_iterator operator++ ( int )
+        {
+            const_iterator old = *this;
+            ++( *this );
+            return old;
+        }
+
+        const_iterator & operator-- ( )
+        {
+            NodePtr p = current;
+            if( p == nullptr )
+                p = tree->isEmpty( ) ? nullptr : tree->findMax( tree->header->right );
+            else if( p->left != tree->nullNode )
+                p = tree->findMax( p->left );
+            else
+            {
+                NodePtr child;
+                do
+                {
+                    child = p;
+                    p = p->parent;
+                } while( p != nullptr && child == p->left );
+            }
+            if( p == nullptr )
+                throw IteratorOutOfBoundsException{ };
+            current = p;
+            return *this;
+        }
+
+        const_iterator operator-- ( int )
+        {
+            const_iterator old = *this;
+            --( *this );
+            return old;
+        }
+
+        bool operator== ( const const_iterator & rhs ) const
+          { return current == rhs.current; }
+
+        bool operator!= ( const const_iterator & rhs ) const
+          { return !( *this == rhs ); }
+
+      private:
+        const RedBlackTree *tree;
+        NodePtr current;    // nullptr for end( )
+
+        const_iterator( const RedBlackTree *t, NodePtr p )
+          : tree{ t }, current{ p }
+          { }
+
+        friend class RedBlackTree;
+    };
+
     /**
      * Construct the tree.
      * negInf is a value less than or equal to all others.
      */
     explicit RedBlackTree( const Comparable & negInf )
     {
-        nullNode    = new RedBlackNode;
+        nullNode    = pool.createSentinel( );
         nullNode->left = nullNode->right = nullNode;
         
-        header      = new RedBlackNode{ negInf };
+        header      = pool.createSentinel( negInf );
         header->left = header->right = nullNode;
     }
 
+    /**
+     * Construct the tree from the sorted range [ first, last )
+     * in linear time, without rotations. Duplicates are skipped.
+     * Subtrees are built by up to numThreads threads.
+     * negInf is a value less than or equal to all others.
+     */
+    template <typename RandomIterator>
+    RedBlackTree( const Comparable & negInf, RandomIterator first, RandomIterator last,
+                  int numThreads = 1 )
+      : RedBlackTree{ negInf }
+    {
+        auto notIncreasing = [ ]( const Comparable & a, const Comparable & b )
+                               { return !( a < b ); };
+        vector<Comparable> items;
+        if( adjacent_find( first, last, notIncreasing ) != last )
+        {
+            items.assign( first, last );
+            items.erase( unique( items.begin( ), items.end( ),
+                                 [ ]( const Comparable & a, const Comparable & b )
+                                   { return !( a < b ) && !( b < a ); } ),
+                         items.end( ) );
+        }
+
+            // In a perfectly balanced tree all leaves lie on the last two
+            // levels; the nodes on an incomplete last level are red
+        int n = items.empty( ) ? last - first : items.size( );
+        int fullLevels = 0;
+        while( ( 2 << fullLevels ) - 1 <= n )
+            ++fullLevels;
+        int redDepth = ( 1 << fullLevels ) - 1 == n ? -1 : fullLevels;
+
+        if( items.empty( ) )
+            header->right = buildSorted( first, last, 0, redDepth, numThreads );
+        else
+            header->right = buildSorted( items.begin( ), items.end( ), 0, redDepth, numThreads );
+        setRootParent( );
+    }
+
     RedBlackTree( const RedBlackTree & rhs )
     {
-        nullNode    = new RedBlackNode;
+        nullNode    = pool.createSentinel( );
         nullNode->left = nullNode->right = nullNode;
         
-        header      = new RedBlackNode{ rhs.header->element };
+        header      = pool.createSentinel( rhs.header->element );
         header->left = nullNode;
         header->right = clone( rhs.header->right );
+        setRootParent( );
     }
 
     RedBlackTree( RedBlackTree && rhs )
-      : nullNode{ rhs.nullNode }, header{ rhs.header }
+      : header{ rhs.header }, nullNode{ rhs.nullNode }, pool{ std::move( rhs.pool ) }
     {
         rhs.nullNode = nullptr;
         rhs.header = nullptr;
@@ -59,8 +219,8 @@ class RedBlackTree
     ~RedBlackTree( )
     {
         makeEmpty( );
-        delete nullNode;
-        delete header;
+        pool.destroySentinel( nullNode );
+        pool.destroySentinel( header );
     }
     
     /**
@@ -80,6 +240,7 @@ class RedBlackTree
     {
         std::swap( header, rhs.header );
         std::swap( nullNode, rhs.nullNode );
+        pool.swap( rhs.pool );
         
         return *this;
     }
@@ -89,7 +250,7 @@ class RedBlackTree
         if( isEmpty( ) )
             throw UnderflowException{ };
 
-        RedBlackNode *itr = header->right;
+        NodePtr itr = header->right;
 
         while( itr->left != nullNode )
             itr = itr->left;
@@ -102,7 +263,7 @@ class RedBlackTree
         if( isEmpty( ) )
             throw UnderflowException{ };
 
-        RedBlackNode *itr = header->right;
+        NodePtr itr = header->right;
 
         while( itr->right != nullNode )
             itr = itr->right;
@@ -110,20 +271,24 @@ class RedBlackTree
         return itr->element;
     }
 
+    /**
+     * Returns true if x is found. Does not store x in nullNode,
+     * so concurrent calls are safe.
+     */
     bool contains( const Comparable & x ) const
     {
-        nullNode->element = x;
-        RedBlackNode *curr = header->right;
+        NodePtr curr = header->right;
 
-        for( ; ; )
+        while( curr != nullNode )
         {
             if( x < curr->element )
                 curr = curr->left;
             else if( curr->element < x )
                 curr = curr->right;
             else
-                return curr != nullNode;
+                return true;
         }
+        return false;
     }
 
     bool isEmpty( ) const
@@ -139,12 +304,83 @@ class RedBlackTree
             printTree( header->right );
     }
 
+    const_iterator begin( ) const
+      { return const_iterator{ this, isEmpty( ) ? nullptr : findMin( header->right ) }; }
+
+    const_iterator end( ) const
+      { return const_iterator{ this, nullptr }; }
+
+    /**
+     * Return an iterator to the first item not less than x.
+     */
+    const_iterator lower_bound( const Comparable & x ) const
+    {
+        NodePtr bound = nullptr;
+        for( NodePtr t = header->right; t != nullNode; )
+            if( t->element < x )
+                t = t->right;
+            else
+            {
+                bound = t;
+                t = t->left;
+            }
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * Return an iterator to the first item greater than x.
+     */
+    const_iterator upper_bound( const Comparable & x ) const
+    {
+        NodePtr bound = nullptr;
+        for( NodePtr t = header->right; t != nullNode; )
+            if( x < t->element )
+            {
+                bound = t;
+                t = t->left;
+            }
+            else
+                t = t->right;
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * Return the iterators bounding the items equal to x,
+     * as lower_bound( x ) and upper_bound( x ).
+     */
+    pair<const_iterator, const_iterator> equal_range( const Comparable & x ) const
+    {
+        return { lower_bound( x ), upper_bound( x ) };
+    }
+
+    /**
+     * Return the iterators bounding the items in the closed range [ lo, hi ].
+     */
+    pair<const_iterator, const_iterator> range( const Comparable & lo,
+                                                const Comparable & hi ) const
+    {
+        return { lower_bound( lo ), upper_bound( hi ) };
+    }
+
+    /**
+     * Return a read-only copy of the items, laid out for fast lookups.
+     * The items are read in order through the iterators, so no
+     * recursion and no temporary copy are needed.
+     */
+    EytzingerSet<Comparable> freeze( ) const
+    {
+        return EytzingerSet<Comparable>{ begin( ), end( ) };
+    }
+
     void makeEmpty( )
     {
         if( header == nullptr )
             return;
         
-        reclaimMemory( header->right );
+        if( NodePool::BULK_RELEASE )    // Arena nodes need no destructor
+            pool.releaseAll( );
+        else
+            reclaimMemory( header->right );
         header->right = nullNode;
     }
 
@@ -169,13 +405,15 @@ class RedBlackTree
             // Insertion fails if already present
         if( current != nullNode )
             return;
-        current = new RedBlackNode{ x, nullNode, nullNode };
+        current = pool.create( x, nullNode, nullNode );
 
             // Attach to parent
         if( x < parent->element )
             parent->left = current;
         else
             parent->right = current;
+        if( parent != header )
+            current->parent = parent;
         handleReorient( x );
     }
 
@@ -185,47 +423,72 @@ class RedBlackTree
                 " still present" << endl;
     }
 
+    /**
+     * Merge rhs into the tree, with the join-based union.
+     * If rhs has m items and this tree n >= m, this takes
+     * O( m log( n / m + 1 ) ) time, plus O( m ) to adopt rhs's nodes.
+     * rhs becomes empty. rhs must be different from this.
+     */
+    void unionWith( RedBlackTree & rhs )
+    {
+        if( this == &rhs )    // Avoid aliasing problems
+            return;
+
+        NodePtr t2 = adopt( rhs.header->right, rhs.nullNode );
+        rhs.header->right = rhs.nullNode;
+        pool.splice( rhs.pool );
+
+        int bh;
+        header->right = unionOf( header->right, blackHeight( header->right ),
+                                 t2, blackHeight( t2 ), bh );
+        header->right->color = BLACK;
+        setRootParent( );
+    }
+
   private:
     enum { RED, BLACK };
-    
+
     struct RedBlackNode
     {
         Comparable    element;
-        RedBlackNode *left;
-        RedBlackNode *right;
+        NodePtr       left;
+        NodePtr       right;
+        NodePtr       parent;   // nullptr for the root
         int           color;
 
         RedBlackNode( const Comparable & theElement = Comparable{ },
-                            RedBlackNode *lt = nullptr, RedBlackNode *rt = nullptr,
+                            NodePtr lt = nullptr, NodePtr rt = nullptr,
                             int c = BLACK )
-          : element{ theElement }, left{ lt }, right{ rt }, color{ c } { }
+          : element{ theElement }, left{ lt }, right{ rt }, parent{ nullptr }, color{ c } { }
         
-        RedBlackNode( Comparable && theElement, RedBlackNode *lt = nullptr,
-                      RedBlackNode *rt = nullptr, int c = BLACK )
-          : element{ std::move( theElement ) }, left{ lt }, right{ rt }, color{ c } { }
+        RedBlackNode( Comparable && theElement, NodePtr lt = nullptr,
+                      NodePtr rt = nullptr, int c = BLACK )
+          : element{ std::move( theElement ) }, left{ lt }, right{ rt }, parent{ nullptr },
+            color{ c } { }
     };
 
-    RedBlackNode *header;   // The tree header (contains negInf)
-    RedBlackNode *nullNode;
+    NodePtr header;   // The tree header (contains negInf)
+    NodePtr nullNode;
+    NodePool pool;
 
         // Used in insert routine and its helpers (logically static)
-    RedBlackNode *current;
-    RedBlackNode *parent;
-    RedBlackNode *grand;
-    RedBlackNode *great;
+    NodePtr current;
+    NodePtr parent;
+    NodePtr grand;
+    NodePtr great;
 
         // Usual recursive stuff
-    void reclaimMemory( RedBlackNode *t )
+    void reclaimMemory( NodePtr t )
     {
         if( t != t->left )
         {
             reclaimMemory( t->left );
             reclaimMemory( t->right );
-            delete t;
+            pool.destroy( t );
         }
     }
 
-    void printTree( RedBlackNode *t ) const
+    void printTree( NodePtr t ) const
     {
         if( t != t->left )
         {
@@ -235,13 +498,284 @@ class RedBlackTree
         }
     }
 
-    RedBlackNode * clone( RedBlackNode * t ) const
+    NodePtr clone( NodePtr t )
     {
         if( t == t->left )  // Cannot test against nullNode!!!
             return nullNode;
+
+        NodePtr copy = pool.create( t->element, clone( t->left ),
+                                    clone( t->right ), t->color );
+        setParents( copy );
+        return copy;
+    }
+
+    /**
+     * Internal method to find the smallest item in a nonempty subtree t.
+     * Return node containing the smallest item.
+     */
+    NodePtr findMin( NodePtr t ) const
+    {
+        while( t->left != nullNode )
+            t = t->left;
+        return t;
+    }
+
+    /**
+     * Internal method to find the largest item in a nonempty subtree t.
+     * Return node containing the largest item.
+     */
+    NodePtr findMax( NodePtr t ) const
+    {
+        while( t->right != nullNode )
+            t = t->right;
+        return t;
+    }
+
+    /**
+     * Point the parent links of t's children at t.
+     * nullNode's link is never set. A node's own parent link is set
+     * when its parent is fixed, or by setRootParent for the root.
+     */
+    void setParents( NodePtr t )
+    {
+        if( t->left != nullNode )
+            t->left->parent = t;
+        if( t->right != nullNode )
+            t->right->parent = t;
+    }
+
+    void setRootParent( )
+    {
+        if( header->right != nullNode )
+            header->right->parent = nullptr;
+    }
+
+        // Bulk construction and join-based set operations
+    /**
+     * Internal method to build a perfectly balanced subtree from the
+     * strictly increasing range [ first, last ), whose root is at depth.
+     * Nodes at redDepth are red, all others black.
+     * The left half is built on another thread while more than one
+     * thread is available and the node pool allows it.
+     */
+    template <typename RandomIterator>
+    NodePtr buildSorted( RandomIterator first, RandomIterator last,
+                         int depth, int redDepth, int numThreads )
+    {
+        if( first == last )
+            return nullNode;
+
+        RandomIterator mid = first + ( last - first ) / 2;
+        NodePtr lt;
+        NodePtr rt;
+        if( numThreads > 1 && NodePool::CONCURRENT_CREATE )
+        {
+            auto left = async( launch::async, [ = ] {
+                return buildSorted( first, mid, depth + 1, redDepth, numThreads / 2 ); } );
+            rt = buildSorted( mid + 1, last, depth + 1, redDepth, numThreads - numThreads / 2 );
+            lt = left.get( );
+        }
         else
-            return new RedBlackNode{ t->element, clone( t->left ),
-                                     clone( t->right ), t->color };
+        {
+            lt = buildSorted( first, mid, depth + 1, redDepth, 1 );
+            rt = buildSorted( mid + 1, last, depth + 1, redDepth, 1 );
+        }
+        NodePtr t = pool.create( *mid, lt, rt, depth == redDepth ? RED : BLACK );
+        setParents( t );
+        return t;
+    }
+
+    /**
+     * Return the black height of subtree t: the number of black
+     * nodes on any path from t down to (but excluding) nullNode.
+     */
+    int blackHeight( NodePtr t ) const
+    {
+        int bh = 0;
+        for( ; t != nullNode; t = t->left )
+            if( t->color == BLACK )
+                ++bh;
+        return bh;
+    }
+
+    /**
+     * Internal method to make the nodes of subtree t, whose empty
+     * links point to otherNull, use this tree's nullNode.
+     * Return t.
+     */
+    NodePtr adopt( NodePtr t, NodePtr otherNull )
+    {
+        if( t == otherNull )
+            return nullNode;
+        t->left = adopt( t->left, otherNull );
+        t->right = adopt( t->right, otherNull );
+        return t;
+    }
+
+    /**
+     * Internal method to join red-black trees l and r, of black heights
+     * bl and br, where every item of l is less than k->element and every
+     * item of r is greater, using node k as the glue.
+     * The result has a black root; its black height is placed in bh.
+     * Runs in O( |bl - br| ) time.
+     */
+    NodePtr join( NodePtr l, int bl, NodePtr k, NodePtr r, int br, int & bh )
+    {
+        if( l->color == RED )
+        {
+            l->color = BLACK;
+            ++bl;
+        }
+        if( r->color == RED )
+        {
+            r->color = BLACK;
+            ++br;
+        }
+
+        NodePtr t;
+        if( bl > br )
+            t = joinRight( l, bl, k, r, br );
+        else if( br > bl )
+            t = joinLeft( l, bl, k, r, br );
+        else
+        {
+            k->left = l;
+            k->right = r;
+            k->color = RED;
+            setParents( k );
+            t = k;
+        }
+
+        bh = max( bl, br );
+        if( t->color == RED )
+        {
+            t->color = BLACK;
+            ++bh;
+        }
+        return t;
+    }
+
+    /**
+     * Internal method to attach r (black root) at the right spine of l,
+     * where bl > br; the node where it is attached becomes red, and a
+     * resulting red-red violation is fixed by a rotation one level up.
+     */
+    NodePtr joinRight( NodePtr l, int bl, NodePtr k, NodePtr r, int br )
+    {
+        if( l->color == BLACK && bl == br )
+        {
+            k->left = l;
+            k->right = r;
+            k->color = RED;
+            setParents( k );
+            return k;
+        }
+
+        l->right = joinRight( l->right, l->color == BLACK ? bl - 1 : bl, k, r, br );
+        setParents( l );
+        if( l->color == BLACK && l->right->color == RED && l->right->right->color == RED )
+        {
+            l->right->right->color = BLACK;
+            rotateWithRightChild( l );
+        }
+        return l;
+    }
+
+    /**
+     * Mirror image of joinRight, for br > bl.
+     */
+    NodePtr joinLeft( NodePtr l, int bl, NodePtr k, NodePtr r, int br )
+    {
+        if( r->color == BLACK && bl == br )
+        {
+            k->left = l;
+            k->right = r;
+            k->color = RED;
+            setParents( k );
+            return k;
+        }
+
+        r->left = joinLeft( l, bl, k, r->left, r->color == BLACK ? br - 1 : br );
+        setParents( r );
+        if( r->color == BLACK && r->left->color == RED && r->left->left->color == RED )
+        {
+            r->left->left->color = BLACK;
+            rotateWithLeftChild( r );
+        }
+        return r;
+    }
+
+    /**
+     * Internal method to split subtree t, of black height bt, around x
+     * into l, holding the items less than x, and r, holding the items
+     * greater than x; their black heights are placed in bl and br.
+     * Return the node containing x, detached, or nullptr if x is absent.
+     */
+    NodePtr split( NodePtr t, int bt, const Comparable & x,
+                   NodePtr & l, int & bl, NodePtr & r, int & br )
+    {
+        if( t == nullNode )
+        {
+            l = r = nullNode;
+            bl = br = 0;
+            return nullptr;
+        }
+
+        NodePtr tl = t->left;
+        NodePtr tr = t->right;
+        int bc = t->color == BLACK ? bt - 1 : bt;   // Black height of the children
+        NodePtr match;
+        if( x < t->element )
+        {
+            int b;
+            match = split( tl, bc, x, l, bl, r, b );
+            r = join( r, b, t, tr, bc, br );
+        }
+        else if( t->element < x )
+        {
+            int b;
+            match = split( tr, bc, x, l, b, r, br );
+            l = join( tl, bc, t, l, b, bl );
+        }
+        else
+        {
+            l = tl;
+            r = tr;
+            bl = br = bc;
+            match = t;
+        }
+        return match;
+    }
+
+    /**
+     * Internal method to form the union of subtrees t1 and t2, of black
+     * heights b1 and b2, splitting t2 around the root of t1 and joining
+     * the unions of the halves. Nodes of t2 holding duplicates are deleted.
+     * The black height of the union is placed in bh.
+     * Return the root of the union.
+     */
+    NodePtr unionOf( NodePtr t1, int b1, NodePtr t2, int b2, int & bh )
+    {
+        if( t1 == nullNode )
+        {
+            bh = b2;
+            return t2;
+        }
+        if( t2 == nullNode )
+        {
+            bh = b1;
+            return t1;
+        }
+
+        NodePtr l2, r2;
+        int bl2, br2;
+        pool.destroy( split( t2, b2, t1->element, l2, bl2, r2, br2 ) );
+
+        int bc = t1->color == BLACK ? b1 - 1 : b1;
+        int bl, br;
+        NodePtr lt = unionOf( t1->left, bc, l2, bl2, bl );
+        NodePtr rt = unionOf( t1->right, bc, r2, br2, br );
+        return join( lt, bl, t1, rt, br, bh );
     }
 
         // Red-black tree manipulations
@@ -275,7 +809,7 @@ class RedBlackTree
      * theParent is the parent of the root of the rotated subtree.
      * Return the root of the rotated subtree.
      */
-    RedBlackNode * rotate( const Comparable & item, RedBlackNode *theParent )
+    NodePtr rotate( const Comparable & item, NodePtr theParent )
     {
         if( item < theParent->element )
         {
@@ -293,19 +827,29 @@ class RedBlackTree
         }
     }
 
-    void rotateWithLeftChild( RedBlackNode * & k2 )
+    /**
+     * Rotations, keeping the parent links: the new subtree root
+     * takes over the parent of the old one.
+     */
+    void rotateWithLeftChild( NodePtr & k2 )
     {
-        RedBlackNode *k1 = k2->left;
+        NodePtr k1 = k2->left;
         k2->left = k1->right;
         k1->right = k2;
+        k1->parent = k2->parent;
+        setParents( k2 );
+        setParents( k1 );
         k2 = k1;
     }
 
-    void rotateWithRightChild( RedBlackNode * & k1 )
+    void rotateWithRightChild( NodePtr & k1 )
     {
-        RedBlackNode *k2 = k1->right;
+        NodePtr k2 = k1->right;
         k1->right = k2->left;
         k2->left = k1;
+        k2->parent = k1->parent;
+        setParents( k1 );
+        setParents( k2 );
         k1 = k2;
     }
 };
@@ -10,6 +10,14 @@
 #include <functional>
 using namespace std;
 
+    // Internal methods used before they are defined; without these
+    // declarations, argument-dependent lookup finds std::merge
+template <typename Comparable>
+void percDown( vector<Comparable> & a, int i, int n );
+template <typename Comparable>
+void merge( vector<Comparable> & a, vector<Comparable> & tmpArray,
+            int leftPos, int rightPos, int rightEnd );
+
 /**
  * Simple insertion sort.
  */
@@ -2,53 +2,198 @@
 #define SPLAY_TREE_H
 
 #include "dsexceptions.h"
+#include "NodeStorage.h"
+#include "EytzingerSet.h"
+#include "UniformRandom.h"
 #include <iostream>     
+#include <iterator>
+#include <utility>
+#include <vector>
 using namespace std;
 
 // SplayTree class
 //
 // CONSTRUCTION: with no parameters
+// Storage (HeapNodes or ArenaNodes, see NodeStorage.h) selects how
+// nodes are allocated and linked
 //
 // ******************PUBLIC OPERATIONS*********************
 // void insert( x )       --> Insert x
 // void remove( x )       --> Remove x
-// bool contains( x )     --> Return true if x is present
+// bool contains( x )     --> Return true if x is present (may splay)
+// bool peek( x )         --> Return true if x is present; never splays
 // Comparable findMin( )  --> Return smallest item
 // Comparable findMax( )  --> Return largest item
 // bool isEmpty( )        --> Return true if empty; else false
 // void makeEmpty( )      --> Remove all items
 // void printTree( )      --> Print tree in sorted order
+// EytzingerSet freeze( ) --> Return a read-only copy for fast lookups
+// int size( )            --> Return number of items
+// void setSplayMode( mode, parameter )
+//                        --> Choose how contains reshapes the tree
+// const_iterator begin( ), end( )
+//                        --> Bidirectional in-order iteration
+// const_iterator lower_bound( x )
+//                        --> First item not less than x
+// const_iterator upper_bound( x )
+//                        --> First item greater than x
+// pair equal_range( x )  --> Iterators bounding the items equal to x
+// pair range( lo, hi )   --> Iterators bounding the items in [ lo, hi ]
 // ******************ERRORS********************************
 // Throws UnderflowException as warranted
-
-template <typename Comparable>
+// Throws IteratorOutOfBoundsException if an iterator moves
+//     beyond begin( ) or end( )
+
+// How contains restructures the tree. insert, remove, findMin and
+// findMax always splay. contains may splay in every mode, so it
+// changes the tree; readers sharing a tree must use peek instead.
+// SPLAY          --> Splay the accessed node to the root (the default)
+// SEMI_SPLAY     --> Semi-splay: rotate once per two levels, roughly
+//                    halving the depth of the access path. The node
+//                    moves up, but need not reach the root
+// RANDOM_SPLAY   --> Splay with probability parameter; otherwise
+//                    just search
+// DEPTH_SPLAY    --> Splay only if the accessed node is deeper than
+//                    parameter * log2( N ); otherwise just search
+enum class SplayMode { SPLAY, SEMI_SPLAY, RANDOM_SPLAY, DEPTH_SPLAY };
+
+template <typename Comparable, typename Storage = HeapNodes>
 class SplayTree
 {
+    struct BinaryNode;
+    using NodePtr  = typename Storage::template pointer<BinaryNode>;
+    using NodePool = typename Storage::template Pool<BinaryNode>;
+
   public:
-    SplayTree( )
+    /**
+     * In-order iterator. Each step follows child and parent links,
+     * so a full scan takes linear time and no stack. Iterating and
+     * the bound searches do not splay.
+     * Changing the tree (including a splaying contains) invalidates
+     * all iterators.
+     */
+    class const_iterator
+    {
+      public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type        = Comparable;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const Comparable *;
+        using reference         = const Comparable &;
+
+        const_iterator( ) : tree{ nullptr }, current{ nullptr }
+          { }
+
+        const Comparable & operator* ( ) const
+          { return current->element; }
+
+        const Comparable * operator-> ( ) const
+          { return &current->element; }
+
+        const_iterator & operator++ ( )
+        {
+            if( current == nullptr )
+                throw IteratorOutOfBoundsException{ };
+            if( current->right != tree->nullNode )
+                current = tree->findMin( current->right );
+            else
+            {
+                NodePtr child;
+                do
+                {
+                    child = current;
+                    current = current->parent;
+                } while( current != nullptr && child == current->right );
+            }
+            return *this;
+        }
+
+        const_iterator operator++ ( int )
+        {
+            const_iterator old = *this;
+            ++( *this );
+            return old;
+        }
+
+        const_iterator & operator-- ( )
+        {
+            NodePtr p = current;
+            if( p == nullptr )
+                p = tree->isEmpty( ) ? nullptr : tree->findMax( tree->root );
+            else if( p->left != tree->nullNode )
+                p = tree->findMax( p->left );
+            else
+            {
+                NodePtr child;
+                do
+                {
+                    child = p;
+                    p = p->parent;
+                } while( p != nullptr && child == p->left );
+            }
+            if( p == nullptr )
+                throw IteratorOutOfBoundsException{ };
+            current = p;
+            return *this;
+        }
+
+        const_iterator operator-- ( int )
+        {
+            const_iterator old = *this;
+            --( *this );
+            return old;
+        }
+
+        bool operator== ( const const_iterator & rhs ) const
+          { return current == rhs.current; }
+
+        bool operator!= ( const const_iterator & rhs ) const
+          { return !( *this == rhs ); }
+
+      private:
+        const SplayTree *tree;
+        NodePtr current;    // nullptr for end( )
+
+        const_iterator( const SplayTree *t, NodePtr p )
+          : tree{ t }, current{ p }
+          { }
+
+        friend class SplayTree;
+    };
+
+    SplayTree( ) : theSize{ 0 }, mode{ SplayMode::SPLAY }, parameter{ 0 }
     {
-        nullNode = new BinaryNode;
+        nullNode = pool.createSentinel( );
         nullNode->left = nullNode->right = nullNode;
+        header = pool.createSentinel( );
         root = nullNode;
     }
 
     SplayTree( const SplayTree & rhs )
+      : theSize{ rhs.theSize }, mode{ rhs.mode }, parameter{ rhs.parameter }
     {
-        nullNode = new BinaryNode;
+        nullNode = pool.createSentinel( );
         nullNode->left = nullNode->right = nullNode;
+        header = pool.createSentinel( );
         root = clone( rhs.root );
     }
 
-    SplayTree( SplayTree && rhs ) : root{ rhs.root }, nullNode{ rhs.nullNode }
+    SplayTree( SplayTree && rhs )
+      : root{ rhs.root }, nullNode{ rhs.nullNode }, header{ rhs.header },
+        pool{ std::move( rhs.pool ) }, theSize{ rhs.theSize }, mode{ rhs.mode },
+        parameter{ rhs.parameter }
     {
         rhs.root = nullptr;
         rhs.nullNode = nullptr;
+        rhs.header = nullptr;
+        rhs.theSize = 0;
     }
     
     ~SplayTree( )
     {
         makeEmpty( );
-        delete nullNode;
+        pool.destroySentinel( nullNode );
+        pool.destroySentinel( header );
     }
 
     
@@ -69,6 +214,11 @@ class SplayTree
     {
         std::swap( root, rhs.root );
         std::swap( nullNode, rhs.nullNode );
+        std::swap( header, rhs.header );
+        pool.swap( rhs.pool );
+        std::swap( theSize, rhs.theSize );
+        std::swap( mode, rhs.mode );
+        std::swap( parameter, rhs.parameter );
         
         return *this;
     }
@@ -86,7 +236,7 @@ class SplayTree
         if( isEmpty( ) )
             throw UnderflowException{ };
 
-        BinaryNode *ptr = root;
+        NodePtr ptr = root;
 
         while( ptr->left != nullNode )
             ptr = ptr->left;
@@ -108,7 +258,7 @@ class SplayTree
         if( isEmpty( ) )
             throw UnderflowException{ };
 
-        BinaryNode *ptr = root;
+        NodePtr ptr = root;
 
         while( ptr->right != nullNode )
             ptr = ptr->right;
@@ -118,19 +268,70 @@ class SplayTree
     }
 
 
+    /**
+     * Return true if x is found. How the tree is reshaped
+     * depends on the mode set by setSplayMode.
+     */
     bool contains( const Comparable & x )
     {
         if( isEmpty( ) )
             return false;
+
+        int depth;
+        switch( mode )
+        {
+          case SplayMode::SEMI_SPLAY:
+            return semiSplay( x );
+          case SplayMode::RANDOM_SPLAY:
+            if( randomNums( ).nextDouble( ) >= parameter )
+                return find( x, depth );
+            break;
+          case SplayMode::DEPTH_SPLAY:
+          {
+            bool found = find( x, depth );
+            if( depth <= depthLimit( ) )
+                return found;
+            break;
+          }
+          default:
+            break;
+        }
         splay( x, root );
         return root->element == x;
     }
 
+    /**
+     * Return true if x is found, without reshaping the tree.
+     * Unlike contains, this only reads, so any number of threads
+     * may call it at once while no thread changes the tree.
+     */
+    bool peek( const Comparable & x ) const
+    {
+        int depth;
+        return !isEmpty( ) && find( x, depth );
+    }
+
+    /**
+     * Choose how contains reshapes the tree; see SplayMode.
+     * parameter is the splay probability for RANDOM_SPLAY and the
+     * factor c of the depth limit c * log2( N ) for DEPTH_SPLAY.
+     */
+    void setSplayMode( SplayMode newMode, double newParameter = 0 )
+    {
+        mode = newMode;
+        parameter = newParameter;
+    }
+
     bool isEmpty( ) const
     {
         return root == nullNode;
     }
 
+    int size( ) const
+    {
+        return theSize;
+    }
+
     void printTree( ) const
     {
         if( isEmpty( ) )
@@ -139,8 +340,86 @@ class SplayTree
             printTree( root );
     }
 
+    const_iterator begin( ) const
+      { return const_iterator{ this, isEmpty( ) ? nullptr : findMin( root ) }; }
+
+    const_iterator end( ) const
+      { return const_iterator{ this, nullptr }; }
+
+    /**
+     * Return an iterator to the first item not less than x.
+     * Does not splay.
+     */
+    const_iterator lower_bound( const Comparable & x ) const
+    {
+        NodePtr bound = nullptr;
+        for( NodePtr t = root; t != nullNode; )
+            if( t->element < x )
+                t = t->right;
+            else
+            {
+                bound = t;
+                t = t->left;
+            }
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * Return an iterator to the first item greater than x.
+     * Does not splay.
+     */
+    const_iterator upper_bound( const Comparable & x ) const
+    {
+        NodePtr bound = nullptr;
+        for( NodePtr t = root; t != nullNode; )
+            if( x < t->element )
+            {
+                bound = t;
+                t = t->left;
+            }
+            else
+                t = t->right;
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * Return the iterators bounding the items equal to x,
+     * as lower_bound( x ) and upper_bound( x ).
+     */
+    pair<const_iterator, const_iterator> equal_range( const Comparable & x ) const
+    {
+        return { lower_bound( x ), upper_bound( x ) };
+    }
+
+    /**
+     * Return the iterators bounding the items in the closed range [ lo, hi ].
+     */
+    pair<const_iterator, const_iterator> range( const Comparable & lo,
+                                                const Comparable & hi ) const
+    {
+        return { lower_bound( lo ), upper_bound( hi ) };
+    }
+
+    /**
+     * Return a read-only copy of the items, laid out for fast lookups.
+     * Unlike contains, searches in the copy do not reshape anything.
+     * The items are read in order through the iterators, so no
+     * recursion and no temporary copy are needed.
+     */
+    EytzingerSet<Comparable> freeze( ) const
+    {
+        return EytzingerSet<Comparable>{ begin( ), end( ) };
+    }
+
     void makeEmpty( )
     {
+        if( NodePool::BULK_RELEASE )    // Arena nodes need no destructor
+        {
+            pool.releaseAll( );
+            root = nullNode;
+            theSize = 0;
+            return;
+        }
     /******************************
      * Comment this out, because it is prone to excessive
      * recursion on degenerate trees. Use alternate algorithm.
@@ -157,48 +436,44 @@ class SplayTree
 
     void insert( const Comparable & x )
     {
-        static BinaryNode *newNode = nullptr;
-
-        if( newNode == nullptr )
-            newNode = new BinaryNode;
-        newNode->element = x;
-
         if( root == nullNode )
         {
-            newNode->left = newNode->right = nullNode;
-            root = newNode;
+            root = pool.create( x, nullNode, nullNode );
+            ++theSize;
         }
         else
         {
             splay( x, root );
             if( x < root->element )
             {
-                newNode->left = root->left;
-                newNode->right = root;
+                NodePtr newNode = pool.create( x, root->left, root );
                 root->left = nullNode;
+                setParents( newNode );
                 root = newNode;
+                ++theSize;
             }
             else
             if( root->element < x )
             {
-                newNode->right = root->right;
-                newNode->left = root;
+                NodePtr newNode = pool.create( x, root, root->right );
                 root->right = nullNode;
+                setParents( newNode );
                 root = newNode;
+                ++theSize;
             }
-            else
-                return;
+            // else duplicate; do nothing
         }
-        newNode = nullptr;   // So next insert will call new
     }
 
     void remove( const Comparable & x )
     {
-            // If x is found, it will be splayed to the root by contains
-        if( !contains( x ) )
+        if( isEmpty( ) )
+            return;
+        splay( x, root );    // If x is found, it is now at the root
+        if( !( root->element == x ) )
             return;   // Item not found; do nothing
 
-        BinaryNode *newTree;
+        NodePtr newTree;
 
         if( root->left == nullNode )
             newTree = root->right;
@@ -209,38 +484,49 @@ class SplayTree
             newTree = root->left;
             splay( x, newTree );
             newTree->right = root->right;
+            setParents( newTree );
         }
-        delete root;
+        pool.destroy( root );
         root = newTree;
+        setRootParent( );
+        --theSize;
     }
 
 private:
     struct BinaryNode
     {
         Comparable  element;
-        BinaryNode *left;
-        BinaryNode *right;
+        NodePtr     left;
+        NodePtr     right;
+        NodePtr     parent;     // nullptr for the root
 
-        BinaryNode( ) : left{ nullptr }, right{ nullptr } { }
+        BinaryNode( ) : left{ nullptr }, right{ nullptr }, parent{ nullptr } { }
         
-        BinaryNode( const Comparable & theElement, BinaryNode *lt, BinaryNode *rt )
-            : element{ theElement }, left{ lt }, right{ rt } { }       
+        BinaryNode( const Comparable & theElement, NodePtr lt, NodePtr rt )
+            : element{ theElement }, left{ lt }, right{ rt }, parent{ nullptr } { }       
     };
     
-    BinaryNode *root;
-    BinaryNode *nullNode;
+    NodePtr root;
+    NodePtr nullNode;
+    NodePtr header;     // Holds the left and right trees during a splay
+    NodePool pool;
+    int theSize;
+
+    SplayMode mode;
+    double parameter;           // See setSplayMode
+    vector<NodePtr *> path;     // Links followed by semiSplay
 
     /**
      * Internal method to reclaim internal nodes in subtree t.
      * WARNING: This is prone to running out of stack space.
      */
-    void reclaimMemory( BinaryNode * t )
+    void reclaimMemory( NodePtr t )
     {
         if( t != t->left )
         {
             reclaimMemory( t->left );
             reclaimMemory( t->right );
-            delete t;
+            pool.destroy( t );
         }
     }
     
@@ -248,7 +534,7 @@ private:
      * Internal method to print a subtree t in sorted order.
      * WARNING: This is prone to running out of stack space.
      */
-   void printTree( BinaryNode *t ) const
+   void printTree( NodePtr t ) const
     {
         if( t != t->left )
         {
@@ -259,31 +545,201 @@ private:
     }
 
     /**
-     * Internal method to clone subtree.
-     * WARNING: This is prone to running out of stack space.
+     * Internal method to clone subtree, without recursion.
+     * Each pending entry is a nonempty subtree of t, the node of the
+     * copy that its copy hangs from, and the link there it goes into.
      */
-    BinaryNode * clone( BinaryNode * t ) const
+    NodePtr clone( NodePtr t )
     {
-        if( t == t->left )  // Cannot test against nullNode!!!
-            return nullNode;
-        else
-            return new BinaryNode{ t->element, clone( t->left ), clone( t->right ) };
+        struct Pending
+        {
+            NodePtr from;
+            NodePtr parent;     // nullptr for the root of the copy
+            NodePtr *link;
+        };
+
+        NodePtr copy = nullNode;
+        vector<Pending> pending;
+        if( t != t->left )  // Cannot test against nullNode!!!
+            pending.push_back( { t, nullptr, &copy } );
+
+        while( !pending.empty( ) )
+        {
+            Pending p = pending.back( );
+            pending.pop_back( );
+
+            NodePtr to = *p.link = pool.create( p.from->element, nullNode, nullNode );
+            to->parent = p.parent;
+            if( p.from->left != p.from->left->left )
+                pending.push_back( { p.from->left, to, &to->left } );
+            if( p.from->right != p.from->right->left )
+                pending.push_back( { p.from->right, to, &to->right } );
+        }
+        return copy;
+    }
+
+    /**
+     * Internal method to find the smallest item in a nonempty subtree t,
+     * without splaying.
+     */
+    NodePtr findMin( NodePtr t ) const
+    {
+        while( t->left != nullNode )
+            t = t->left;
+        return t;
+    }
+
+    /**
+     * Internal method to find the largest item in a nonempty subtree t,
+     * without splaying.
+     */
+    NodePtr findMax( NodePtr t ) const
+    {
+        while( t->right != nullNode )
+            t = t->right;
+        return t;
+    }
+
+    /**
+     * Point the parent links of t's children at t.
+     * nullNode's link is never set. A node's own parent link is set
+     * when its parent is fixed, or by setRootParent for the root.
+     */
+    void setParents( NodePtr t )
+    {
+        if( t->left != nullNode )
+            t->left->parent = t;
+        if( t->right != nullNode )
+            t->right->parent = t;
+    }
+
+    void setRootParent( )
+    {
+        if( root != nullNode )
+            root->parent = nullptr;
+    }
+
+    /**
+     * Internal method to search for x without changing the tree.
+     * Set depth to the number of edges from the root to the last
+     * node visited. Return true if x is found.
+     */
+    bool find( const Comparable & x, int & depth ) const
+    {
+        NodePtr t = root;
+        for( depth = 0; ; ++depth )
+            if( x < t->element )
+            {
+                if( t->left == nullNode )
+                    return false;
+                t = t->left;
+            }
+            else if( t->element < x )
+            {
+                if( t->right == nullNode )
+                    return false;
+                t = t->right;
+            }
+            else
+                return true;
+    }
+
+    /**
+     * Return the random numbers used by RANDOM_SPLAY. Each thread
+     * has its own generator, so the tree holds no generator state.
+     */
+    static UniformRandom & randomNums( )
+    {
+        static thread_local UniformRandom generator{ 1 };
+        return generator;
+    }
+
+    /**
+     * Return the DEPTH_SPLAY limit, parameter * log2( N ),
+     * rounding log2( N ) up.
+     */
+    int depthLimit( ) const
+    {
+        int log = 0;
+        while( ( 1 << log ) < theSize )
+            ++log;
+        return parameter * log;
+    }
+
+    /**
+     * Internal method to perform a bottom-up semi-splay.
+     * Search for x as in find, keeping the links followed. Then, from
+     * the last node visited, take the ancestors two at a time:
+     * for a zig-zig, rotate the parent above the grandparent and carry
+     * on from the parent; for a zig-zag, do the double rotation and
+     * carry on from the node itself. Either way the walk goes up two
+     * levels per step. Return true if x is found.
+     */
+    bool semiSplay( const Comparable & x )
+    {
+        bool found = false;
+        NodePtr *link = &root;
+
+        path.clear( );
+        for( ; ; )
+        {
+            path.push_back( link );
+            NodePtr t = *link;
+            if( x < t->element && t->left != nullNode )
+                link = &t->left;
+            else if( t->element < x && t->right != nullNode )
+                link = &t->right;
+            else
+            {
+                found = !( x < t->element || t->element < x );
+                break;
+            }
+        }
+
+            // A rotation rewrites only the link at the grandparent,
+            // so the links above it are still valid
+        for( int i = path.size( ) - 1; i >= 2; i -= 2 )
+        {
+            NodePtr & grand = *path[ i - 2 ];
+            NodePtr parent = *path[ i - 1 ];
+            bool zigZig = ( parent->left == *path[ i ] ) == ( grand->left == parent );
+            if( grand->left == parent )
+            {
+                if( !zigZig )
+                    rotateWithRightChild( grand->left );
+                rotateWithLeftChild( grand );
+            }
+            else
+            {
+                if( !zigZig )
+                    rotateWithLeftChild( grand->right );
+                rotateWithRightChild( grand );
+            }
+        }
+        return found;
     }
 
-        // Tree manipulations
-    void rotateWithLeftChild( BinaryNode * & k2 )
+        // Tree manipulations; the new subtree root of a rotation
+        // takes over the parent of the old one
+    void rotateWithLeftChild( NodePtr & k2 )
     {
-        BinaryNode *k1 = k2->left;
+        NodePtr k1 = k2->left;
         k2->left = k1->right;
         k1->right = k2;
+        k1->parent = k2->parent;
+        setParents( k2 );
+        setParents( k1 );
         k2 = k1;
     }
 
-    void rotateWithRightChild( BinaryNode * & k1 )
+    void rotateWithRightChild( NodePtr & k1 )
     {
-        BinaryNode *k2 = k1->right;
+        NodePtr k2 = k1->right;
         k1->right = k2->left;
         k2->left = k1;
+        k2->parent = k1->parent;
+        setParents( k1 );
+        setParents( k2 );
         k1 = k2;
     }
 
@@ -296,13 +752,12 @@ private:
      * x is the target item to splay around.
      * t is the root of the subtree to splay.
      */
-    void splay( const Comparable & x, BinaryNode * & t )
+    void splay( const Comparable & x, NodePtr & t )
     {
-        BinaryNode *leftTreeMax, *rightTreeMin;
-        static BinaryNode header;
+        NodePtr leftTreeMax, rightTreeMin;
 
-        header.left = header.right = nullNode;
-        leftTreeMax = rightTreeMin = &header;
+        header->left = header->right = nullNode;
+        leftTreeMax = rightTreeMin = header;
 
         nullNode->element = x;   // Guarantee a match
 
@@ -315,6 +770,7 @@ private:
                     break;
                 // Link Right
                 rightTreeMin->left = t;
+                t->parent = rightTreeMin;
                 rightTreeMin = t;
                 t = t->left;
             }
@@ -326,6 +782,7 @@ private:
                     break;
                 // Link Left
                 leftTreeMax->right = t;
+                t->parent = leftTreeMax;
                 leftTreeMax = t;
                 t = t->right;
             }
@@ -334,8 +791,12 @@ private:
 
         leftTreeMax->right = t->left;
         rightTreeMin->left = t->right;
-        t->left = header.right;
-        t->right = header.left;
+        setParents( leftTreeMax );
+        setParents( rightTreeMin );
+        t->left = header->right;
+        t->right = header->left;
+        setParents( t );
+        t->parent = nullptr;
     }
 };
 
@@ -0,0 +1,60 @@
+#include "ArrayBinomialQueue.h"
+#include <iostream>
+using namespace std;
+
+int main( )
+{
+    int numItems = 100000;
+    ArrayBinomialQueue<int> h;
+    ArrayBinomialQueue<int> h1;
+    ArrayBinomialQueue<int> h2;
+    int i = 37;
+
+    cout << "Begin test..." << endl;
+    for( i = 37; i != 0; i = ( i + 37 ) % numItems )
+        if( i % 2 == 0 )
+            h1.insert( i );
+        else
+            h.insert( i );
+
+    h.merge( h1 );            // Different arenas: rhs nodes are copied
+    h2 = h;
+
+    for( i = 1; i < numItems; ++i )
+    {
+        int x;
+        h2.deleteMin( x );
+        if( x != i )
+            cout << "Oops! " << i << endl;
+    }
+
+    if( !h1.isEmpty( ) )
+        cout << "Oops! h1 should have been empty!" << endl;
+
+        // Queues sharing one arena merge without copying
+    auto arena = make_shared<ArrayBinomialQueue<int>::Arena>( );
+    ArrayBinomialQueue<int> h3{ arena };
+    ArrayBinomialQueue<int> h4{ arena };
+    for( i = 37; i != 0; i = ( i + 37 ) % numItems )
+    {
+        if( i % 3 == 0 )
+            h3.insert( i );
+        else
+            h4.insert( i );
+        if( i % 1000 == 0 )
+            h3.merge( h4 );
+    }
+    h3.merge( h4 );
+    for( i = 1; i < numItems; ++i )
+    {
+        if( h3.findMin( ) != i )
+            cout << "Oops! " << i << endl;
+        h3.deleteMin( );
+    }
+    if( !h3.isEmpty( ) || !h4.isEmpty( ) )
+        cout << "Oops! h3 and h4 should be empty!" << endl;
+
+    cout << "End of test... no output is good" << endl;
+
+    return 0;
+}
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <iterator>
+#include <vector>
 #include "AvlTree.h"
 using namespace std;
 
@@ -46,6 +48,111 @@ int main( )
             cout << "Find error2!" << endl;
     }
 
+        // In-order iteration over the even items, forward and backward
+    i = 2;
+    for( auto itr = t2.begin( ); itr != t2.end( ); ++itr, i += 2 )
+        if( *itr != i )
+            cout << "Iterator error!" << endl;
+    if( i != NUMS )
+        cout << "Iterator length error!" << endl;
+    for( auto itr = t2.end( ); itr != t2.begin( ); )
+        if( *--itr != ( i -= 2 ) )
+            cout << "Reverse iterator error!" << endl;
+    auto range = t2.range( 7, 15 );
+    auto equal = t2.equal_range( 8 );
+    auto missing = t2.equal_range( 9 );
+    if( *range.first != 8 || *range.second != 16 || distance( range.first, range.second ) != 4
+        || *equal.first != 8 || *equal.second != 10 || missing.first != missing.second
+        || *missing.first != 10
+        || *t2.lower_bound( 8 ) != 8 || *t2.upper_bound( 8 ) != 10
+        || t2.lower_bound( NUMS ) != t2.end( ) )
+        cout << "Bound error!" << endl;
+    try
+    {
+        --t2.begin( );
+        cout << "Iterator before begin not detected!" << endl;
+    }
+    catch( const IteratorOutOfBoundsException & ) { }
+
+        // Order statistics over the even items 2, 4, ..., NUMS - 2
+    if( t2.size( ) != NUMS / 2 - 1 )
+        cout << "Size error!" << endl;
+    for( i = 2; i < NUMS; i += 2 )
+        if( t2.select( i / 2 ) != i || t2.rank( i ) != i / 2 - 1 || t2.rank( i + 1 ) != i / 2 )
+            cout << "Rank or select error!" << endl;
+    if( t2.countInRange( 3, 11 ) != 4 || t2.countInRange( 2, 2 ) != 1
+        || t2.countInRange( 11, 3 ) != 0 || t2.countInRange( 0, NUMS ) != t2.size( ) )
+        cout << "CountInRange error!" << endl;
+    try
+    {
+        t2.select( t2.size( ) + 1 );
+        cout << "Select out of range not detected!" << endl;
+    }
+    catch( const ArrayIndexOutOfBoundsException & ) { }
+
+        // Bulk build the odd items on two threads, then union with t
+    vector<int> odds;
+    for( i = 1; i < NUMS; i += 2 )
+        odds.push_back( i );
+    AvlTree<int> t3{ odds.begin( ), odds.end( ), 2 };
+    for( i = 1; i < NUMS; i += 2 )
+        if( !t3.contains( i ) || t3.contains( i + 1 ) )
+            cout << "Bulk build error!" << endl;
+
+    t3.unionWith( t );
+    if( !t.isEmpty( ) )
+        cout << "Union should empty rhs!" << endl;
+    if( t3.findMin( ) != 1 || t3.findMax( ) != NUMS - 1 )
+        cout << "Union FindMin or FindMax error!" << endl;
+    for( i = 1; i < NUMS; ++i )
+        if( !t3.contains( i ) )
+            cout << "Union error!" << endl;
+
+        // Repeat with index-linked arena storage
+    AvlTree<int, ArenaNodes> a;
+    for( i = GAP; i != 0; i = ( i + GAP ) % NUMS )
+        a.insert( i );
+    for( i = 1; i < NUMS; i += 2 )
+        a.remove( i );
+    AvlTree<int, ArenaNodes> a2 = a;
+    i = 2;
+    for( int x : a2 )
+        if( x != i || !a.contains( i ) || a.contains( i + 1 ) || a.rank( i ) != i / 2 - 1 )
+            cout << "Arena error!" << endl;
+        else
+            i += 2;
+    if( i != NUMS )
+        cout << "Arena iterator length error!" << endl;
+
+    AvlTree<int, ArenaNodes> a3{ odds.begin( ), odds.end( ), 2 };
+    a3.unionWith( a );
+    a.insert( 0 );
+    a2.makeEmpty( );
+    if( !a2.isEmpty( ) || a.size( ) != 1 || a3.size( ) != NUMS - 1 )
+        cout << "Arena union or makeEmpty error!" << endl;
+    for( i = 1; i < NUMS; ++i )
+        if( !a3.contains( i ) )
+            cout << "Arena union error!" << endl;
+
+        // Degenerate input: 1M sorted keys in, then copy, remove
+        // in sorted order from both ends, and empty
+    const int BIG = 1000000;
+    AvlTree<int> s;
+    for( i = 0; i < BIG; ++i )
+        s.insert( i );
+    AvlTree<int> s2 = s;
+    for( i = 0; i < BIG / 2; ++i )
+    {
+        s.remove( i );
+        s2.remove( BIG - 1 - i );
+    }
+    if( s.size( ) != BIG / 2 || s.findMin( ) != BIG / 2 || s2.findMax( ) != BIG / 2 - 1
+        || s.contains( BIG / 2 - 1 ) || !s2.contains( 0 ) )
+        cout << "Sorted input error!" << endl;
+    s.makeEmpty( );
+    if( !s.isEmpty( ) )
+        cout << "Sorted input makeEmpty error!" << endl;
+
     cout << "End of test..." << endl;
     return 0;
 }
@@ -0,0 +1,86 @@
+#include <iostream>
+#include "BPlusTree.h"
+using namespace std;
+
+    // Run the AvlTree test sequence, plus iterator checks, on tree type Tree
+template <typename Tree>
+void test( int NUMS )
+{
+    Tree t;
+    const int GAP  =   37;
+    int i;
+
+    for( i = GAP; i != 0; i = ( i + GAP ) % NUMS )
+        t.insert( i );
+    t.insert( GAP );    // Duplicate
+    t.remove( 0 );
+    for( i = 1; i < NUMS; i += 2 )
+        t.remove( i );
+
+    if( NUMS < 40 )
+        t.printTree( );
+    if( t.findMin( ) != 2 || t.findMax( ) != NUMS - 2 )
+        cout << "FindMin or FindMax error!" << endl;
+    if( t.size( ) != ( NUMS - 1 ) / 2 )
+        cout << "Size error!" << endl;
+
+    for( i = 2; i < NUMS; i += 2 )
+        if( !t.contains( i ) )
+            cout << "Find error1!" << endl;
+
+    for( i = 1; i < NUMS; i += 2 )
+    {
+        if( t.contains( i )  )
+            cout << "Find error2!" << endl;
+    }
+
+    Tree t2;
+    t2 = t;
+
+    i = 2;
+    for( auto itr = t2.begin( ); itr != t2.end( ); ++itr, i += 2 )
+        if( *itr != i )
+            cout << "Iterator error!" << endl;
+    if( i != NUMS )
+        cout << "Iterator count error!" << endl;
+
+    i = NUMS - 2;
+    for( auto itr = t2.end( ); itr != t2.begin( ); i -= 2 )
+        if( *--itr != i )
+            cout << "Reverse iterator error!" << endl;
+
+    auto range = t2.range( 101, 201 );
+    i = 102;
+    for( auto itr = range.first; itr != range.second; ++itr, i += 2 )
+        if( *itr != i )
+            cout << "Range error!" << endl;
+    if( i != 202 )
+        cout << "Range count error!" << endl;
+    auto equal = t2.equal_range( 10 );
+    auto missing = t2.equal_range( 11 );
+    if( *equal.first != 10 || *equal.second != 12 || missing.first != missing.second )
+        cout << "equal_range error!" << endl;
+    if( *t2.lower_bound( 10 ) != 10 || *t2.upper_bound( 10 ) != 12 ||
+        t2.lower_bound( NUMS ) != t2.end( ) )
+        cout << "Bound error!" << endl;
+
+    for( i = 2; i < NUMS; i += 2 )
+        t2.remove( i );
+    if( !t2.isEmpty( ) || t2.begin( ) != t2.end( ) )
+        cout << "Remove all error!" << endl;
+    if( !t.contains( 2 ) )
+        cout << "Copy error!" << endl;
+}
+
+    // Test program
+int main( )
+{
+    cout << "Checking... (no more output means success)" << endl;
+
+    test<BPlusTree<int>>( 2000000 );
+    test<BPlusTree<int, 1>>( 200000 );     // Small nodes: a deeper tree
+    test<BPlusTree<long long, 1>>( 10000 );
+
+    cout << "End of test..." << endl;
+    return 0;
+}
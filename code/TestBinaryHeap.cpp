@@ -40,6 +40,23 @@ int main( )
 
     
     
+    BinaryHeap<int> h1, h2;
+    for( i = 37; i != 0; i = ( i + 37 ) % maxItem )
+        if( i % 2 == 0 )
+            h1.insert( i );
+        else
+            h2.insert( i );
+    h1.merge( h2 );              // Equal sizes: rebuild
+    h2.insert( 0 );
+    h1.merge( h2 );              // Small rhs: insert item by item
+    for( i = 0; i < maxItem; ++i )
+    {
+        int y;
+        h1.deleteMin( y );
+        if( y != i )
+            cout << "Oops! " << i << endl;
+    }
+
     cout << "End test... no other output is good" << endl;
     return 0;
 }
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <iterator>
 #include "BinarySearchTree.h"
 using namespace std;
 
@@ -46,6 +47,32 @@ int main( )
             cout << "Find error2!" << endl;
     }
 
+        // In-order iteration over the even items, forward and backward
+    i = 2;
+    for( auto itr = t2.begin( ); itr != t2.end( ); ++itr, i += 2 )
+        if( *itr != i )
+            cout << "Iterator error!" << endl;
+    if( i != NUMS )
+        cout << "Iterator length error!" << endl;
+    for( auto itr = t2.end( ); itr != t2.begin( ); )
+        if( *--itr != ( i -= 2 ) )
+            cout << "Reverse iterator error!" << endl;
+    auto range = t2.range( 7, 15 );
+    auto equal = t2.equal_range( 8 );
+    auto missing = t2.equal_range( 9 );
+    if( *range.first != 8 || *range.second != 16 || distance( range.first, range.second ) != 4
+        || *equal.first != 8 || *equal.second != 10 || missing.first != missing.second
+        || *missing.first != 10
+        || *t2.lower_bound( 8 ) != 8 || *t2.upper_bound( 8 ) != 10
+        || t2.lower_bound( NUMS ) != t2.end( ) )
+        cout << "Bound error!" << endl;
+    try
+    {
+        --t2.begin( );
+        cout << "Iterator before begin not detected!" << endl;
+    }
+    catch( const IteratorOutOfBoundsException & ) { }
+
     cout << "Finished testing" << endl;
 
     return 0;
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <utility>
+#include "BucketQueue.h"
+using namespace std;
+
+    // Test program
+int main( )
+{
+    unsigned int maxSpan = 100;
+    int numItems = 10000;
+    BucketQueue<pair<unsigned int, int>> h{ maxSpan };
+    pair<unsigned int, int> x;
+
+    cout << "Begin test... " << endl;
+
+        // Simulate Dijkstra: each removal of key d inserts d + w, 1 <= w <= maxSpan
+    h.insert( { 0, 0 } );
+    unsigned int prev = 0;
+    for( int i = 0; i < numItems; ++i )
+    {
+        h.deleteMin( x );
+        if( x.first < prev )
+            cout << "Oops! " << i << endl;
+        prev = x.first;
+        h.insert( { x.first + 1 + ( i * 37 ) % maxSpan, i } );
+        h.insert( { x.first + 1 + ( i * 53 ) % maxSpan, i } );
+    }
+
+    try
+    {
+        h.insert( { prev + maxSpan + 1, 0 } );
+        cout << "Oops! out of range insert accepted" << endl;
+    }
+    catch( const IllegalArgumentException & )
+    {
+    }
+
+    h.makeEmpty( );
+    if( !h.isEmpty( ) )
+        cout << "Oops! h should be empty!" << endl;
+    try
+    {
+        h.findMin( );
+        cout << "Oops! findMin on empty queue" << endl;
+    }
+    catch( const UnderflowException & )
+    {
+    }
+
+    cout << "End test... no other output is good" << endl;
+    return 0;
+}
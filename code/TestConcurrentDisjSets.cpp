@@ -0,0 +1,78 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <utility>
+#include "ConcurrentDisjSets.h"
+#include "DisjSets.h"
+#include "UniformRandom.h"
+using namespace std;
+
+    // Test program (compile with -pthread)
+int main( )
+{
+    const int NUMS = 200000;
+    const int EDGES = 150000;
+    const int THREADS = 4;
+    UniformRandom r{ 2718 };
+
+    cout << "Checking... (no more output means success)" << endl;
+
+        // Random edges on four threads against the sequential DisjSets
+    vector<pair<int, int>> edges( EDGES );
+    for( auto & e : edges )
+        e = { r.nextInt( NUMS ), r.nextInt( NUMS ) };
+    ConcurrentDisjSets cds{ NUMS };
+    DisjSets ds{ NUMS };
+    long long merges = cds.parallelUnite( edges.data( ), EDGES, THREADS );
+    long long expected = 0;
+    for( auto & e : edges )
+        expected += ds.unite( e.first, e.second );
+    if( merges != expected )
+        cout << "parallelUnite merge count error!" << endl;
+
+    vector<int> labels;
+    if( cds.components( labels, THREADS ) != ds.numSets( ) )
+        cout << "components count error!" << endl;
+    vector<int> labelOfRoot( NUMS, -1 );
+    for( int x = 0; x < NUMS; ++x )
+    {
+        int & label = labelOfRoot[ ds.find( x ) ];
+        if( label == -1 )
+            label = labels[ x ];
+        else if( label != labels[ x ] )
+            cout << "components label error!" << endl;
+        if( labels[ labels[ x ] ] != labels[ x ] )
+            cout << "label is not a root error!" << endl;
+    }
+    for( int q = 0; q < 1000; ++q )
+    {
+        int x = r.nextInt( NUMS ), y = r.nextInt( NUMS );
+        if( cds.sameSet( x, y ) != ( ds.find( x ) == ds.find( y ) ) )
+            cout << "sameSet error!" << endl;
+    }
+
+        // Threads joining overlapping ranges into a line, while
+        // others ask questions that must not fail
+    const int LINE = 100000;
+    ConcurrentDisjSets line{ LINE };
+    vector<thread> threads;
+    atomic<int> merged{ 0 };
+    for( int t = 0; t < THREADS; ++t )
+        threads.emplace_back( [ &, t ]
+        {
+            for( int i = t + 1; i < LINE; i += THREADS / 2 )
+                merged += line.unite( i - 1, i );
+            for( int i = 0; i < LINE; i += 97 )
+                if( !line.sameSet( i, i ) || line.find( i ) < 0 )
+                    cout << "Concurrent find error!" << endl;
+        } );
+    for( auto & t : threads )
+        t.join( );
+    if( merged != LINE - 1 || !line.sameSet( 0, LINE - 1 ) || line.components( labels, 1 ) != 1 )
+        cout << "Concurrent line error!" << endl;
+    if( line.unite( 5, 50000 ) )
+        cout << "unite of one set error!" << endl;
+
+    cout << "Test completed." << endl;
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include "ConcurrentSkipList.h"
+using namespace std;
+
+    // Test program (compile with -pthread)
+int main( )
+{
+    ConcurrentSkipList<int> t{ 12345 };
+    int NUMS = 40000;
+    const int GAP  =   37;
+    const int THREADS = 4;
+    int i;
+
+    cout << "Checking... (no more output means success)" << endl;
+
+    for( i = GAP; i != 0; i = ( i + GAP ) % NUMS )
+        if( !t.insert( i ) )
+            cout << "Insert error!" << endl;
+    if( t.insert( GAP ) )
+        cout << "Duplicate insert error!" << endl;
+    for( i = 1; i < NUMS; i += 2 )
+        if( !t.remove( i ) )
+            cout << "Remove error!" << endl;
+    if( t.remove( 1 ) || t.remove( 0 ) )
+        cout << "Remove of absent item error!" << endl;
+
+    if( NUMS < 40 )
+        t.printTree( );
+    if( t.findMin( ) != 2 )
+        cout << "FindMin error!" << endl;
+
+    for( i = 2; i < NUMS; i += 2 )
+        if( !t.contains( i ) )
+            cout << "Find error1!" << endl;
+    for( i = 1; i < NUMS; i += 2 )
+        if( t.contains( i ) )
+            cout << "Find error2!" << endl;
+
+    int expected = 2;
+    for( int x : t )
+    {
+        if( x != expected )
+            cout << "Iteration error!" << endl;
+        expected += 2;
+    }
+    if( expected != NUMS )
+        cout << "Iteration length error!" << endl;
+
+    auto itr = t.lower_bound( 101 );
+    if( itr == t.end( ) || *itr != 102 || *++itr != 104 )
+        cout << "lower_bound error!" << endl;
+    if( t.lower_bound( NUMS ) != t.end( ) )
+        cout << "lower_bound at end error!" << endl;
+
+    t.makeEmpty( );
+    if( !t.isEmpty( ) || t.begin( ) != t.end( ) )
+        cout << "makeEmpty error!" << endl;
+    try
+    {
+        t.findMin( );
+        cout << "findMin on empty list did not throw!" << endl;
+    }
+    catch( const UnderflowException & )
+    {
+    }
+
+        // Every thread inserts all of 0 .. NUMS - 1; each item must be
+        // reported as new exactly once. Meanwhile, scans must stay sorted.
+    atomic<int> inserted{ 0 };
+    vector<thread> threads;
+    for( int id = 0; id < THREADS; ++id )
+        threads.emplace_back( [ &, id ] {
+            for( int j = 0; j < NUMS; ++j )
+                inserted += t.insert( ( j * GAP + id * 1000 ) % NUMS );
+        } );
+    for( int scan = 0; scan < 20; ++scan )
+    {
+        int last = -1;
+        for( int x : t )
+        {
+            if( x <= last )
+                cout << "Concurrent scan order error!" << endl;
+            last = x;
+        }
+    }
+    for( auto & th : threads )
+        th.join( );
+
+        // Then the threads remove the odd items, while a scan
+        // checks that the even ones stay
+    threads.clear( );
+    for( int id = 0; id < THREADS; ++id )
+        threads.emplace_back( [ &, id ] {
+            for( int j = 2 * id + 1; j < NUMS; j += 2 * THREADS )
+                if( !t.remove( j ) )
+                    cout << "Concurrent remove error!" << endl;
+        } );
+    for( int scan = 0; scan < 20; ++scan )
+    {
+        int even = 0;
+        for( int x : t )
+            even += x % 2 == 0;
+        if( even != NUMS / 2 )
+            cout << "Concurrent scan lost an item!" << endl;
+    }
+    for( auto & th : threads )
+        th.join( );
+
+    if( inserted != NUMS )
+        cout << "Concurrent insert count error!" << endl;
+    for( i = 0; i < NUMS; ++i )
+        if( t.contains( i ) != ( i % 2 == 0 ) )
+            cout << "Concurrent find error!" << endl;
+
+        // Churn: threads insert and remove the same odd items over and
+        // over, so removed nodes are reclaimed while readers are on the list
+    threads.clear( );
+    for( int id = 0; id < THREADS; ++id )
+        threads.emplace_back( [ &, id ] {
+            for( int round = 0; round < 20; ++round )
+                for( int j = 2 * id + 1; j < 2000; j += 2 * THREADS )
+                    if( !t.insert( j ) || !t.remove( j ) )
+                        cout << "Churn error!" << endl;
+        } );
+    for( int scan = 0; scan < 20; ++scan )
+    {
+        for( i = 0; i < 2000; i += 2 )
+            if( !t.contains( i ) )
+                cout << "Churn lost an item!" << endl;
+        int last = -1;
+        for( auto itr = t.lower_bound( 1000 ); *itr < 3000; ++itr )
+        {
+            if( *itr <= last )
+                cout << "Churn scan order error!" << endl;
+            last = *itr;
+        }
+    }
+    for( auto & th : threads )
+        th.join( );
+    for( i = 1; i < 2000; i += 2 )
+        if( t.contains( i ) )
+            cout << "Churn left an item!" << endl;
+
+    cout << "Test complete..." << endl;
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include "DynamicKdTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+using Point = array<int, 2>;
+
+/**
+ * Return the number of points of pts inside the box, by brute force.
+ */
+int bruteCount( const vector<Point> & pts, const Point & low, const Point & high )
+{
+    int count = 0;
+    for( const Point & p : pts )
+        count += low[ 0 ] <= p[ 0 ] && p[ 0 ] <= high[ 0 ]
+                 && low[ 1 ] <= p[ 1 ] && p[ 1 ] <= high[ 1 ];
+    return count;
+}
+
+/**
+ * Check t against the points in pts with a few random queries.
+ */
+void check( const DynamicKdTree<int, 2, 4> & t, const vector<Point> & pts, UniformRandom & r )
+{
+    const int K = 6;
+    DynamicKdTree<int, 2, 4>::Neighbor out[ K ];
+    vector<DynamicKdTree<int, 2, 4>::Neighbor> inRadius;
+    vector<double> dist( pts.size( ) );
+
+    if( t.size( ) != (int) pts.size( ) )
+        cout << "Size error!" << endl;
+    for( int q = 0; q < 5; ++q )
+    {
+        Point low = { r.nextInt( 500 ), r.nextInt( 500 ) };
+        Point high = { low[ 0 ] + r.nextInt( 200 ), low[ 1 ] + r.nextInt( 200 ) };
+        if( t.countInRange( low, high ) != bruteCount( pts, low, high ) )
+            cout << "Range count error!" << endl;
+
+        for( size_t j = 0; j < pts.size( ); ++j )
+            dist[ j ] = hypot( pts[ j ][ 0 ] - low[ 0 ], pts[ j ][ 1 ] - low[ 1 ] );
+        sort( dist.begin( ), dist.end( ) );
+        int found = t.kNearest( low, K, out );
+        if( found != min<int>( K, pts.size( ) ) )
+            cout << "kNearest count error!" << endl;
+        for( int j = 0; j < found; ++j )
+            if( fabs( out[ j ].distance - dist[ j ] ) > 1e-9 )
+                cout << "kNearest error!" << endl;
+
+        if( !pts.empty( ) )
+        {
+            double radius = dist[ q * 7 % pts.size( ) ] + 1e-6;
+            t.radiusSearch( low, radius, inRadius );
+            if( inRadius.size( ) != size_t( upper_bound( dist.begin( ), dist.end( ), radius )
+                                            - dist.begin( ) ) )
+                cout << "radiusSearch error!" << endl;
+        }
+    }
+}
+
+    // Test program
+int main( )
+{
+    UniformRandom r{ 5150 };
+    DynamicKdTree<int, 2, 4> t;
+    vector<Point> pts;
+
+    cout << "Checking... (no more output means success)" << endl;
+
+        // Random inserts and removes, with many duplicates; the
+        // population grows, shrinks to nothing and grows again
+    for( int step = 0; step < 30000; ++step )
+    {
+        int phase = step / 5000;
+        bool grow = phase % 2 == 0 ? r.nextInt( 4 ) != 0 : r.nextInt( 4 ) == 0;
+        if( grow || pts.empty( ) )
+        {
+            Point p = { r.nextInt( 700 ), r.nextInt( 700 ) };
+            t.insert( p );
+            pts.push_back( p );
+        }
+        else if( r.nextInt( 10 ) == 0 )
+        {
+            Point p = { r.nextInt( 700 ), r.nextInt( 700 ) };
+            if( t.remove( p ) != ( find( pts.begin( ), pts.end( ), p ) != pts.end( ) ) )
+                cout << "Remove of random point error!" << endl;
+            auto itr = find( pts.begin( ), pts.end( ), p );
+            if( itr != pts.end( ) )
+                pts.erase( itr );
+        }
+        else
+        {
+            int j = r.nextInt( pts.size( ) );
+            if( !t.remove( pts[ j ] ) )
+                cout << "Remove error!" << endl;
+            pts[ j ] = pts.back( );
+            pts.pop_back( );
+        }
+        if( step % 200 == 0 )
+            check( t, pts, r );
+    }
+
+        // Remove everything
+    while( !pts.empty( ) )
+    {
+        if( !t.remove( pts.back( ) ) )
+            cout << "Remove error!" << endl;
+        pts.pop_back( );
+    }
+    check( t, pts, r );
+    if( !t.isEmpty( ) || t.remove( { 1, 1 } ) )
+        cout << "Empty error!" << endl;
+    try
+    {
+        t.nearest( { 0, 0 } );
+        cout << "Nearest on empty tree not detected!" << endl;
+    }
+    catch( const UnderflowException & ) { }
+
+    cout << "Test completed." << endl;
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <climits>
+#include "EytzingerSet.h"
+#include "BinarySearchTree.h"
+#include "AvlTree.h"
+#include "RedBlackTree.h"
+#include "SplayTree.h"
+#include "Treap.h"
+using namespace std;
+
+/**
+ * Check that s holds exactly the even numbers in [ 0, 2n ).
+ */
+template <typename Set>
+bool check( const Set & s, int n )
+{
+    if( s.size( ) != n )
+        return false;
+    if( n > 0 && ( s.findMin( ) != 0 || s.findMax( ) != 2 * n - 2 ) )
+        return false;
+    for( int i = -1; i <= 2 * n; ++i )
+        if( s.contains( i ) != ( i >= 0 && i < 2 * n && i % 2 == 0 ) )
+            return false;
+    return true;
+}
+
+    // Test program
+int main( )
+{
+    const int NUMS = 20000;
+    const int GAP  =   37;
+
+    cout << "Checking... (no more output means success)" << endl;
+
+        // Every size up to 300 exercises each shape of the last level
+    for( int n = 0; n <= 300; ++n )
+    {
+        vector<int> v;
+        for( int i = 0; i < n; ++i )
+            v.push_back( 2 * i );
+        EytzingerSet<int> s{ v.begin( ), v.end( ) };
+        if( !check( s, n ) )
+            cout << "Search error at size " << n << "!" << endl;
+    }
+
+    EytzingerSet<int> e;
+    if( !e.isEmpty( ) || e.contains( 0 ) )
+        cout << "Empty set error!" << endl;
+    try
+    {
+        e.findMin( );
+        cout << "findMin on empty set did not throw!" << endl;
+    }
+    catch( const UnderflowException & )
+    {
+    }
+
+    vector<int> unsorted{ 1, 3, 2 };
+    try
+    {
+        EytzingerSet<int> bad{ unsorted.begin( ), unsorted.end( ) };
+        cout << "Unsorted range did not throw!" << endl;
+    }
+    catch( const IllegalArgumentException & )
+    {
+    }
+
+    vector<int> duplicated{ 1, 2, 2, 3 };
+    try
+    {
+        EytzingerSet<int> bad{ duplicated.begin( ), duplicated.end( ) };
+        cout << "Duplicate items did not throw!" << endl;
+    }
+    catch( const IllegalArgumentException & )
+    {
+    }
+
+    vector<string> words{ "apple", "banana", "cherry", "date", "elderberry" };
+    EytzingerSet<string> ws{ words.begin( ), words.end( ) };
+    for( auto & w : words )
+        if( !ws.contains( w ) )
+            cout << "String find error!" << endl;
+    if( ws.contains( "avocado" ) || ws.contains( "" ) || ws.contains( "zucchini" ) )
+        cout << "String find error2!" << endl;
+
+    EytzingerSet<string> wcopy = ws;
+    EytzingerSet<string> wmoved = std::move( ws );
+    if( !wcopy.contains( "cherry" ) || !wmoved.contains( "date" ) || !ws.isEmpty( ) )
+        cout << "Copy or move error!" << endl;
+    ws = wcopy;
+    if( ws.size( ) != 5 || ws.findMin( ) != "apple" || ws.findMax( ) != "elderberry" )
+        cout << "Assignment error!" << endl;
+
+        // freeze( ) from each tree
+    BinarySearchTree<int> bst;
+    AvlTree<int> avl;
+    AvlTree<int, ArenaNodes> arenaAvl;
+    RedBlackTree<int> rb{ INT_MIN };
+    SplayTree<int> splay;
+    Treap<int> treap;
+    for( int i = GAP; i != 0; i = ( i + GAP ) % NUMS )
+        if( i % 2 == 0 )
+        {
+            bst.insert( i );
+            avl.insert( i );
+            arenaAvl.insert( i );
+            rb.insert( i );
+            splay.insert( i );
+            treap.insert( i );
+        }
+    bst.insert( 0 );
+    avl.insert( 0 );
+    arenaAvl.insert( 0 );
+    rb.insert( 0 );
+    splay.insert( 0 );
+    treap.insert( 0 );
+
+    if( !check( bst.freeze( ), NUMS / 2 ) )
+        cout << "BinarySearchTree freeze error!" << endl;
+    if( !check( avl.freeze( ), NUMS / 2 ) )
+        cout << "AvlTree freeze error!" << endl;
+    if( !check( arenaAvl.freeze( ), NUMS / 2 ) )
+        cout << "AvlTree<int, ArenaNodes> freeze error!" << endl;
+    if( !check( rb.freeze( ), NUMS / 2 ) )
+        cout << "RedBlackTree freeze error!" << endl;
+    if( !check( splay.freeze( ), NUMS / 2 ) )
+        cout << "SplayTree freeze error!" << endl;
+    if( !check( treap.freeze( ), NUMS / 2 ) )
+        cout << "Treap freeze error!" << endl;
+
+        // The snapshot does not follow later changes
+    EytzingerSet<int> snapshot = avl.freeze( );
+    avl.insert( 1 );
+    avl.makeEmpty( );
+    if( !check( snapshot, NUMS / 2 ) )
+        cout << "Snapshot changed with the tree!" << endl;
+
+    return 0;
+}
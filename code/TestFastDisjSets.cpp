@@ -1,7 +1,28 @@
 #include <iostream>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
 #include "DisjSets.h"
 using namespace std;
 
+/**
+ * Write a DisjSets file by hand, with the given entries and number
+ * of sets, and a byte too many if extraByte. The header claims
+ * savedSize entries, or entries.size( ) if savedSize is negative.
+ */
+void writeSaved( const char *filename, const vector<int> & entries,
+                 int64_t numSets, bool extraByte, int64_t savedSize = -1 )
+{
+    FILE *file = fopen( filename, "wb" );
+    int64_t header[ 2 ] = { savedSize < 0 ? (int64_t) entries.size( ) : savedSize, numSets };
+    fwrite( "DisjSet1", 1, 8, file );
+    fwrite( header, sizeof( header ), 1, file );
+    fwrite( entries.data( ), sizeof( int ), entries.size( ), file );
+    if( extraByte )
+        fputc( 0, file );
+    fclose( file );
+}
+
 // Test main; all finds on same output line should be identical
 int main( )
 {
@@ -29,5 +50,91 @@ int main( )
     }
     cout << endl;
 
+    if( ds.numSets( ) != numElements / numInSameSet )
+        cout << "numSets error!" << endl;
+    for( int i = 0; i < numElements; ++i )
+        if( ds.setSize( i ) != numInSameSet )
+            cout << "setSize error!" << endl;
+
+        // unite finds the roots itself; chain everything together
+    if( ds.unite( 0, numInSameSet - 1 ) )
+        cout << "unite of one set error!" << endl;
+    for( int i = numInSameSet; i < numElements; i += numInSameSet )
+        if( !ds.unite( i - 1, i ) )
+            cout << "unite error!" << endl;
+    if( ds.numSets( ) != 1 || ds.setSize( 77 ) != numElements )
+        cout << "unite count error!" << endl;
+
+        // A million elements joined in a line
+    const int LINE = 1000000;
+    DisjSets line{ LINE };
+    for( int i = 1; i < LINE; ++i )
+        if( !line.unite( i - 1, i ) )
+            cout << "Line unite error!" << endl;
+    if( line.numSets( ) != 1 || line.setSize( LINE / 2 ) != LINE
+        || line.find( 0 ) != line.find( LINE - 1 ) )
+        cout << "Line error!" << endl;
+
+        // Growing from nothing: element i joins element i / 3
+    DisjSets grown;
+    for( int i = 0; i < 1000; ++i )
+    {
+        if( grown.makeSet( ) != i || grown.size( ) != i + 1 )
+            cout << "makeSet error!" << endl;
+        if( i % 3 != 0 && !grown.unite( i, i / 3 ) )
+            cout << "Grown unite error!" << endl;
+    }
+
+        // Dense labels: sets numbered by their smallest element
+    vector<int> labels;
+    int numLabels = grown.compact( labels );
+    if( numLabels != grown.numSets( ) || labels[ 0 ] != 0 )
+        cout << "compact count error!" << endl;
+    for( int i = 0, next = 0; i < grown.size( ); ++i )
+    {
+        if( labels[ i ] != labels[ grown.find( i ) ] || labels[ i ] > next )
+            cout << "compact label error!" << endl;
+        if( labels[ i ] == next )
+            ++next;
+    }
+
+        // Save and load give the same sets
+    const char *FILE_NAME = "TestFastDisjSets.bin";
+    DisjSets restored{ 5 };
+    if( !grown.save( FILE_NAME ) || !restored.load( FILE_NAME ) )
+        cout << "save/load failed!" << endl;
+    if( restored.size( ) != grown.size( ) || restored.numSets( ) != grown.numSets( ) )
+        cout << "Restored size error!" << endl;
+    for( int i = 0; i < grown.size( ); ++i )
+        if( restored.find( i ) != grown.find( i ) )
+            cout << "Restored find error!" << endl;
+    remove( FILE_NAME );
+    if( restored.load( FILE_NAME ) || restored.size( ) != grown.size( ) )
+        cout << "Load of missing file error!" << endl;
+
+        // Corrupt files are rejected, leaving the sets unchanged
+    struct { vector<int> entries; int64_t numSets; bool extraByte; int64_t savedSize = -1; } corrupt[ ] = {
+        { { 1, 2, 0 }, -7, false },     // A cycle, and a negative count
+        { { 1, 2, 0 }, 0, false },      // A cycle
+        { { 0 }, 0, false },            // Points to itself
+        { { -2, 0, 5 }, 1, false },     // Parent out of range
+        { { -4, 0, -1 }, 2, false },    // Root size too large
+        { { -2, 0, 0 }, 1, false },     // Root size wrong
+        { { -2, 0, -1 }, 1, false },    // Wrong number of sets
+        { { -2, 0, -1 }, 2, true },     // Trailing byte
+        { { -2, 0, -1 }, 2, false, 4 }, // Truncated
+        { { -1 }, 1, false, INT32_MAX } // Huge size, rejected before allocating
+    };
+    for( auto & c : corrupt )
+    {
+        writeSaved( FILE_NAME, c.entries, c.numSets, c.extraByte, c.savedSize );
+        if( restored.load( FILE_NAME ) || restored.size( ) != grown.size( ) )
+            cout << "Corrupt file not rejected!" << endl;
+    }
+    writeSaved( FILE_NAME, { -2, 0, -1 }, 2, false );
+    if( !restored.load( FILE_NAME ) || restored.size( ) != 3 || restored.numSets( ) != 2 )
+        cout << "Valid file rejected!" << endl;
+    remove( FILE_NAME );
+
     return 0;
 }
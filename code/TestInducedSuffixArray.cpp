@@ -0,0 +1,117 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include "InducedSuffixArray.h"
+#include "UniformRandom.h"
+using namespace std;
+
+/**
+ * Return the suffix array of str by sorting its suffixes directly.
+ */
+vector<int> naiveSuffixArray( const string & str )
+{
+    vector<int> sa( str.length( ) );
+    for( size_t i = 0; i < sa.size( ); ++i )
+        sa[ i ] = i;
+    sort( sa.begin( ), sa.end( ), [ & ]( int a, int b )
+          { return str.compare( a, string::npos, str, b, string::npos ) < 0; } );
+    return sa;
+}
+
+/**
+ * Check both index types, and the LCP array, on str.
+ */
+void check( const string & str, const string & name )
+{
+    vector<int> expected = naiveSuffixArray( str );
+    vector<uint32_t> sa32;
+    vector<uint64_t> sa64;
+    inducedSuffixArray( str, sa32 );
+    inducedSuffixArray( str, sa64 );
+    if( !equal( expected.begin( ), expected.end( ), sa32.begin( ), sa32.end( ) )
+        || !equal( expected.begin( ), expected.end( ), sa64.begin( ), sa64.end( ) ) )
+    {
+        cout << name << " suffix array error!" << endl;
+        return;
+    }
+
+    const unsigned char *text = reinterpret_cast<const unsigned char *>( str.data( ) );
+    vector<uint32_t> lcp( str.length( ) );
+    lcpArray( text, uint32_t( str.length( ) ), sa32.data( ), lcp.data( ) );
+    for( size_t i = 1; i < lcp.size( ); ++i )
+    {
+        size_t a = sa32[ i - 1 ], b = sa32[ i ], h = 0;
+        while( a + h < str.length( ) && b + h < str.length( ) && str[ a + h ] == str[ b + h ] )
+            ++h;
+        if( lcp[ i ] != h )
+        {
+            cout << name << " LCP error!" << endl;
+            return;
+        }
+    }
+}
+
+    // Test program
+int main( )
+{
+    UniformRandom r{ 31 };
+
+    cout << "Checking... (no more output means success)" << endl;
+
+    check( "", "Empty" );
+    check( "a", "One character" );
+    check( "banana", "Banana" );
+    check( "mississippi", "Mississippi" );
+    check( string( 1000, 'a' ), "Unary" );
+    check( string( "ab\0ab\0\xff\x80\0", 9 ), "Zero and high bytes" );
+
+        // Fibonacci strings, whose LMS substrings repeat at every level
+    string f1 = "b", f2 = "a";
+    while( f2.length( ) < 5000 )
+    {
+        string next = f2 + f1;
+        f1 = f2;
+        f2 = next;
+    }
+    check( f2, "Fibonacci" );
+
+        // Random strings over alphabets of 1 to 256 characters,
+        // and periodic ones with a few changes
+    for( int trial = 0; trial < 300; ++trial )
+    {
+        int sigma = trial % 3 == 0 ? 1 + r.nextInt( 256 ) : 1 + r.nextInt( 4 );
+        string str( r.nextInt( 2000 ), ' ' );
+        for( char & c : str )
+            c = char( r.nextInt( sigma ) );
+        check( str, "Random" );
+
+        string period( 1 + r.nextInt( 8 ), ' ' );
+        for( char & c : period )
+            c = char( 'a' + r.nextInt( 3 ) );
+        string periodic;
+        while( periodic.length( ) < 1500 )
+            periodic += period;
+        for( int k = r.nextInt( 3 ); k > 0; --k )
+            periodic[ r.nextInt( periodic.length( ) ) ] = 'z';
+        check( periodic, "Periodic" );
+    }
+
+        // A text too long for the index type
+    try
+    {
+        vector<uint16_t> sa;
+        inducedSuffixArray( string( 65535, 'x' ), sa );
+        cout << "Oversized text not detected!" << endl;
+    }
+    catch( const invalid_argument & ) { }
+
+    vector<uint32_t> sa;
+    inducedSuffixArray( string( "banana" ), sa );
+    cout << "Suffix array of banana:";
+    for( uint32_t i : sa )
+        cout << " " << i;
+    cout << endl << "Test completed." << endl;
+    return 0;
+}
@@ -0,0 +1,231 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include "KdTree.h"
+#include "UniformRandom.h"
+using namespace std;
+
+/**
+ * Return the number of points inside the box, by brute force.
+ */
+template <typename Point>
+int bruteCount( const vector<Point> & pts, const Point & low, const Point & high )
+{
+    int count = 0;
+    for( const Point & p : pts )
+    {
+        bool inside = true;
+        for( size_t d = 0; d < p.size( ); ++d )
+            inside = inside && low[ d ] <= p[ d ] && p[ d ] <= high[ d ];
+        count += inside;
+    }
+    return count;
+}
+
+/**
+ * Check kNearest, nearest and radiusSearch on tree t against brute force
+ * over pts under Metric, for random queries.
+ */
+template <typename Metric, typename Tree, typename Point>
+void checkNearest( const Tree & t, const vector<Point> & pts, UniformRandom & r,
+                   const string & name )
+{
+    const int K = 8;
+    typename Tree::Neighbor out[ K ];
+    vector<typename Tree::Neighbor> inRadius;
+    vector<double> dist( pts.size( ) );
+
+    for( int q = 0; q < 200; ++q )
+    {
+        Point p = { r.nextInt( -10, 110 ), r.nextInt( -10, 1010 ), r.nextInt( -1, 11 ) };
+        for( size_t j = 0; j < pts.size( ); ++j )
+        {
+            double d = 0;
+            for( int k = 0; k < 3; ++k )
+            {
+                double term = Metric::term( double( pts[ j ][ k ] ) - p[ k ] );
+                d = k == 0 ? term : Metric::combine( d, term );
+            }
+            dist[ j ] = Metric::toDistance( d );
+        }
+        vector<double> sorted = dist;
+        sort( sorted.begin( ), sorted.end( ) );
+
+        int found = t.template kNearest<Metric>( p, K, out );
+        if( found != K )
+            cout << name << " kNearest count error!" << endl;
+        for( int j = 0; j < found; ++j )
+            if( fabs( out[ j ].distance - sorted[ j ] ) > 1e-9 )
+                cout << name << " kNearest error!" << endl;
+        if( fabs( t.template nearest<Metric>( p ).distance - sorted[ 0 ] ) > 1e-9 )
+            cout << name << " nearest error!" << endl;
+
+        double radius = sorted[ q % 50 ] + 1e-6;    // Off the boundary, clear of rounding
+        t.template radiusSearch<Metric>( p, radius, inRadius );
+        if( inRadius.size( ) != size_t( upper_bound( sorted.begin( ), sorted.end( ), radius )
+                                        - sorted.begin( ) ) )
+            cout << name << " radiusSearch error!" << endl;
+    }
+}
+
+    // Test program
+int main( )
+{
+    UniformRandom r{ 17 };
+    const int NUMS = 20000;
+
+    cout << "Checking... (no more output means success)" << endl;
+
+        // The diagonal from KdTree.cpp, which the insert-built tree
+        // turns into a linked list
+    vector<array<int, 2>> diagonal;
+    for( int i = 300; i < 370; ++i )
+        diagonal.push_back( { i, 2500 - i } );
+    KdTree<int, 2, 4> t{ diagonal.begin( ), diagonal.end( ) };
+    if( t.countInRange( { 70, 2186 }, { 1200, 2200 } ) != 15 )
+        cout << "Diagonal range error!" << endl;
+
+        // Random 3-d points with many duplicate coordinates
+    vector<array<int, 3>> pts( NUMS );
+    for( auto & p : pts )
+        p = { r.nextInt( 100 ), r.nextInt( 1000 ), r.nextInt( 10 ) };
+    KdTree<int, 3> t3{ pts };
+    if( t3.size( ) != NUMS )
+        cout << "Size error!" << endl;
+    for( int q = 0; q < 500; ++q )
+    {
+        array<int, 3> low, high;
+        for( int d = 0; d < 3; ++d )
+        {
+            int a = r.nextInt( -5, 1005 ), b = r.nextInt( -5, 1005 );
+            low[ d ] = min( a, b ) / ( d == 0 ? 10 : d == 2 ? 100 : 1 );
+            high[ d ] = max( a, b ) / ( d == 0 ? 10 : d == 2 ? 100 : 1 );
+        }
+        if( t3.countInRange( low, high ) != bruteCount( pts, low, high ) )
+            cout << "Range count error!" << endl;
+    }
+
+        // Nearest neighbors and radius searches, in all three metrics
+    checkNearest<L2Metric>( t3, pts, r, "L2" );
+    checkNearest<L1Metric>( t3, pts, r, "L1" );
+    checkNearest<LInfMetric>( t3, pts, r, "LInf" );
+
+        // Float points in four dimensions, with large leaves whose
+        // sizes are not multiples of the eight-point scanning blocks
+    vector<array<float, 4>> fpts( 3001 );
+    for( auto & p : fpts )
+        p = { float( r.nextDouble( ) ), float( r.nextDouble( ) ),
+              float( r.nextInt( 8 ) ), float( r.nextDouble( ) ) };
+    KdTree<float, 4, 61> t4{ fpts };
+    for( int q = 0; q < 200; ++q )
+    {
+        array<float, 4> low, high;
+        for( int d = 0; d < 4; ++d )
+        {
+            low[ d ] = d == 2 ? r.nextInt( 8 ) : float( r.nextDouble( ) * 0.6 );
+            high[ d ] = low[ d ] + ( d == 2 ? r.nextInt( 3 ) : 0.4f );
+        }
+        if( t4.countInRange( low, high ) != bruteCount( fpts, low, high ) )
+            cout << "Float range count error!" << endl;
+
+        KdTree<float, 4, 61>::Neighbor best = t4.nearest( low );
+        double bestDist = 1e9;
+        for( auto & p : fpts )
+        {
+            double d2 = 0;
+            for( int d = 0; d < 4; ++d )
+                d2 += ( double( p[ d ] ) - low[ d ] ) * ( double( p[ d ] ) - low[ d ] );
+            bestDist = min( bestDist, sqrt( d2 ) );
+        }
+        if( fabs( best.distance - bestDist ) > 1e-9 )
+            cout << "Float nearest error!" << endl;
+    }
+
+        // Batches on three threads give the same answers as single queries
+    const int BATCH = 3000;
+    vector<array<int, 3>> lows( BATCH ), highs( BATCH );
+    for( int q = 0; q < BATCH; ++q )
+        for( int d = 0; d < 3; ++d )
+        {
+            int scale = d == 0 ? 10 : d == 1 ? 100 : 1;
+            lows[ q ][ d ] = r.nextInt( 0, 9 * scale );
+            highs[ q ][ d ] = lows[ q ][ d ] + r.nextInt( 0, scale );
+        }
+    vector<int> counts( BATCH ), visited( BATCH );
+    t3.batchCountInRange( lows.data( ), highs.data( ), BATCH, counts.data( ), 3 );
+    t3.batchRangeSearch( lows.data( ), highs.data( ), BATCH,
+                         [ & ]( int q, const array<int, 3> & ) { ++visited[ q ]; }, 3 );
+    const int NEIGHBORS = 5;
+    vector<KdTree<int, 3>::Neighbor> batchOut( BATCH * NEIGHBORS );
+    vector<int> batchFound( BATCH );
+    t3.batchKNearest( lows.data( ), BATCH, NEIGHBORS, batchOut.data( ), batchFound.data( ), 3 );
+    for( int q = 0; q < BATCH; ++q )
+    {
+        KdTree<int, 3>::Neighbor single[ NEIGHBORS ];
+        t3.kNearest( lows[ q ], NEIGHBORS, single );
+        if( counts[ q ] != t3.countInRange( lows[ q ], highs[ q ] ) || visited[ q ] != counts[ q ] )
+            cout << "Batch range error!" << endl;
+        if( batchFound[ q ] != NEIGHBORS
+            || batchOut[ q * NEIGHBORS + NEIGHBORS - 1 ].distance != single[ NEIGHBORS - 1 ].distance )
+            cout << "Batch kNearest error!" << endl;
+    }
+
+        // A box around everything visits every point once
+    long long sum = 0;
+    int found = 0;
+    t3.rangeSearch( { 0, 0, 0 }, { 99, 999, 9 }, [ & ]( const array<int, 3> & p )
+                    { sum += p[ 1 ]; ++found; } );
+    long long expected = 0;
+    for( auto & p : pts )
+        expected += p[ 1 ];
+    if( found != NUMS || sum != expected )
+        cout << "Full range error!" << endl;
+
+        // Removing marks points deleted; every search skips them
+    vector<array<int, 3>> kept;
+    for( int j = 0; j < NUMS; ++j )
+        if( j % 3 == 0 )
+            kept.push_back( pts[ j ] );
+        else if( !t3.remove( pts[ j ] ) )
+            cout << "Remove error!" << endl;
+    if( t3.remove( { -1, -1, -1 } ) || t3.size( ) != (int) kept.size( ) )
+        cout << "Remove size error!" << endl;
+    vector<array<int, 3>> left;
+    t3.getPoints( left );
+    sort( left.begin( ), left.end( ) );
+    sort( kept.begin( ), kept.end( ) );
+    if( left != kept )
+        cout << "getPoints error!" << endl;
+    if( t3.countInRange( { 10, 100, 2 }, { 60, 700, 8 } )
+        != bruteCount( kept, { 10, 100, 2 }, { 60, 700, 8 } ) )
+        cout << "Range count after remove error!" << endl;
+    checkNearest<L2Metric>( t3, kept, r, "L2 after remove" );
+
+        // Tiny and empty trees, all leaf sizes
+    for( int n = 0; n < 40; ++n )
+    {
+        vector<array<double, 2>> few;
+        for( int i = 0; i < n; ++i )
+            few.push_back( { r.nextDouble( ), r.nextDouble( ) } );
+        KdTree<double, 2, 1> tiny{ few };
+        if( tiny.countInRange( { 0.25, 0.25 }, { 0.75, 0.75 } )
+            != bruteCount( few, { 0.25, 0.25 }, { 0.75, 0.75 } ) )
+            cout << "Tiny tree error!" << endl;
+    }
+    KdTree<int, 2> empty;
+    if( !empty.isEmpty( ) || empty.countInRange( { 0, 0 }, { 9, 9 } ) != 0 )
+        cout << "Empty tree error!" << endl;
+    try
+    {
+        empty.nearest( { 0, 0 } );
+        cout << "Nearest on empty tree not detected!" << endl;
+    }
+    catch( const UnderflowException & ) { }
+
+    cout << "Diagonal points in [70,1200] x [2186,2200]:" << endl;
+    t.printRange( { 70, 2186 }, { 1200, 2200 } );
+    cout << "Test completed." << endl;
+    return 0;
+}
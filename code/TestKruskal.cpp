@@ -0,0 +1,171 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "Kruskal.h"
+#include "UniformRandom.h"
+using namespace std;
+
+/**
+ * Return the weight of a minimum spanning tree of the complete
+ * graph whose weights are in matrix w, by Prim's algorithm.
+ */
+double prim( const vector<vector<double>> & w )
+{
+    int n = w.size( );
+    vector<double> dist( n, HUGE_VAL );
+    vector<bool> inTree( n, false );
+    double total = 0;
+    dist[ 0 ] = 0;
+    for( int i = 0; i < n; ++i )
+    {
+        int best = -1;
+        for( int v = 0; v < n; ++v )
+            if( !inTree[ v ] && ( best == -1 || dist[ v ] < dist[ best ] ) )
+                best = v;
+        inTree[ best ] = true;
+        total += dist[ best ];
+        for( int v = 0; v < n; ++v )
+            if( !inTree[ v ] )
+                dist[ v ] = min( dist[ v ], w[ best ][ v ] );
+    }
+    return total;
+}
+
+/**
+ * Check radixSortByWeight against stable_sort on random weights.
+ */
+template <typename Weight>
+void checkSort( UniformRandom & r, Weight scale, const string & name )
+{
+    vector<WeightedEdge<Weight>> edges( 5000 );
+    for( int i = 0; i < (int) edges.size( ); ++i )
+        edges[ i ] = { i, -i, Weight( ( r.nextDouble( ) - ( is_signed<Weight>::value ? 0.3 : 0 ) ) * scale ) };
+    edges[ 7 ].weight = Weight( 0 );
+    edges[ 8 ].weight = Weight( -0.0 );
+    edges[ 9 ].weight = edges[ 10 ].weight = edges[ 11 ].weight;
+    vector<WeightedEdge<Weight>> expected = edges;
+    stable_sort( expected.begin( ), expected.end( ),
+                 []( const WeightedEdge<Weight> & a, const WeightedEdge<Weight> & b )
+                 { return a.weight < b.weight; } );
+    radixSortByWeight( edges );
+    for( size_t i = 0; i < edges.size( ); ++i )
+        if( edges[ i ].weight != expected[ i ].weight
+            || ( edges[ i ].weight != 0 && edges[ i ].u != expected[ i ].u ) )    // -0.0 sorts first
+            cout << name << " radix sort error!" << endl;
+}
+
+    // Test program
+int main( )
+{
+    UniformRandom r{ 1956 };
+    cout << "Checking... (no more output means success)" << endl;
+
+    checkSort<int>( r, 1000, "int" );
+    checkSort<unsigned>( r, 4e9, "unsigned" );
+    checkSort<long long>( r, 1e15, "long long" );
+    checkSort<float>( r, 1e3f, "float" );
+    checkSort<double>( r, 1e300, "double" );
+
+        // Random dense graphs, with many equal and negative weights,
+        // against Prim's algorithm
+    for( int trial = 0; trial < 20; ++trial )
+    {
+        const int N = 60;
+        vector<vector<double>> w( N, vector<double>( N, HUGE_VAL ) );
+        vector<WeightedEdge<float>> edges;
+        for( int u = 0; u < N; ++u )
+            for( int v = u + 1; v < N; ++v )
+                if( v == u + 1 || r.nextInt( 3 ) == 0 )
+                {
+                    float weight = r.nextInt( -20, 40 ) / 4.0f;
+                    edges.push_back( { u, v, weight } );
+                    w[ u ][ v ] = w[ v ][ u ] = min<double>( w[ u ][ v ], weight );
+                }
+
+        DisjSets ds{ N };
+        vector<WeightedEdge<float>> forest;
+        double total = kruskal( ds, edges, forest );
+        if( (int) forest.size( ) != N - 1 || ds.numSets( ) != 1 || fabs( total - prim( w ) ) > 1e-9 )
+            cout << "Minimum spanning tree error!" << endl;
+
+            // Single linkage: stop at 5 clusters
+        DisjSets clusters{ N };
+        kruskal( clusters, edges, forest, 5 );
+        vector<int> labels;
+        if( (int) forest.size( ) != N - 5 || clusters.compact( labels ) != 5 )
+            cout << "Clustering error!" << endl;
+    }
+
+        // Edge files
+    vector<WeightedEdge<double>> edges( 1000 ), read;
+    for( auto & e : edges )
+        e = { r.nextInt( 100 ), r.nextInt( 100 ), r.nextDouble( ) };
+    const char *FILE_NAME = "TestKruskal.bin";
+    if( !writeEdges( FILE_NAME, edges ) || !readEdges( FILE_NAME, read ) || read.size( ) != edges.size( ) )
+        cout << "Edge file error!" << endl;
+    for( size_t i = 0; i < read.size( ); ++i )
+        if( read[ i ].u != edges[ i ].u || read[ i ].v != edges[ i ].v || read[ i ].weight != edges[ i ].weight )
+            cout << "Edge file contents error!" << endl;
+    remove( FILE_NAME );
+    if( readEdges( FILE_NAME, read ) )
+        cout << "Read of missing file error!" << endl;
+
+        // Padding in the records is written as zeros, whatever was there
+    vector<WeightedEdge<int16_t>> padded( 3 );
+    memset( padded.data( ), 0xAB, padded.size( ) * sizeof( padded[ 0 ] ) );
+    for( int i = 0; i < 3; ++i )
+    {
+        padded[ i ].u = i;
+        padded[ i ].v = i + 1;
+        padded[ i ].weight = -i;
+    }
+    writeEdges( FILE_NAME, padded );
+    ifstream in( FILE_NAME, ios::binary );
+    string bytes{ istreambuf_iterator<char>( in ), istreambuf_iterator<char>( ) };
+    in.close( );
+    remove( FILE_NAME );
+    if( sizeof( padded[ 0 ] ) > 10 && bytes.size( ) == 3 * sizeof( padded[ 0 ] )
+        && bytes.find( '\xAB' ) != string::npos )
+        cout << "Edge file padding error!" << endl;
+
+        // 64-bit weights are summed exactly
+    const int64_t BIG = int64_t( 1 ) << 60;
+    vector<WeightedEdge<int64_t>> heavy = { { 0, 1, BIG + 1 }, { 1, 2, BIG + 3 } };
+    vector<WeightedEdge<int64_t>> heavyForest;
+    DisjSets three{ 3 };
+    int64_t heavyTotal = kruskal( three, heavy, heavyForest );
+    if( heavyTotal != 2 * BIG + 4 )
+        cout << "64-bit total error!" << endl;
+
+        // A maze: every cell reachable, by exactly one path
+    const int ROWS = 8, COLS = 20;
+    vector<WeightedEdge<int>> open = randomMaze( ROWS, COLS, 42 );
+    if( (int) open.size( ) != ROWS * COLS - 1 )
+        cout << "Maze error!" << endl;
+    vector<bool> openRight( ROWS * COLS, false ), openDown( ROWS * COLS, false );
+    for( auto & e : open )
+        ( e.v == e.u + 1 ? openRight : openDown )[ e.u ] = true;
+
+    cout << "Random maze:" << endl;
+    cout << "+";
+    for( int col = 0; col < COLS; ++col )
+        cout << ( col == 0 ? "  +" : "--+" );
+    cout << endl;
+    for( int row = 0; row < ROWS; ++row )
+    {
+        cout << "|";
+        for( int col = 0; col < COLS; ++col )
+            cout << "  " << ( openRight[ row * COLS + col ] || ( row == ROWS - 1 && col == COLS - 1 ) ? " " : "|" );
+        cout << endl << "+";
+        for( int col = 0; col < COLS; ++col )
+            cout << ( openDown[ row * COLS + col ] ? "  +" : "--+" );
+        cout << endl;
+    }
+    cout << "Test completed." << endl;
+    return 0;
+}
@@ -42,6 +42,23 @@ int main( )
             cout << "Oops! " << i << endl;
     }
 
+    PairingHeap<int> h3;
+    for( i = 37; i != 0; i = ( i + 37 ) % numItems )
+        if( i % 2 == 0 )
+            h3.insert( i );
+        else
+            h2.insert( i );
+    h2.merge( h3 );
+    if( !h3.isEmpty( ) )
+        cout << "Oops! h3 should have been empty!" << endl;
+    for( i = 1; i < numItems; ++i )
+    {
+        int x;
+        h2.deleteMin( x );
+        if( x != i )
+            cout << "Oops! " << i << endl;
+    }
+
     cout << "Check completed" << endl;
     return 0;
 }
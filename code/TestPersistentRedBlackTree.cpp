@@ -0,0 +1,121 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "PersistentRedBlackTree.h"
+using namespace std;
+
+    // Test program (compile with -pthread)
+int main( )
+{
+    PersistentRedBlackTree<int> t;
+    int NUMS = 40000;
+    const int GAP  =   37;
+    int i;
+
+    cout << "Checking... (no more output means success)" << endl;
+
+    for( i = GAP; i != 0; i = ( i + GAP ) % NUMS )
+        t.insert( i );
+    PersistentRedBlackTree<int>::Version all = t.snapshot( );
+    for( i = 1; i < NUMS; i += 2 )
+        t.remove( i );
+
+    if( NUMS < 40 )
+        t.printTree( );
+    if( t.findMin( ) != 2 || t.findMax( ) != NUMS - 2 )
+        cout << "FindMin or FindMax error!" << endl;
+
+    for( i = 2; i < NUMS; i += 2 )
+        if( !t.contains( i ) )
+            cout << "Find error1!" << endl;
+    for( i = 1; i < NUMS; i += 2 )
+        if( t.contains( i ) )
+            cout << "Find error2!" << endl;
+
+        // The snapshot taken before the removes still has every item
+    for( i = 1; i < NUMS; ++i )
+        if( !all.contains( i ) )
+            cout << "Snapshot error!" << endl;
+    if( all.contains( 0 ) || all.findMin( ) != 1 || all.findMax( ) != NUMS - 1 )
+        cout << "Snapshot error2!" << endl;
+
+        // Versions derived from a snapshot
+    PersistentRedBlackTree<int>::Version v = all.remove( 5 ).insert( NUMS );
+    if( v.contains( 5 ) || !v.contains( NUMS ) || !all.contains( 5 ) || all.contains( NUMS ) )
+        cout << "Version error!" << endl;
+
+    PersistentRedBlackTree<int> t2;
+    t2 = t;
+    t.makeEmpty( );
+    if( !t.isEmpty( ) )
+        cout << "makeEmpty error!" << endl;
+    for( i = 2; i < NUMS; i += 2 )
+        if( !t2.contains( i ) )
+            cout << "Copy error!" << endl;
+
+        // One writer removes the even items while readers check that each
+        // snapshot holds a suffix of them, as the writer removes in order
+    vector<thread> readers;
+    for( int r = 0; r < 3; ++r )
+        readers.emplace_back( [ & ] {
+            for( int j = 0; j < 2000; ++j )
+            {
+                auto s = t2.snapshot( );
+                if( s.isEmpty( ) )
+                    break;
+                int low = s.findMin( );
+                for( int k = low; k < NUMS; k += 2 * GAP )
+                    if( !s.contains( k ) )
+                    {
+                        cout << "Concurrent snapshot error!" << endl;
+                        return;
+                    }
+            }
+        } );
+    for( i = 2; i < NUMS; i += 2 )
+        t2.remove( i );
+    for( auto & r : readers )
+        r.join( );
+    if( !t2.isEmpty( ) )
+        cout << "Concurrent remove error!" << endl;
+
+        // Two writers insert the odd and even items while readers search
+        // the current version in place; items once seen must stay
+    PersistentRedBlackTree<int> t3;
+    vector<thread> threads;
+    for( int w = 0; w < 2; ++w )
+        threads.emplace_back( [ &, w ] {
+            for( int k = w; k < NUMS; k += 2 )
+                t3.insert( k );
+        } );
+    for( int r = 0; r < 2; ++r )
+        threads.emplace_back( [ & ] {
+            for( int k = 0; k < NUMS; k += GAP )
+                while( !t3.contains( k ) )
+                    if( !t3.isEmpty( ) && t3.findMin( ) != 0 && t3.findMin( ) != 1 )
+                    {
+                        cout << "Concurrent findMin error!" << endl;
+                        return;
+                    }
+            for( int k = 0; k < NUMS; k += GAP )
+                if( !t3.contains( k ) )
+                    cout << "Concurrent insert lost an item!" << endl;
+        } );
+    for( auto & th : threads )
+        th.join( );
+    for( i = 0; i < NUMS; ++i )
+        if( !t3.contains( i ) )
+            cout << "Concurrent insert error!" << endl;
+
+    try
+    {
+        t2.findMin( );
+        cout << "findMin on empty tree did not throw!" << endl;
+    }
+    catch( const UnderflowException & )
+    {
+    }
+
+    cout << "Test complete..." << endl;
+    return 0;
+}
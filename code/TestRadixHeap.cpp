@@ -0,0 +1,59 @@
+#include <iostream>
+#include <utility>
+#include "RadixHeap.h"
+using namespace std;
+
+    // Test program
+int main( )
+{
+    unsigned int numItems = 10000;
+    RadixHeap<unsigned int> h;
+    unsigned int i = 37;
+    unsigned int x;
+
+    cout << "Begin test... " << endl;
+
+    for( i = 37; i != 0; i = ( i + 37 ) % numItems )
+        h.insert( i );
+    for( i = 1; i < numItems; ++i )
+    {
+        h.deleteMin( x );
+        if( x != i )
+            cout << "Oops! " << i << endl;
+
+            // Monotone inserts interleaved with removals
+        if( i % 3 == 0 )
+            h.insert( i + 2 * numItems );
+    }
+    for( i = 3; i < numItems; i += 3 )
+    {
+        h.deleteMin( x );
+        if( x != i + 2 * numItems )
+            cout << "Oops! " << i << endl;
+    }
+    if( !h.isEmpty( ) )
+        cout << "Oops! h should be empty!" << endl;
+
+    try
+    {
+        h.insert( 5 );
+        cout << "Oops! non-monotone insert accepted" << endl;
+    }
+    catch( const IllegalArgumentException & )
+    {
+    }
+
+    RadixHeap<pair<unsigned long long, int>> h2;
+    h2.insert( { 1ULL << 40, 2 } );
+    h2.insert( { 7, 1 } );
+    h2.insert( { 7, 0 } );
+    if( h2.findMin( ).first != 7 )
+        cout << "Oops! findMin on pairs" << endl;
+    h2.deleteMin( );
+    h2.deleteMin( );
+    if( h2.findMin( ).second != 2 )
+        cout << "Oops! 64-bit keys" << endl;
+
+    cout << "End test... no other output is good" << endl;
+    return 0;
+}
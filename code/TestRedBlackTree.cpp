@@ -1,7 +1,34 @@
 #include <iostream>
+#include <vector>
 #include "RedBlackTree.h"
 using namespace std;
 
+/**
+ * Check that t iterates, forward and backward, over exactly the items
+ * of sorted; parent links are followed both ways.
+ */
+template <typename Tree>
+void checkIteration( const Tree & t, const vector<int> & sorted, const char *name )
+{
+    auto itr = t.begin( );
+    for( int x : sorted )
+        if( itr == t.end( ) || *itr++ != x )
+        {
+            cout << name << " forward iterator error!" << endl;
+            return;
+        }
+    if( itr != t.end( ) )
+        cout << name << " forward iterator length error!" << endl;
+    for( size_t k = sorted.size( ); k-- > 0; )
+        if( itr == t.begin( ) || *--itr != sorted[ k ] )
+        {
+            cout << name << " backward iterator error!" << endl;
+            return;
+        }
+    if( itr != t.begin( ) )
+        cout << name << " backward iterator length error!" << endl;
+}
+
     // Test program
 int main( )
 {
@@ -37,6 +64,98 @@ int main( )
     if( t2.contains( 0 ) )
         cout << "Oops!" << endl;
 
+        // In-order iteration over 1 .. NUMS - 1
+    i = 1;
+    for( auto itr = t2.begin( ); itr != t2.end( ); ++itr, ++i )
+        if( *itr != i )
+            cout << "Iterator error!" << endl;
+    if( i != NUMS )
+        cout << "Iterator length error!" << endl;
+    try
+    {
+        ++t2.end( );
+        cout << "Iterator past end not detected!" << endl;
+    }
+    catch( const IteratorOutOfBoundsException & ) { }
+    try
+    {
+        --t2.begin( );
+        cout << "Iterator before begin not detected!" << endl;
+    }
+    catch( const IteratorOutOfBoundsException & ) { }
+    for( auto itr = t2.end( ); itr != t2.begin( ); )
+        if( *--itr != --i )
+            cout << "Reverse iterator error!" << endl;
+
+        // Bounds, on the multiples of 2 below 40
+    RedBlackTree<int> evens{ NEG_INF };
+    for( i = 38; i >= 0; i -= 2 )
+        evens.insert( i );
+    auto range = evens.range( 7, 15 );
+    auto equal = evens.equal_range( 8 );
+    auto missing = evens.equal_range( 9 );
+    if( *range.first != 8 || *--range.second != 14
+        || *equal.first != 8 || ++equal.first != equal.second
+        || missing.first != missing.second || *missing.first != 10
+        || *evens.lower_bound( 8 ) != 8 || *evens.upper_bound( 8 ) != 10
+        || evens.lower_bound( 40 ) != evens.end( ) || evens.upper_bound( -1 ) != evens.begin( ) )
+        cout << "Bounds error!" << endl;
+
+        // Bulk build the multiples of 3 (with duplicates) on two threads,
+        // then union with items NUMS .. 2 * NUMS - 1
+    vector<int> threes;
+    for( i = 0; i < 2 * NUMS; i += 3 )
+    {
+        threes.push_back( i );
+        threes.push_back( i );
+    }
+    RedBlackTree<int> t3{ NEG_INF, threes.begin( ), threes.end( ), 2 };
+    for( i = 0; i < 2 * NUMS; ++i )
+        if( t3.contains( i ) != ( i % 3 == 0 ) )
+            cout << "Bulk build error!" << endl;
+
+    for( i = NUMS; i < 2 * NUMS; ++i )
+        t.insert( i );
+    t3.unionWith( t );
+    if( !t.isEmpty( ) )
+        cout << "Union should empty rhs!" << endl;
+    for( i = 1; i < 2 * NUMS; ++i )
+        if( !t3.contains( i ) )
+            cout << "Union error!" << endl;
+    t3.insert( 2 * NUMS );
+    if( t3.findMin( ) != 0 || t3.findMax( ) != 2 * NUMS )
+        cout << "Union FindMin or FindMax error!" << endl;
+    vector<int> expected;
+    for( i = 0; i <= 2 * NUMS; ++i )
+        expected.push_back( i );
+    checkIteration( t3, expected, "Union" );
+
+        // Repeat the bulk build and union with index-linked arena storage
+    RedBlackTree<int, ArenaNodes> a{ NEG_INF, threes.begin( ), threes.end( ), 2 };
+    RedBlackTree<int, ArenaNodes> a2{ NEG_INF };
+    for( i = GAP; i != 0; i = ( i + GAP ) % NUMS )
+        a2.insert( i );
+    RedBlackTree<int, ArenaNodes> a3 = a2;
+    a.unionWith( a2 );
+    a2.insert( 0 );
+    for( i = 0; i < 2 * NUMS; ++i )
+        if( a.contains( i ) != ( i < NUMS || i % 3 == 0 ) || a3.contains( i ) != ( i > 0 && i < NUMS ) )
+            cout << "Arena error!" << endl;
+    auto itr = a.begin( );
+    for( i = 0; i < 2 * NUMS; ++i )
+        if( ( i < NUMS || i % 3 == 0 ) && ( itr == a.end( ) || *itr++ != i ) )
+            cout << "Arena iterator error!" << endl;
+    if( itr != a.end( ) )
+        cout << "Arena iterator length error!" << endl;
+    expected.clear( );
+    for( i = 0; i < 2 * NUMS; ++i )
+        if( i < NUMS || i % 3 == 0 )
+            expected.push_back( i );
+    checkIteration( a, expected, "Arena" );
+    a3.makeEmpty( );
+    if( !a3.isEmpty( ) || !a2.contains( 0 ) || a2.findMax( ) != 0 )
+        cout << "Arena makeEmpty error!" << endl;
+
     cout << "Test complete..." << endl;
     return 0;
 }
@@ -1,5 +1,6 @@
 #include <iostream>
 #include "Sort.h"
+#include "TreeSort.h"
 #include <vector>
 #include <string>
 #include "UniformRandom.h"
@@ -63,11 +64,34 @@ int main( )
         SORT( a );
         checkSort( a );
 
+        for( TreeSortMode mode : { TreeSortMode::AVL, TreeSortMode::RED_BLACK,
+                                   TreeSortMode::TREAP, TreeSortMode::COUNTED } )
+        {
+            permute( a );
+            treeSort( a, mode );
+            checkSort( a );
+        }
+
         permute( a );
         quickSelect( a, NUM_ITEMS / 2 );
         cout << a[ NUM_ITEMS / 2 - 1 ].length( ) << " " << NUM_ITEMS / 2 << endl;
     }
 
+    cout << "Checking treeSort with duplicates" << endl;
+    vector<int> dups;
+    for( int i = 0; i < NUM_ITEMS; ++i )
+        dups.push_back( i % 10 );
+    permute( dups );
+    for( TreeSortMode mode : { TreeSortMode::AVL, TreeSortMode::RED_BLACK,
+                               TreeSortMode::TREAP, TreeSortMode::COUNTED } )
+    {
+        vector<int> sorted;
+        treeSort( begin( dups ), end( dups ), back_inserter( sorted ), mode );
+        for( int i = 0; i < NUM_ITEMS; ++i )
+            if( sorted.size( ) != NUM_ITEMS || sorted[ i ] != i / ( NUM_ITEMS / 10 ) )
+                cout << "treeSort duplicate error!" << endl;
+    }
+
     cout << "Checking SORT, Fig 7.13" << endl;
     int N = NUM_ITEMS * NUM_ITEMS;
     vector<int> b( N );
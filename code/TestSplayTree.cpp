@@ -1,7 +1,35 @@
     #include <iostream>
+    #include <string>
     #include "SplayTree.h"
     using namespace std;
 
+    /**
+     * Check that t iterates, forward and backward, over the even
+     * items from first to NUMS - 2; parent links are followed both ways.
+     */
+    template <typename Tree>
+    void checkIteration( const Tree & t, int first, int NUMS, const char *name )
+    {
+        int i = first;
+        auto itr = t.begin( );
+        for( ; itr != t.end( ); ++itr, i += 2 )
+            if( *itr != i )
+            {
+                cout << name << " forward iterator error!" << endl;
+                return;
+            }
+        if( i != NUMS )
+            cout << name << " forward iterator length error!" << endl;
+        while( itr != t.begin( ) )
+            if( *--itr != ( i -= 2 ) )
+            {
+                cout << name << " backward iterator error!" << endl;
+                return;
+            }
+        if( i != first )
+            cout << name << " backward iterator length error!" << endl;
+    }
+
         // Test program
     int main( )
     {
@@ -46,6 +74,92 @@
                 cout << "Find error2!" << endl;
         }
 
+        if( t2.size( ) != NUMS / 2 - 1 )
+            cout << "Size error!" << endl;
+
+            // Iteration and bounds, which do not splay
+        checkIteration( t, 2, NUMS, "Splayed" );
+        checkIteration( t2, 2, NUMS, "Copied" );
+        try
+        {
+            --t2.begin( );
+            cout << "Iterator before begin not detected!" << endl;
+        }
+        catch( const IteratorOutOfBoundsException & ) { }
+        auto range = t2.range( 7, 15 );
+        auto equal = t2.equal_range( 8 );
+        auto missing = t2.equal_range( 9 );
+        if( *range.first != 8 || *--range.second != 14
+            || *equal.first != 8 || ++equal.first != equal.second
+            || missing.first != missing.second || *missing.first != 10
+            || *t2.lower_bound( 8 ) != 8 || *t2.upper_bound( 8 ) != 10
+            || t2.lower_bound( NUMS ) != t2.end( ) || t2.upper_bound( 0 ) != t2.begin( ) )
+            cout << "Bounds error!" << endl;
+
+            // peek answers like contains, through a const tree
+        const SplayTree<int> & reader = t;
+        for( i = 0; i < NUMS; ++i )
+            if( reader.peek( i ) != ( i > 0 && i % 2 == 0 ) )
+                cout << "Peek error!" << endl;
+        if( SplayTree<int>{ }.peek( 0 ) )
+            cout << "Peek on empty error!" << endl;
+
+            // Each contains mode, on a sequential pass and a strided one
+        for( SplayMode mode : { SplayMode::SEMI_SPLAY, SplayMode::RANDOM_SPLAY,
+                                SplayMode::DEPTH_SPLAY } )
+        {
+            SplayTree<int> s = t;
+            s.setSplayMode( mode, mode == SplayMode::RANDOM_SPLAY ? 0.25 : 2 );
+            for( int pass = 0; pass < 2; ++pass )
+                for( int k = 0, j = 0; k < NUMS; ++k, j = ( j + ( pass ? GAP : 1 ) ) % NUMS )
+                    if( s.contains( j ) != ( j > 0 && j % 2 == 0 ) )
+                        cout << "Splay mode error!" << endl;
+            auto frozen = s.freeze( );
+            if( s.size( ) != NUMS / 2 - 1 || frozen.size( ) != s.size( ) )
+                cout << "Splay mode size error!" << endl;
+            for( i = 2; i < NUMS; i += 2 )
+                if( !frozen.contains( i ) || frozen.contains( i + 1 ) )
+                    cout << "Splay mode order error!" << endl;
+            s.remove( 2 );
+            if( s.contains( 2 ) || s.findMin( ) != 4 || s.size( ) != NUMS / 2 - 2 )
+                cout << "Splay mode remove error!" << endl;
+            checkIteration( s, 4, NUMS, "Splay mode" );
+        }
+
+            // Sequential inserts leave a path of a million nodes,
+            // which freeze must walk without recursion
+        SplayTree<int> path;
+        const int PATH = 1000000;
+        for( i = 0; i < PATH; ++i )
+            path.insert( i );
+        auto frozenPath = path.freeze( );
+        if( frozenPath.size( ) != PATH || frozenPath.findMin( ) != 0
+            || frozenPath.findMax( ) != PATH - 1 || !frozenPath.contains( PATH / 2 ) )
+            cout << "Degenerate freeze error!" << endl;
+
+            // Repeat with index-linked arena storage, including items
+            // that need a destructor
+        SplayTree<int, ArenaNodes> a;
+        SplayTree<string, ArenaNodes> strings;
+        for( i = GAP; i != 0; i = ( i + GAP ) % NUMS )
+        {
+            a.insert( i );
+            strings.insert( to_string( i ) );
+        }
+        for( i = 1; i < NUMS; i += 2 )
+        {
+            a.remove( i );
+            strings.remove( to_string( i ) );
+        }
+        SplayTree<int, ArenaNodes> a2 = a;
+        a.makeEmpty( );
+        a.insert( 1 );
+        for( i = 1; i < NUMS; ++i )
+            if( a2.contains( i ) != ( i % 2 == 0 ) || strings.contains( to_string( i ) ) != ( i % 2 == 0 )
+                || a.contains( i ) != ( i == 1 ) )
+                cout << "Arena error!" << endl;
+        checkIteration( a2, 2, NUMS, "Arena" );
+
         cout << "Test completed." << endl;
         return 0;
 }
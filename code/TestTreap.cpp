@@ -1,8 +1,41 @@
 #include <iostream>
+#include <vector>
 #include "Treap.h"
 
 using namespace std;
 
+/**
+ * Check that t iterates, forward and backward, over exactly the items
+ * i in 1 .. limit - 1 with inTreap( i ); parent links are followed
+ * both ways.
+ */
+template <typename Predicate>
+void checkIteration( const Treap<int> & t, int limit, Predicate inTreap, const char *name )
+{
+    vector<int> sorted;
+    for( int i = 1; i < limit; ++i )
+        if( inTreap( i ) )
+            sorted.push_back( i );
+
+    auto itr = t.begin( );
+    for( int x : sorted )
+        if( itr == t.end( ) || *itr++ != x )
+        {
+            cout << name << " forward iterator error!" << endl;
+            return;
+        }
+    if( itr != t.end( ) )
+        cout << name << " forward iterator length error!" << endl;
+    for( size_t k = sorted.size( ); k-- > 0; )
+        if( itr == t.begin( ) || *--itr != sorted[ k ] )
+        {
+            cout << name << " backward iterator error!" << endl;
+            return;
+        }
+    if( itr != t.begin( ) )
+        cout << name << " backward iterator length error!" << endl;
+}
+
     // Test program
 int main( )
 {
@@ -47,6 +80,92 @@ int main( )
             cout << "Find error2!" << endl;
     }
 
+        // In-order iteration over the even items
+    i = 2;
+    for( int x : t2 )
+    {
+        if( x != i )
+            cout << "Iterator error!" << endl;
+        i += 2;
+    }
+    if( i != NUMS )
+        cout << "Iterator length error!" << endl;
+    checkIteration( t, NUMS, [ ]( int x ) { return x % 2 == 0; }, "Remove" );
+    try
+    {
+        --t2.begin( );
+        cout << "Iterator before begin not detected!" << endl;
+    }
+    catch( const IteratorOutOfBoundsException & ) { }
+
+        // Bounds
+    auto range = t2.range( 7, 15 );
+    auto equal = t2.equal_range( 8 );
+    auto missing = t2.equal_range( 9 );
+    if( *range.first != 8 || *--range.second != 14
+        || *equal.first != 8 || ++equal.first != equal.second
+        || missing.first != missing.second || *missing.first != 10
+        || *t2.lower_bound( 8 ) != 8 || *t2.upper_bound( 8 ) != 10
+        || t2.lower_bound( NUMS ) != t2.end( ) || t2.upper_bound( 0 ) != t2.begin( ) )
+        cout << "Bounds error!" << endl;
+
+        // Order statistics over the even items 2, 4, ..., NUMS - 2
+    if( t2.size( ) != NUMS / 2 - 1 )
+        cout << "Size error!" << endl;
+    for( i = 2; i < NUMS; i += 2 )
+        if( t2.select( i / 2 ) != i || t2.rank( i ) != i / 2 - 1 || t2.rank( i + 1 ) != i / 2 )
+            cout << "Rank or select error!" << endl;
+    if( t2.countInRange( 3, 11 ) != 4 || t2.countInRange( 2, 2 ) != 1
+        || t2.countInRange( 11, 3 ) != 0 || t2.countInRange( 0, NUMS ) != t2.size( ) )
+        cout << "CountInRange error!" << endl;
+    try
+    {
+        t2.select( t2.size( ) + 1 );
+        cout << "Select out of range not detected!" << endl;
+    }
+    catch( const ArrayIndexOutOfBoundsException & ) { }
+
+        // Split t2 at NUMS / 2 and join the halves back
+    Treap<int> upper = t2.split( NUMS / 2 );
+    if( t2.findMax( ) >= NUMS / 2 || upper.findMin( ) != NUMS / 2
+        || t2.size( ) + upper.size( ) != NUMS / 2 - 1 )
+        cout << "Split error!" << endl;
+    try
+    {
+        upper.join( t2 );
+        cout << "Join of smaller items not detected!" << endl;
+    }
+    catch( const IllegalArgumentException & ) { }
+    t2.join( upper );
+    if( !upper.isEmpty( ) || t2.size( ) != NUMS / 2 - 1 || t2.select( NUMS / 4 ) != NUMS / 2 )
+        cout << "Join error!" << endl;
+    checkIteration( t2, NUMS, [ ]( int x ) { return x % 2 == 0; }, "Join" );
+
+        // Set operations with the multiples of three, on two threads
+    Treap<int> threes;
+    for( i = 3; i < NUMS; i += 3 )
+        threes.insert( i );
+    Treap<int> inter = t2;
+    inter.intersectWith( threes, 2 );
+    Treap<int> diff = t2;
+    diff.differenceWith( threes, 2 );
+    Treap<int> uni = t2;
+    uni.unionWith( threes, 2 );
+    if( !threes.isEmpty( ) )
+        cout << "Union should empty rhs!" << endl;
+    for( i = 1; i < NUMS; ++i )
+    {
+        bool even = i % 2 == 0, three = i % 3 == 0;
+        if( inter.contains( i ) != ( even && three ) || diff.contains( i ) != ( even && !three )
+            || uni.contains( i ) != ( even || three ) )
+            cout << "Set operation error!" << endl;
+    }
+    if( inter.size( ) + diff.size( ) != t2.size( ) || uni.rank( NUMS ) != uni.size( ) )
+        cout << "Set operation size error!" << endl;
+    checkIteration( inter, NUMS, [ ]( int x ) { return x % 6 == 0; }, "Intersection" );
+    checkIteration( diff, NUMS, [ ]( int x ) { return x % 2 == 0 && x % 3 != 0; }, "Difference" );
+    checkIteration( uni, NUMS, [ ]( int x ) { return x % 2 == 0 || x % 3 == 0; }, "Union" );
+
     cout << "Test finished" << endl;
     return 0;
 }
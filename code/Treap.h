@@ -2,15 +2,22 @@
 #define TREAP_H
 
 #include <climits>
+#include <future>
 #include "UniformRandom.h"
 #include "dsexceptions.h"
+#include "EytzingerSet.h"
 #include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
 
 
 using namespace std;
 
 // Treap class
 //
+// CONSTRUCTION: zero parameter
+//
 // ******************PUBLIC OPERATIONS*********************
 // void insert( x )       --> Insert x
 // void remove( x )       --> Remove x (unimplemented)
@@ -20,40 +27,152 @@ using namespace std;
 // bool isEmpty( )        --> Return true if empty; else false
 // void makeEmpty( )      --> Remove all items
 // void printTree( )      --> Print tree in sorted order
+// Treap split( x )       --> Move items not less than x to returned treap
+// void join( rhs )       --> Append rhs, whose items are all larger
+// void unionWith( rhs )  --> Absorb rhs into this treap
+// void intersectWith( rhs ) --> Keep only items also in rhs
+// void differenceWith( rhs ) --> Remove items that are in rhs
+// int size( )            --> Return number of items
+// int rank( x )          --> Return number of items less than x
+// Comparable select( k ) --> Return k-th smallest item (k from 1)
+// int countInRange( lo, hi )
+//                        --> Return number of items in [ lo, hi ]
+// const_iterator begin( ), end( )
+//                        --> Bidirectional in-order iteration
+// const_iterator lower_bound( x )
+//                        --> First item not less than x
+// const_iterator upper_bound( x )
+//                        --> First item greater than x
+// pair equal_range( x )  --> Iterators bounding the items equal to x
+// pair range( lo, hi )   --> Iterators bounding the items in [ lo, hi ]
+// EytzingerSet freeze( ) --> Return a read-only copy for fast lookups
 // ******************ERRORS********************************
 // Throws UnderflowException as warranted
+// Throws ArrayIndexOutOfBoundsException if select's k is out of range
+// Throws IllegalArgumentException if join's rhs has a too-small item
+// Throws IteratorOutOfBoundsException if an iterator moves
+//     beyond begin( ) or end( )
 
 template <typename Comparable>
 class Treap
 {
+    struct TreapNode;
+
   public:
-    Treap( )
+    /**
+     * In-order iterator. Each step follows child and parent links,
+     * so a full scan takes linear time and no stack.
+     * Changing the treap invalidates all iterators.
+     */
+    class const_iterator
+    {
+      public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type        = Comparable;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const Comparable *;
+        using reference         = const Comparable &;
+
+        const_iterator( ) : treap{ nullptr }, current{ nullptr }
+          { }
+
+        const Comparable & operator* ( ) const
+          { return current->element; }
+
+        const Comparable * operator-> ( ) const
+          { return &current->element; }
+
+        const_iterator & operator++ ( )
+        {
+            if( current == nullptr )
+                throw IteratorOutOfBoundsException{ };
+            if( current->right != treap->nullNode )
+                current = treap->findMin( current->right );
+            else
+            {
+                TreapNode *child;
+                do
+                {
+                    child = current;
+                    current = current->parent;
+                } while( current != nullptr && child == current->right );
+            }
+            return *this;
+        }
+
+        const_iterator operator++ ( int )
+        {
+            const_iterator old = *this;
+            ++( *this );
+            return old;
+        }
+
+        const_iterator & operator-- ( )
+        {
+            TreapNode *p = current;
+            if( p == nullptr )
+                p = treap->isEmpty( ) ? nullptr : treap->findMax( treap->root );
+            else if( p->left != treap->nullNode )
+                p = treap->findMax( p->left );
+            else
+            {
+                TreapNode *child;
+                do
+                {
+                    child = p;
+                    p = p->parent;
+                } while( p != nullptr && child == p->left );
+            }
+            if( p == nullptr )
+                throw IteratorOutOfBoundsException{ };
+            current = p;
+            return *this;
+        }
+
+        const_iterator operator-- ( int )
+        {
+            const_iterator old = *this;
+            --( *this );
+            return old;
+        }
+
+        bool operator== ( const const_iterator & rhs ) const
+          { return current == rhs.current; }
+
+        bool operator!= ( const const_iterator & rhs ) const
+          { return !( *this == rhs ); }
+
+      private:
+        const Treap *treap;
+        TreapNode *current;    // nullptr for end( )
+
+        const_iterator( const Treap *t, TreapNode *p )
+          : treap{ t }, current{ p }
+          { }
+
+        friend class Treap;
+    };
+
+    Treap( ) : nullNode{ sharedNullNode( ) }
     {
-        nullNode = new TreapNode;
-        nullNode->left = nullNode->right = nullNode;
-        nullNode->priority = INT_MAX;
         root = nullNode;
     }
 
-    Treap( const Treap & rhs )
+    Treap( const Treap & rhs ) : nullNode{ sharedNullNode( ) }
     {
-        nullNode = new TreapNode;
-        nullNode->left = nullNode->right = nullNode;
-        nullNode->priority = INT_MAX;
         root = clone( rhs.root );
+        setRootParent( );
     }
 
     ~Treap( )
     {
         makeEmpty( );
-        delete nullNode;
     }
     
 
     Treap( Treap && rhs ) : root{ rhs.root }, nullNode{ rhs.nullNode }
     {
-        rhs.root = nullptr;
-        rhs.nullNode = nullptr;
+        rhs.root = rhs.nullNode;
     }
 
     
@@ -73,7 +192,6 @@ class Treap
     Treap & operator=( Treap && rhs )
     {
         std::swap( root, rhs.root );
-        std::swap( nullNode, rhs.nullNode );
         
         return *this;
     }
@@ -105,17 +223,17 @@ class Treap
     bool contains( const Comparable & x ) const
     {
         TreapNode *current = root;
-        nullNode->element = x;
 
-        for( ; ; )
+        while( current != nullNode )
         {
             if( x < current->element )
                 current = current->left;
             else if( current->element < x )
                 current = current->right;
             else
-                return current != nullNode;
+                return true;
         }
+        return false;
     }
 
     bool isEmpty( ) const
@@ -123,6 +241,65 @@ class Treap
         return root == nullNode;
     }
 
+    int size( ) const
+    {
+        return root->size;
+    }
+
+    /**
+     * Return the number of items less than x.
+     * If x is present, select( rank( x ) + 1 ) is x.
+     */
+    int rank( const Comparable & x ) const
+    {
+        int r = 0;
+        for( TreapNode *t = root; t != nullNode; )
+            if( x < t->element )
+                t = t->left;
+            else if( t->element < x )
+            {
+                r += t->left->size + 1;
+                t = t->right;
+            }
+            else
+                return r + t->left->size;
+        return r;
+    }
+
+    /**
+     * Return the k-th smallest item; select( 1 ) is findMin( ).
+     * Throw ArrayIndexOutOfBoundsException unless 1 <= k <= size( ).
+     */
+    const Comparable & select( int k ) const
+    {
+        if( k < 1 || k > size( ) )
+            throw ArrayIndexOutOfBoundsException{ };
+
+        TreapNode *t = root;
+        for( ; ; )
+        {
+            if( k <= t->left->size )
+                t = t->left;
+            else if( k == t->left->size + 1 )
+                return t->element;
+            else
+            {
+                k -= t->left->size + 1;
+                t = t->right;
+            }
+        }
+    }
+
+    /**
+     * Return the number of items x with lo <= x <= hi.
+     */
+    int countInRange( const Comparable & lo, const Comparable & hi ) const
+    {
+        if( hi < lo )
+            return 0;
+        return rank( hi ) + contains( hi ) - rank( lo );
+    }
+
     void printTree( ) const
     {
         if( isEmpty( ) )
@@ -131,6 +308,74 @@ class Treap
             printTree( root );
     }
 
+    const_iterator begin( ) const
+      { return const_iterator{ this, isEmpty( ) ? nullptr : findMin( root ) }; }
+
+    const_iterator end( ) const
+      { return const_iterator{ this, nullptr }; }
+
+    /**
+     * Return an iterator to the first item not less than x.
+     */
+    const_iterator lower_bound( const Comparable & x ) const
+    {
+        TreapNode *bound = nullptr;
+        for( TreapNode *t = root; t != nullNode; )
+            if( t->element < x )
+                t = t->right;
+            else
+            {
+                bound = t;
+                t = t->left;
+            }
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * Return an iterator to the first item greater than x.
+     */
+    const_iterator upper_bound( const Comparable & x ) const
+    {
+        TreapNode *bound = nullptr;
+        for( TreapNode *t = root; t != nullNode; )
+            if( x < t->element )
+            {
+                bound = t;
+                t = t->left;
+            }
+            else
+                t = t->right;
+        return const_iterator{ this, bound };
+    }
+
+    /**
+     * Return the iterators bounding the items equal to x,
+     * as lower_bound( x ) and upper_bound( x ).
+     */
+    pair<const_iterator, const_iterator> equal_range( const Comparable & x ) const
+    {
+        return { lower_bound( x ), upper_bound( x ) };
+    }
+
+    /**
+     * Return the iterators bounding the items in the closed range [ lo, hi ].
+     */
+    pair<const_iterator, const_iterator> range( const Comparable & lo,
+                                                const Comparable & hi ) const
+    {
+        return { lower_bound( lo ), upper_bound( hi ) };
+    }
+
+    /**
+     * Return a read-only copy of the items, laid out for fast lookups.
+     * The items are read in order through the iterators, so no
+     * recursion and no temporary copy are needed.
+     */
+    EytzingerSet<Comparable> freeze( ) const
+    {
+        return EytzingerSet<Comparable>{ begin( ), end( ) };
+    }
+
     void makeEmpty( )
     {
         makeEmpty( root );
@@ -139,16 +384,92 @@ class Treap
     void insert( const Comparable & x )
     {
         insert( x, root );
+        setRootParent( );
     }
 
     void insert( Comparable && x )
     {
         insert( std::move( x ), root );
+        setRootParent( );
     }
 
     void remove( const Comparable & x )
     {
         remove( x, root );
+        setRootParent( );
+    }
+
+    /**
+     * Move every item not less than x into a new treap, and return it.
+     * Takes O( log n ) expected time.
+     */
+    Treap split( const Comparable & x )
+    {
+        Treap greater;
+        TreapNode *match = split( root, x, root, greater.root );
+        if( match != nullNode )
+            greater.root = join( match, greater.root );
+        setRootParent( );
+        greater.setRootParent( );
+        return greater;
+    }
+
+    /**
+     * Append the items of rhs, which must all be larger than the items
+     * in this treap; throw IllegalArgumentException otherwise.
+     * rhs becomes empty. Takes O( log n ) expected time.
+     */
+    void join( Treap & rhs )
+    {
+        if( this == &rhs || rhs.isEmpty( ) )
+            return;
+        if( !isEmpty( ) && !( findMax( ) < rhs.findMin( ) ) )
+            throw IllegalArgumentException{ };
+
+        root = join( root, rhs.root );
+        rhs.root = rhs.nullNode;
+        setRootParent( );
+    }
+
+    /**
+     * Merge rhs into the treap, with the split-based union.
+     * If rhs has m items and this treap n >= m, this takes
+     * O( m log( n / m + 1 ) ) expected work. Subproblems of at least
+     * PARALLEL_CUTOFF items are forked while more than one of
+     * numThreads threads is available. rhs becomes empty.
+     */
+    void unionWith( Treap & rhs, int numThreads = 1 )
+    {
+        if( this == &rhs )    // Avoid aliasing problems
+            return;
+
+        root = unionOf( root, rhs.root, numThreads );
+        rhs.root = rhs.nullNode;
+        setRootParent( );
+    }
+
+    /**
+     * Keep only the items that are also in rhs; rhs is unchanged.
+     * Same work bound and threading as unionWith.
+     */
+    void intersectWith( const Treap & rhs, int numThreads = 1 )
+    {
+        if( this != &rhs )
+            root = intersectionOf( root, rhs.root, numThreads );
+        setRootParent( );
+    }
+
+    /**
+     * Remove the items that are in rhs; rhs is unchanged.
+     * Same work bound and threading as unionWith.
+     */
+    void differenceWith( const Treap & rhs, int numThreads = 1 )
+    {
+        if( this == &rhs )
+            makeEmpty( );
+        else
+            root = differenceOf( root, rhs.root, numThreads );
+        setRootParent( );
     }
 
   private:
@@ -157,23 +478,40 @@ class Treap
         Comparable element;
         TreapNode *left;
         TreapNode *right;
+        TreapNode *parent;     // nullptr for the root, and for nullNode
         int        priority;
+        int        size;       // Number of nodes in this subtree; 0 for nullNode
 
-        TreapNode( ) : left{ nullptr }, right{ nullptr }, priority{ INT_MAX } { }
+            // The sentinel: its own children, with the lowest priority
+        TreapNode( ) : left{ this }, right{ this }, parent{ nullptr }, priority{ INT_MAX }, size{ 0 } { }
         
-        TreapNode( const Comparable & e, TreapNode *lt, TreapNode *rt, int pr )
-          : element{ e }, left{ lt }, right{ rt }, priority{ pr }
+        TreapNode( const Comparable & e, TreapNode *lt, TreapNode *rt, int pr, int sz = 1 )
+          : element{ e }, left{ lt }, right{ rt }, parent{ nullptr }, priority{ pr }, size{ sz }
           { }
         
-        TreapNode( Comparable && e, TreapNode *lt, TreapNode *rt, int pr )
-          : element{ std::move( e ) }, left{ lt }, right{ rt }, priority{ pr }
+        TreapNode( Comparable && e, TreapNode *lt, TreapNode *rt, int pr, int sz = 1 )
+          : element{ std::move( e ) }, left{ lt }, right{ rt }, parent{ nullptr },
+            priority{ pr }, size{ sz }
           { }
     };
 
     TreapNode *root;
-    TreapNode *nullNode;
+    TreapNode *nullNode;    // The same for every Treap<Comparable>
     UniformRandom randomNums;
 
+    static const int PARALLEL_CUTOFF = 16384;
+
+    /**
+     * Return the sentinel shared by all treaps of this type, so that
+     * split and join just move subtrees between them. It is never
+     * written, so threads working on different treaps may share it.
+     */
+    static TreapNode * sharedNullNode( )
+    {
+        static TreapNode node;
+        return &node;
+    }
+
         // Recursive routines
     /**
      * Internal method to insert into a subtree.
@@ -189,12 +527,14 @@ class Treap
         else if( x < t->element )
         {
             insert( x, t->left );
+            update( t );
             if( t->left->priority < t->priority )
                 rotateWithLeftChild( t );
         }
         else if( t->element < x )
         {
             insert( x, t->right );
+            update( t );
             if( t->right->priority < t->priority )
                 rotateWithRightChild( t );
         }
@@ -215,12 +555,14 @@ class Treap
         else if( x < t->element )
         {
             insert( std::move( x ), t->left );
+            update( t );
             if( t->left->priority < t->priority )
                 rotateWithLeftChild( t );
         }
         else if( t->element < x )
         {
             insert( std::move( x ), t->right );
+            update( t );
             if( t->right->priority < t->priority )
                 rotateWithRightChild( t );
         }
@@ -241,22 +583,30 @@ class Treap
                 remove( x, t->left );
             else if( t->element < x )
                 remove( x, t->right );
+            else if( t->left == nullNode || t->right == nullNode )
+            {
+                    // Match found with at most one child; splice it out
+                TreapNode *oldNode = t;
+                t = t->left != nullNode ? t->left : t->right;
+                delete oldNode;
+                return;
+            }
             else
             {
-                    // Match found
+                    // Match found; rotate it down and continue
                 if( t->left->priority < t->right->priority )
+                {
                     rotateWithLeftChild( t );
-                else
-                    rotateWithRightChild( t );
-
-                if( t != nullNode )      // Continue on down
-                    remove( x, t );
+                    remove( x, t->right );
+                }
                 else
                 {
-                    delete t->left;
-                    t->left = nullNode;  // At a leaf
+                    rotateWithRightChild( t );
+                    remove( x, t->left );
                 }
             }
+            if( t != nullNode )
+                update( t );
         }
     }
 
@@ -281,12 +631,56 @@ class Treap
         }
     }
 
-        // Rotations
+    /**
+     * Recompute t's subtree size from its children, and point their
+     * parent links at t. Every change to t's children is followed by
+     * a call, so a node's parent link is set when its parent is fixed,
+     * or by setRootParent for the root. nullNode is never written.
+     */
+    void update( TreapNode *t )
+    {
+        t->size = t->left->size + t->right->size + 1;
+        if( t->left != nullNode )
+            t->left->parent = t;
+        if( t->right != nullNode )
+            t->right->parent = t;
+    }
+
+    void setRootParent( )
+    {
+        if( root != nullNode )
+            root->parent = nullptr;
+    }
+
+    /**
+     * Internal method to find the smallest item in a nonempty subtree t.
+     */
+    TreapNode * findMin( TreapNode *t ) const
+    {
+        while( t->left != nullNode )
+            t = t->left;
+        return t;
+    }
+
+    /**
+     * Internal method to find the largest item in a nonempty subtree t.
+     */
+    TreapNode * findMax( TreapNode *t ) const
+    {
+        while( t->right != nullNode )
+            t = t->right;
+        return t;
+    }
+
+        // Rotations; subtree sizes and parent links are updated,
+        // then the new root is set
     void rotateWithLeftChild( TreapNode * & k2 )
     {
         TreapNode *k1 = k2->left;
         k2->left = k1->right;
         k1->right = k2;
+        update( k2 );
+        update( k1 );
         k2 = k1;
     }
 
@@ -295,15 +689,179 @@ class Treap
         TreapNode *k2 = k1->right;
         k1->right = k2->left;
         k2->left = k1;
+        update( k1 );
+        update( k2 );
         k1 = k2;
     }
 
-    TreapNode * clone( TreapNode * t ) const
+        // Split and join, and the set operations built on them
+    /**
+     * Internal method to split t into lt, the items less than x, and
+     * rt, the items greater than x. Return the node matching x, detached
+     * from both, or nullNode if there is none.
+     */
+    TreapNode * split( TreapNode *t, const Comparable & x,
+                       TreapNode * & lt, TreapNode * & rt )
     {
-        if( t == t->left )  // Cannot test against nullNode!!!
+        if( t == nullNode )
+        {
+            lt = rt = nullNode;
             return nullNode;
+        }
+
+        TreapNode *match;
+        if( x < t->element )
+        {
+            match = split( t->left, x, lt, t->left );
+            rt = t;
+        }
+        else if( t->element < x )
+        {
+            match = split( t->right, x, t->right, rt );
+            lt = t;
+        }
+        else
+        {
+            lt = t->left;
+            rt = t->right;
+            t->left = t->right = nullNode;
+            t->size = 1;
+            return t;
+        }
+        update( t );
+        return match;
+    }
+
+    /**
+     * Internal method to join treaps lt and rt, where every item of lt
+     * is less than every item of rt. Return the root of the joined treap.
+     */
+    TreapNode * join( TreapNode *lt, TreapNode *rt )
+    {
+        if( lt == nullNode )
+            return rt;
+        if( rt == nullNode )
+            return lt;
+
+        if( lt->priority < rt->priority )
+        {
+            lt->right = join( lt->right, rt );
+            update( lt );
+            return lt;
+        }
+        else
+        {
+            rt->left = join( lt, rt->left );
+            update( rt );
+            return rt;
+        }
+    }
+
+    /**
+     * Run left( ) and right( ), which work on disjoint subtrees of total
+     * size work, on two threads if that is worthwhile.
+     */
+    template <typename Left, typename Right>
+    void forkJoin( int numThreads, int work, Left left, Right right )
+    {
+        if( numThreads > 1 && work >= PARALLEL_CUTOFF )
+        {
+            auto done = async( launch::async, left );
+            right( );
+            done.get( );
+        }
         else
-            return new TreapNode{ t->element, clone( t->left ), clone( t->right ), t->priority };
+        {
+            left( );
+            right( );
+        }
+    }
+
+    /**
+     * Internal method to form the union of t1 and t2. The root with higher priority stays the root, and the
+     * other treap is split around it. Duplicates from t2 are deleted.
+     */
+    TreapNode * unionOf( TreapNode *t1, TreapNode *t2, int numThreads )
+    {
+        if( t1 == nullNode )
+            return t2;
+        if( t2 == nullNode )
+            return t1;
+        if( t2->priority < t1->priority )
+            std::swap( t1, t2 );
+
+        int work = t1->size + t2->size;
+        TreapNode *l2;
+        TreapNode *r2;
+        TreapNode *match = split( t2, t1->element, l2, r2 );
+        if( match != nullNode )
+            delete match;
+
+        forkJoin( numThreads, work,
+            [ & ] { t1->left = unionOf( t1->left, l2, numThreads / 2 ); },
+            [ & ] { t1->right = unionOf( t1->right, r2, numThreads - numThreads / 2 ); } );
+        update( t1 );
+        return t1;
+    }
+
+    /**
+     * Internal method to keep the items of t1 that are also in t2.
+     * t1 is split around the root of t2; t2 is not changed.
+     */
+    TreapNode * intersectionOf( TreapNode *t1, TreapNode *t2, int numThreads )
+    {
+        if( t1 == nullNode )
+            return nullNode;
+        if( t2 == nullNode )
+        {
+            makeEmpty( t1 );
+            return nullNode;
+        }
+
+        int work = t1->size + t2->size;
+        TreapNode *lt;
+        TreapNode *rt;
+        TreapNode *match = split( t1, t2->element, lt, rt );
+
+        forkJoin( numThreads, work,
+            [ & ] { lt = intersectionOf( lt, t2->left, numThreads / 2 ); },
+            [ & ] { rt = intersectionOf( rt, t2->right, numThreads - numThreads / 2 ); } );
+        if( match != nullNode )
+            lt = join( lt, match );
+        return join( lt, rt );
+    }
+
+    /**
+     * Internal method to remove from t1 the items in t2.
+     * t1 is split around the root of t2; t2 is not changed.
+     */
+    TreapNode * differenceOf( TreapNode *t1, TreapNode *t2, int numThreads )
+    {
+        if( t1 == nullNode || t2 == nullNode )
+            return t1;
+
+        int work = t1->size + t2->size;
+        TreapNode *lt;
+        TreapNode *rt;
+        TreapNode *match = split( t1, t2->element, lt, rt );
+        if( match != nullNode )
+            delete match;
+
+        forkJoin( numThreads, work,
+            [ & ] { lt = differenceOf( lt, t2->left, numThreads / 2 ); },
+            [ & ] { rt = differenceOf( rt, t2->right, numThreads - numThreads / 2 ); } );
+        return join( lt, rt );
+    }
+
+    TreapNode * clone( TreapNode * t )
+    {
+        if( t == t->left )  // Cannot test against nullNode!!!
+            return nullNode;
+
+        TreapNode *copy = new TreapNode{ t->element, clone( t->left ), clone( t->right ),
+                                         t->priority, t->size };
+        update( copy );
+        return copy;
     }
 };
 
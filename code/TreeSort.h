@@ -0,0 +1,165 @@
+#ifndef TREE_SORT_H
+#define TREE_SORT_H
+
+#include "AvlTree.h"
+#include "RedBlackTree.h"
+#include "Treap.h"
+#include <iterator>
+#include <vector>
+using namespace std;
+
+// Tree sort: insert the items into a balanced search tree, then copy
+// them out in order with the tree's in-order iterator.
+// O( N log N ) worst case for AVL and red-black trees, expected for treaps.
+//
+// ******************PUBLIC OPERATIONS*********************
+// OutputIterator treeSort( first, last, out, mode )
+//                        --> Write the items of [ first, last ) to out
+//                            in sorted order; return the end of the output
+// void treeSort( a, mode ) --> Sort vector a
+// ******************MODES*********************************
+// AVL, RED_BLACK, TREAP  --> One node per item. Equal items are kept,
+//                            in input order (the sort is stable)
+// COUNTED                --> One AVL node per distinct item, with a count;
+//                            equal items come out as copies of the first
+// ******************ERRORS********************************
+// Comparable must be default constructible: the red-black tree
+// and treap sentinels hold one
+
+enum class TreeSortMode { AVL, RED_BLACK, TREAP, COUNTED };
+
+/**
+ * An item tagged with its position in the input. Ordering by
+ * ( item, position ) makes equal items distinct, so the set-like
+ * trees keep all of them, in input order.
+ * position is -1 only for the red-black tree's negInf, which
+ * is less than every other key.
+ */
+template <typename Comparable>
+struct SortKey
+{
+    Comparable item;
+    long long  position;
+
+    bool operator< ( const SortKey & rhs ) const
+    {
+        if( position < 0 || rhs.position < 0 )
+            return position < rhs.position;
+        if( item < rhs.item )
+            return true;
+        if( rhs.item < item )
+            return false;
+        return position < rhs.position;
+    }
+
+    bool operator!= ( const SortKey & rhs ) const
+      { return *this < rhs || rhs < *this; }
+};
+
+/**
+ * A distinct item and the number of times it occurred.
+ * Only item takes part in the ordering, so count can change
+ * while the key sits in a tree.
+ */
+template <typename Comparable>
+struct CountedKey
+{
+    Comparable item;
+    mutable long long count;
+
+    bool operator< ( const CountedKey & rhs ) const
+      { return item < rhs.item; }
+};
+
+/**
+ * Internal method that inserts [ first, last ) into t as SortKeys,
+ * then writes the items to out in order.
+ */
+template <typename Tree, typename InputIterator, typename OutputIterator>
+OutputIterator sortWithTree( Tree & t, InputIterator first, InputIterator last,
+                             OutputIterator out )
+{
+    using Comparable = typename iterator_traits<InputIterator>::value_type;
+
+    for( long long position = 0; first != last; ++first, ++position )
+        t.insert( SortKey<Comparable>{ *first, position } );
+    for( const auto & key : t )
+        *out++ = key.item;
+    return out;
+}
+
+/**
+ * Internal method for COUNTED mode: one node per distinct item.
+ */
+template <typename InputIterator, typename OutputIterator>
+OutputIterator countedTreeSort( InputIterator first, InputIterator last,
+                                OutputIterator out )
+{
+    using Comparable = typename iterator_traits<InputIterator>::value_type;
+    using Key = CountedKey<Comparable>;
+
+    AvlTree<Key> t;
+    for( ; first != last; ++first )
+    {
+        Key key{ *first, 1 };
+        auto itr = t.lower_bound( key );
+        if( itr != t.end( ) && !( key < *itr ) )
+            ++itr->count;
+        else
+            t.insert( std::move( key ) );
+    }
+    for( const Key & key : t )
+        for( long long i = 0; i < key.count; ++i )
+            *out++ = key.item;
+    return out;
+}
+
+/**
+ * Tree sort (driver).
+ * Write the items of [ first, last ) to out in sorted order,
+ * and return the end of the output.
+ */
+template <typename InputIterator, typename OutputIterator>
+OutputIterator treeSort( InputIterator first, InputIterator last, OutputIterator out,
+                         TreeSortMode mode = TreeSortMode::AVL )
+{
+    using Comparable = typename iterator_traits<InputIterator>::value_type;
+    using Key = SortKey<Comparable>;
+
+    if( first == last )
+        return out;
+
+    switch( mode )
+    {
+      case TreeSortMode::AVL:
+      {
+        AvlTree<Key> t;
+        return sortWithTree( t, first, last, out );
+      }
+      case TreeSortMode::RED_BLACK:
+      {
+        RedBlackTree<Key> t{ Key{ Comparable{ }, -1 } };
+        return sortWithTree( t, first, last, out );
+      }
+      case TreeSortMode::TREAP:
+      {
+        Treap<Key> t;
+        return sortWithTree( t, first, last, out );
+      }
+      default:
+        return countedTreeSort( first, last, out );
+    }
+}
+
+/**
+ * Sort vector a with tree sort. The items are moved into the
+ * tree and copied back.
+ */
+template <typename Comparable>
+void treeSort( vector<Comparable> & a, TreeSortMode mode = TreeSortMode::AVL )
+{
+    treeSort( make_move_iterator( a.begin( ) ), make_move_iterator( a.end( ) ),
+              a.begin( ), mode );
+}
+
+#endif
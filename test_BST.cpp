@@ -1,4 +1,9 @@
 #include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <set>
 #include "BST.h"  // 假设 BinarySearchTree 类定义在这个头文件中
 
 void testBinarySearchTree() {
@@ -71,7 +76,93 @@ void testBinarySearchTree() {
     bst7.findMax();  // 测试异常处理
 }
 
+// 退化输入的压力测试：有序插入使树退化成一条链，深度等于节点数
+// 递归实现在这样的树上会耗尽栈空间，循环实现则不受影响
+// 有序插入本身是 O(n^2) 的，所以这里用 5 万个元素
+void testDegenerateInput() {
+    const int N = 50000;
+    BinarySearchTree<int> bst;
+    for (int i = 0; i < N; ++i) {
+        bst.insert(i);
+    }
+
+    bool ok = bst.findMin() == 0 && bst.findMax() == N - 1 && !bst.contains(N);
+    for (int i = 0; i < N; i += 1000) {
+        ok = ok && bst.contains(i);
+    }
+
+    BinarySearchTree<int> copy(bst);
+    for (int i = 0; i < N; i += 2) {
+        copy.remove(i);
+    }
+    ok = ok && copy.findMin() == 1 && !copy.contains(0) && bst.contains(0);
+
+    // printTree 的输出逐行读回并检查
+    std::ostringstream out;
+    copy.printTree(out);
+    std::istringstream in(out.str());
+    int expected = 1, x;
+    while (in >> x) {
+        ok = ok && x == expected;
+        expected += 2;
+    }
+    ok = ok && expected == N + 1;
+
+    bst.makeEmpty();
+    copy.makeEmpty();
+    ok = ok && bst.isEmpty() && copy.isEmpty();
+    std::cout << "Degenerate input test: " << (ok ? "passed" : "FAILED") << std::endl;
+}
+
+// 迭代器测试：随机插入删除后，正反两个方向的中序遍历、lower_bound、upper_bound、
+// equal_range 和 range 都与 std::set 比对；拷贝出的树的父指针也要正确
+void testIterators() {
+    BinarySearchTree<int> bst;
+    std::set<int> expected;
+    std::srand(7);
+    for (int i = 0; i < 3000; ++i) {
+        int x = std::rand() % 2000;
+        if (i % 3 == 2) {
+            bst.remove(x);
+            expected.erase(x);
+        } else {
+            bst.insert(x);
+            expected.insert(x);
+        }
+    }
+    BinarySearchTree<int> copy(bst);
+
+    bool ok = std::equal(bst.begin(), bst.end(), expected.begin(), expected.end())
+              && std::equal(copy.begin(), copy.end(), expected.begin(), expected.end());
+    auto itr = copy.end();
+    for (auto e = expected.rbegin(); e != expected.rend(); ++e) {
+        ok = ok && *--itr == *e;
+    }
+    ok = ok && itr == copy.begin();
+    for (int x = -1; x <= 2001; ++x) {
+        auto lower = bst.lower_bound(x), upper = bst.upper_bound(x);
+        auto e = expected.lower_bound(x);
+        ok = ok && (lower == bst.end() ? e == expected.end() : *lower == *e);
+        e = expected.upper_bound(x);
+        ok = ok && (upper == bst.end() ? e == expected.end() : *upper == *e);
+        auto equal = bst.equal_range(x);
+        ok = ok && std::distance(equal.first, equal.second) == (long) expected.count(x);
+    }
+    auto range = bst.range(100, 199);
+    ok = ok && std::distance(range.first, range.second)
+               == std::distance(expected.lower_bound(100), expected.upper_bound(199));
+
+    try {
+        --bst.begin();
+        ok = false;
+    } catch (const IteratorOutOfBoundsException &) {
+    }
+    std::cout << "Iterator test: " << (ok ? "passed" : "FAILED") << std::endl;
+}
+
 int main() {
+    testDegenerateInput();
+    testIterators();
     testBinarySearchTree();
     return 0;
 }
\ No newline at end of file